@@ -0,0 +1,77 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_BENCHMARKS_BENCHMARK_HPP_
+#define ITERATORS_BENCHMARKS_BENCHMARK_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+
+namespace benchmark {
+
+// Prevents the compiler from optimizing away the computation of the given value
+template< typename T > void do_not_optimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void *sink = nullptr;
+	sink                             = &value;
+#endif
+}
+
+// Runs the given function the given amount of times and returns the fastest run in milliseconds
+template< typename Function > auto measure(Function &&function, std::size_t repetitions = 5) -> double {
+	double best = std::numeric_limits< double >::max();
+
+	for (std::size_t i = 0; i < repetitions; ++i) {
+		auto start = std::chrono::steady_clock::now();
+		function();
+		auto stop = std::chrono::steady_clock::now();
+
+		best = std::min(best, std::chrono::duration< double, std::milli >(stop - start).count());
+	}
+
+	return best;
+}
+
+inline void report(const char *name, double milliseconds) { std::printf("%-50s %10.3f ms\n", name, milliseconds); }
+
+inline void report(const char *name, double milliseconds, double baseline) {
+	std::printf("%-50s %10.3f ms (%.2fx)\n", name, milliseconds, baseline / milliseconds);
+}
+
+// Benchmarks double as a sanity check of the optimized code paths: a mismatch aborts the benchmark
+inline void verify(bool condition, const char *what) {
+	if (!condition) {
+		std::printf("Verification failed: %s\n", what);
+		std::exit(EXIT_FAILURE);
+	}
+}
+
+// A contiguous random access core over an array
+template< typename T > struct pointer_core {
+	using target_iterator_category = std::random_access_iterator_tag;
+
+	pointer_core() = default;
+	pointer_core(T *ptr) : m_ptr(ptr) {}
+
+	[[nodiscard]] auto dereference() const -> T & { return *m_ptr; }
+	[[nodiscard]] auto equals(const pointer_core &other) const -> bool { return m_ptr == other.m_ptr; }
+	void increment() { ++m_ptr; }
+	void decrement() { --m_ptr; }
+	[[nodiscard]] auto distance_to(const pointer_core &other) const -> std::ptrdiff_t { return other.m_ptr - m_ptr; }
+	void advance(std::ptrdiff_t amount) { m_ptr += amount; }
+
+private:
+	T *m_ptr = nullptr;
+};
+
+} // namespace benchmark
+
+#endif // ITERATORS_BENCHMARKS_BENCHMARK_HPP_
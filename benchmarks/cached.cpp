@@ -0,0 +1,88 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/cached.hpp>
+#include <iterators/iterator_facade.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <vector>
+
+struct Point {
+	double x;
+	double y;
+	double z;
+};
+
+// An input core parsing points stored as text ("x y z", one point per string) on every dereference
+class ParsingCore {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+
+	ParsingCore() = default;
+	ParsingCore(const std::string *line) : m_line(line) {}
+
+	[[nodiscard]] auto dereference() const -> Point {
+		char *end = nullptr;
+		Point point{};
+		point.x = std::strtod(m_line->c_str(), &end);
+		point.y = std::strtod(end, &end);
+		point.z = std::strtod(end, &end);
+		return point;
+	}
+
+	[[nodiscard]] auto equals(const ParsingCore &other) const -> bool { return m_line == other.m_line; }
+
+	void increment() { ++m_line; }
+
+private:
+	const std::string *m_line = nullptr;
+};
+
+// Sums the squared norms, accessing each point's coordinates through operator->
+template< typename Iterator > auto sum_norms(Iterator first, Iterator last) -> double {
+	double sum = 0;
+	for (; first != last; ++first) {
+		sum += first->x * first->x + first->y * first->y + first->z * first->z;
+	}
+	return sum;
+}
+
+auto main() -> int {
+	constexpr std::size_t size = 1U << 20U;
+
+	std::vector< std::string > lines;
+	lines.reserve(size);
+	for (std::size_t i = 0; i < size; ++i) {
+		lines.push_back(std::to_string(static_cast< double >(i % 1000) / 8) + " " + std::to_string(i % 77) + " "
+						+ std::to_string(static_cast< double >(i % 313) / 4));
+	}
+
+	std::printf("Parsing %zu points, each coordinate being accessed twice\n", size);
+
+	double plain_sum  = 0;
+	double cached_sum = 0;
+
+	const double plain = benchmark::measure([&]() {
+		plain_sum = sum_norms(iterators::iterator_facade< ParsingCore >(ParsingCore(lines.data())),
+							  iterators::iterator_facade< ParsingCore >(ParsingCore(lines.data() + lines.size())));
+		benchmark::do_not_optimize(plain_sum);
+	});
+	benchmark::report("uncached (parsed on every access)", plain);
+
+	const auto points   = iterators::cached(ParsingCore(lines.data()), ParsingCore(lines.data() + lines.size()));
+	const double cached = benchmark::measure([&]() {
+		cached_sum = sum_norms(points.begin(), points.end());
+		benchmark::do_not_optimize(cached_sum);
+	});
+	benchmark::report("cached_core (parsed once per point)", cached, plain);
+
+	benchmark::verify(plain_sum == cached_sum, "sums");
+}
@@ -0,0 +1,130 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+// This benchmark is built several times at different (low) optimization levels, with and without
+// ITERATORS_FORCE_INLINE (see benchmarks/CMakeLists.txt). Comparing the facade's overhead over raw pointers between the
+// builds shows how much the forced inlining saves in debug builds.
+
+#include "Benchmark.hpp"
+
+#include <iterators/iterator_facade.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+#ifndef OPTIMIZATION_LEVEL
+#	define OPTIMIZATION_LEVEL "(unknown)"
+#endif
+
+using Iterator = iterators::iterator_facade< benchmark::pointer_core< const std::uint32_t > >;
+
+template< typename It > auto sum(It first, It last) -> std::uint64_t {
+	std::uint64_t result = 0;
+	for (; first != last; ++first) {
+		result += *first;
+	}
+	return result;
+}
+
+// Binary searches make use of the random access operations (+=, -, <, offset dereference)
+template< typename It >
+auto count_found(It first, It last, const std::vector< std::uint32_t > &needles) -> std::size_t {
+	std::size_t found = 0;
+	for (std::uint32_t needle : needles) {
+		It begin                          = first;
+		typename It::difference_type size = last - first;
+		while (size > 0) {
+			const typename It::difference_type half = size / 2;
+			if (begin[half] < needle) {
+				begin += half + 1;
+				size -= half + 1;
+			} else {
+				size = half;
+			}
+		}
+		found += begin < last && *begin == needle ? 1 : 0;
+	}
+	return found;
+}
+
+// The same binary search on raw pointers (which don't have a nested difference_type)
+auto count_found(const std::uint32_t *first, const std::uint32_t *last, const std::vector< std::uint32_t > &needles)
+	-> std::size_t {
+	std::size_t found = 0;
+	for (std::uint32_t needle : needles) {
+		const std::uint32_t *begin = first;
+		std::ptrdiff_t size        = last - first;
+		while (size > 0) {
+			const std::ptrdiff_t half = size / 2;
+			if (begin[half] < needle) {
+				begin += half + 1;
+				size -= half + 1;
+			} else {
+				size = half;
+			}
+		}
+		found += begin < last && *begin == needle ? 1 : 0;
+	}
+	return found;
+}
+
+auto main() -> int {
+	constexpr std::size_t size    = 1U << 22U;
+	constexpr std::size_t lookups = 1U << 18U;
+
+	// Even numbers only, so that half of the lookups fail
+	std::vector< std::uint32_t > input(size);
+	for (std::size_t i = 0; i < size; ++i) {
+		input[i] = static_cast< std::uint32_t >(2 * i);
+	}
+	std::vector< std::uint32_t > needles(lookups);
+	for (std::size_t i = 0; i < lookups; ++i) {
+		needles[i] = static_cast< std::uint32_t >((i * 2654435761U) % (2 * size));
+	}
+
+	const std::uint32_t *first = input.data();
+	const std::uint32_t *last  = input.data() + input.size();
+
+#ifdef ITERATORS_FORCE_INLINE
+	std::printf("Facade overhead at %s with ITERATORS_FORCE_INLINE\n", OPTIMIZATION_LEVEL);
+#else
+	std::printf("Facade overhead at %s without ITERATORS_FORCE_INLINE\n", OPTIMIZATION_LEVEL);
+#endif
+
+	std::uint64_t raw_sum    = 0;
+	std::uint64_t facade_sum = 0;
+
+	const double raw_loop = benchmark::measure([&]() {
+		raw_sum = sum(first, last);
+		benchmark::do_not_optimize(raw_sum);
+	});
+	benchmark::report("sum (raw pointers)", raw_loop);
+
+	const double facade_loop = benchmark::measure([&]() {
+		facade_sum = sum(Iterator(first), Iterator(last));
+		benchmark::do_not_optimize(facade_sum);
+	});
+	benchmark::report("sum (iterator_facade)", facade_loop, raw_loop);
+
+	std::size_t raw_found    = 0;
+	std::size_t facade_found = 0;
+
+	const double raw_search = benchmark::measure([&]() {
+		raw_found = count_found(first, last, needles);
+		benchmark::do_not_optimize(raw_found);
+	});
+	benchmark::report("binary search (raw pointers)", raw_search);
+
+	const double facade_search = benchmark::measure([&]() {
+		facade_found = count_found(Iterator(first), Iterator(last), needles);
+		benchmark::do_not_optimize(facade_found);
+	});
+	benchmark::report("binary search (iterator_facade)", facade_search, raw_search);
+
+	benchmark::verify(raw_sum == facade_sum && raw_sum == std::accumulate(first, last, std::uint64_t{ 0 }), "sums");
+	benchmark::verify(raw_found == facade_found, "lookups");
+}
@@ -0,0 +1,74 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/delimited_records.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+auto main() -> int {
+	constexpr std::size_t line_count = 1U << 20U;
+
+	const std::string path = (std::filesystem::temp_directory_path() / "iterators_delimited_records_benchmark.log").string();
+	{
+		std::mt19937 engine(42);
+		std::uniform_int_distribution< std::size_t > length(10, 200);
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		for (std::size_t i = 0; i < line_count; ++i) {
+			stream << "2024-01-01 12:00:00 [info] " << std::string(length(engine), 'a' + static_cast< char >(i % 26))
+				   << '\n';
+		}
+	}
+
+	std::printf("Reading %zu lines (the file is likely in the page cache)\n", line_count);
+
+	std::size_t getline_lines  = 0;
+	std::size_t getline_bytes  = 0;
+	std::size_t iterator_lines = 0;
+	std::size_t iterator_bytes = 0;
+
+	double getline = benchmark::measure([&]() {
+		std::ifstream stream(path, std::ios::binary);
+		std::string line;
+
+		getline_lines = 0;
+		getline_bytes = 0;
+		while (std::getline(stream, line)) {
+			++getline_lines;
+			getline_bytes += line.size();
+		}
+		benchmark::do_not_optimize(getline_bytes);
+	});
+	benchmark::report("std::getline", getline);
+
+	double iterator = benchmark::measure([&]() {
+		const int descriptor = ::open(path.c_str(), O_RDONLY);
+		iterators::delimited_reader reader(descriptor);
+
+		iterator_lines = 0;
+		iterator_bytes = 0;
+		for (std::string_view line : reader) {
+			++iterator_lines;
+			iterator_bytes += line.size();
+		}
+		benchmark::do_not_optimize(iterator_bytes);
+
+		::close(descriptor);
+	});
+	benchmark::report("delimited_reader", iterator, getline);
+
+	benchmark::verify(getline_lines == iterator_lines && getline_bytes == iterator_bytes, "lines");
+
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,102 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/delta_vbyte.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <vector>
+
+auto random_ids(std::size_t count, std::uint32_t universe, std::mt19937 &engine) -> std::vector< std::uint32_t > {
+	std::uniform_int_distribution< std::uint32_t > distribution(0, universe - 1);
+	std::vector< std::uint32_t > ids(count);
+	for (std::uint32_t &id : ids) {
+		id = distribution(engine);
+	}
+	std::sort(ids.begin(), ids.end());
+	ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+	return ids;
+}
+
+auto main() -> int {
+	constexpr std::uint32_t universe = 1U << 26U;
+
+	std::mt19937 engine(42);
+	const std::vector< std::uint32_t > large_ids = random_ids(4U << 20U, universe, engine);
+	const iterators::delta_vbyte_sequence large(large_ids.begin(), large_ids.end());
+
+	std::printf("%zu sorted IDs compressed from %zu to %zu bytes\n", large_ids.size(),
+				large_ids.size() * sizeof(std::uint32_t), large.compressed_size());
+
+	std::printf("\nSumming all IDs\n");
+
+	std::uint64_t vector_sum   = 0;
+	std::uint64_t iterator_sum = 0;
+
+	double vector = benchmark::measure([&]() {
+		std::vector< std::uint32_t > decoded(large.begin(), large.end());
+		vector_sum = 0;
+		for (std::uint32_t id : decoded) {
+			vector_sum += id;
+		}
+		benchmark::do_not_optimize(vector_sum);
+	});
+	benchmark::report("decode into std::vector, then sum", vector);
+
+	double iterator = benchmark::measure([&]() {
+		iterator_sum = 0;
+		for (auto iter = large.begin(); iter != large.end(); ++iter) {
+			iterator_sum += *iter;
+		}
+		benchmark::do_not_optimize(iterator_sum);
+	});
+	benchmark::report("iterate over delta_vbyte_sequence", iterator, vector);
+
+	benchmark::verify(vector_sum == iterator_sum, "sums");
+
+	for (std::size_t small_count : { 1000, 100000, 1000000 }) {
+		const std::vector< std::uint32_t > small_ids = random_ids(small_count, universe, engine);
+		const iterators::delta_vbyte_sequence small(small_ids.begin(), small_ids.end());
+
+		std::printf("\nIntersecting with %zu IDs\n", small_ids.size());
+
+		std::size_t vector_matches = 0;
+		std::size_t skip_matches   = 0;
+
+		vector = benchmark::measure([&]() {
+			std::vector< std::uint32_t > decoded_large(large.begin(), large.end());
+			std::vector< std::uint32_t > decoded_small(small.begin(), small.end());
+			std::vector< std::uint32_t > intersection;
+			std::set_intersection(decoded_large.begin(), decoded_large.end(), decoded_small.begin(),
+								  decoded_small.end(), std::back_inserter(intersection));
+			vector_matches = intersection.size();
+			benchmark::do_not_optimize(vector_matches);
+		});
+		benchmark::report("decode both, std::set_intersection", vector);
+
+		double skipping = benchmark::measure([&]() {
+			skip_matches = 0;
+			iterators::delta_vbyte_iterator large_iter = large.begin();
+			for (auto iter = small.begin(); iter != small.end(); ++iter) {
+				iterators::skip_to(large_iter, *iter);
+				if (large_iter == large.end()) {
+					break;
+				}
+				if (*large_iter == *iter) {
+					++skip_matches;
+				}
+			}
+			benchmark::do_not_optimize(skip_matches);
+		});
+		benchmark::report("skip_to over compressed blocks", skipping, vector);
+
+		benchmark::verify(vector_matches == skip_matches, "intersection sizes");
+	}
+}
@@ -0,0 +1,75 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/filter.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+struct Below {
+	std::int32_t threshold;
+
+	auto operator()(std::int32_t value) const -> bool { return value < threshold; }
+};
+
+auto main() -> int {
+	constexpr std::size_t size = 1U << 24U;
+
+	// Random values, so that the outcome of the predicate can't be predicted
+	std::mt19937 engine(42);
+	std::uniform_int_distribution< std::int32_t > distribution(0, 9999);
+
+	std::vector< std::int32_t > values(size);
+	for (std::int32_t &value : values) {
+		value = distribution(engine);
+	}
+
+	std::printf("Summing the elements of %zu values that pass a filter\n", size);
+
+	for (std::int32_t percent : { 1, 10, 25, 50, 75, 90, 99 }) {
+		const Below predicate{ percent * 100 };
+
+		std::printf("\nSelectivity %d%%\n", percent);
+
+		std::int64_t loop_sum   = 0;
+		std::int64_t scalar_sum = 0;
+		std::int64_t block_sum  = 0;
+
+		const double loop = benchmark::measure([&]() {
+			loop_sum = 0;
+			for (std::int32_t value : values) {
+				if (predicate(value)) {
+					loop_sum += value;
+				}
+			}
+			benchmark::do_not_optimize(loop_sum);
+		});
+		benchmark::report("hand-written loop", loop);
+
+		const double scalar = benchmark::measure([&]() {
+			scalar_sum = 0;
+			for (std::int32_t value : iterators::filtered(values, predicate)) {
+				scalar_sum += value;
+			}
+			benchmark::do_not_optimize(scalar_sum);
+		});
+		benchmark::report("filter_core (element-wise)", scalar, loop);
+
+		const double block = benchmark::measure([&]() {
+			block_sum = 0;
+			for (std::int32_t value : iterators::filtered(values, iterators::vectorizable(predicate))) {
+				block_sum += value;
+			}
+			benchmark::do_not_optimize(block_sum);
+		});
+		benchmark::report("filter_core (block-wise)", block, loop);
+
+		benchmark::verify(loop_sum == scalar_sum && loop_sum == block_sum, "sums");
+	}
+}
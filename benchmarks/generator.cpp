@@ -0,0 +1,197 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/generator.hpp>
+
+#include <cstdio>
+
+#ifdef __cpp_impl_coroutine
+
+#	include <iterators/iterator_facade.hpp>
+
+#	include <cstddef>
+#	include <cstdint>
+#	include <cstdlib>
+#	include <iterator>
+#	include <new>
+#	include <random>
+#	include <vector>
+
+// Heap allocations are counted in order to check that walking nested generators doesn't allocate per element
+static std::size_t allocations = 0;
+
+auto operator new(std::size_t size) -> void * {
+	++allocations;
+	if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+	std::free(memory);
+}
+
+struct Node {
+	std::uint32_t key;
+	Node *left  = nullptr;
+	Node *right = nullptr;
+};
+
+// A binary search tree of the given keys (inserted in the given order)
+auto build_tree(const std::vector< std::uint32_t > &keys, std::vector< Node > &nodes) -> Node * {
+	nodes.reserve(keys.size());
+
+	Node *root = nullptr;
+	for (std::uint32_t key : keys) {
+		Node *node = &nodes.emplace_back(Node{ key });
+
+		Node **slot = &root;
+		while (*slot != nullptr) {
+			slot = key < (*slot)->key ? &(*slot)->left : &(*slot)->right;
+		}
+		*slot = node;
+	}
+	return root;
+}
+
+// The traversal flattened into a core by hand: an explicit stack of the ancestors whose right subtree has yet to be
+// visited
+class InOrderCore {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+
+	InOrderCore() = default;
+	explicit InOrderCore(const Node *root) { descend(root); }
+
+	[[nodiscard]] auto dereference() const -> const std::uint32_t & { return m_stack.back()->key; }
+	[[nodiscard]] auto equals(const InOrderCore &other) const -> bool {
+		return m_stack.empty() == other.m_stack.empty();
+	}
+
+	void increment() {
+		const Node *node = m_stack.back();
+		m_stack.pop_back();
+		descend(node->right);
+	}
+
+private:
+	std::vector< const Node * > m_stack;
+
+	void descend(const Node *node) {
+		for (; node != nullptr; node = node->left) {
+			m_stack.push_back(node);
+		}
+	}
+};
+
+// Children are checked before descending, which halves the amount of coroutine frames compared to checking for empty
+// subtrees inside the generator
+auto walk(const Node *node) -> iterators::generator< std::uint32_t > {
+	if (node->left != nullptr) {
+		co_yield iterators::elements_of(walk(node->left));
+	}
+	co_yield node->key;
+	if (node->right != nullptr) {
+		co_yield iterators::elements_of(walk(node->right));
+	}
+}
+
+// The same traversal without nesting: every element is passed up through all levels of the recursion
+auto walk_flattened(const Node *node) -> iterators::generator< std::uint32_t > {
+	if (node->left != nullptr) {
+		for (std::uint32_t key : walk_flattened(node->left)) {
+			co_yield key;
+		}
+	}
+	co_yield node->key;
+	if (node->right != nullptr) {
+		for (std::uint32_t key : walk_flattened(node->right)) {
+			co_yield key;
+		}
+	}
+}
+
+auto sum_recursive(const Node *node) -> std::uint64_t {
+	return node == nullptr ? 0 : sum_recursive(node->left) + node->key + sum_recursive(node->right);
+}
+
+template< typename Range > auto sum(Range &&range) -> std::uint64_t {
+	std::uint64_t result = 0;
+	for (std::uint32_t key : range) {
+		result += key;
+	}
+	return result;
+}
+
+auto main() -> int {
+	constexpr std::size_t size = 1U << 20U;
+
+	std::mt19937 generator(42);
+	std::vector< std::uint32_t > keys(size);
+	for (std::uint32_t &key : keys) {
+		key = static_cast< std::uint32_t >(generator());
+	}
+
+	std::vector< Node > nodes;
+	const Node *root = build_tree(keys, nodes);
+
+	std::printf("In-order walk over a binary search tree of %zu random keys\n", size);
+
+	std::uint64_t recursive_sum = 0;
+	std::uint64_t core_sum      = 0;
+	std::uint64_t nested_sum    = 0;
+	std::uint64_t flattened_sum = 0;
+
+	const double core = benchmark::measure([&]() {
+		const iterators::iterator_facade< InOrderCore > begin(InOrderCore{ root });
+		const iterators::iterator_facade< InOrderCore > end(InOrderCore{});
+
+		core_sum = 0;
+		for (auto it = begin; it != end; ++it) {
+			core_sum += *it;
+		}
+		benchmark::do_not_optimize(core_sum);
+	});
+	benchmark::report("hand-written core", core);
+
+	const double recursive = benchmark::measure([&]() {
+		recursive_sum = sum_recursive(root);
+		benchmark::do_not_optimize(recursive_sum);
+	});
+	benchmark::report("recursive function (no iterator)", recursive, core);
+
+	const double nested = benchmark::measure([&]() {
+		nested_sum = sum(walk(root));
+		benchmark::do_not_optimize(nested_sum);
+	});
+	benchmark::report("generator (elements_of)", nested, core);
+
+	const std::size_t allocations_before = allocations;
+	benchmark::do_not_optimize(sum(walk(root)));
+	std::printf("  heap allocations per walk: %zu (for %zu coroutine frames)\n", allocations - allocations_before,
+				size);
+
+	const double flattened = benchmark::measure([&]() {
+		flattened_sum = sum(walk_flattened(root));
+		benchmark::do_not_optimize(flattened_sum);
+	});
+	benchmark::report("generator (re-yielding nested elements)", flattened, core);
+
+	benchmark::verify(core_sum == recursive_sum && core_sum == nested_sum && core_sum == flattened_sum, "sums");
+}
+
+#else
+
+auto main() -> int {
+	std::printf("(Generators are not available, compile as C++20 to benchmark them)\n");
+}
+
+#endif
@@ -0,0 +1,138 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/grid.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+constexpr std::size_t size = 4096;
+// Rows are padded, as consecutive rows of a tile would otherwise map to the same cache sets
+constexpr std::size_t stride = size + 16;
+constexpr std::size_t radius = 32;
+constexpr std::size_t tile   = 64;
+
+// Averages the cells within the given radius in the same column (a tall stencil touching 2 * radius + 1 rows per cell)
+auto vertical_stencil(const float *center) -> float {
+	float sum = 0;
+	for (std::size_t offset = 0; offset <= 2 * radius; ++offset) {
+		sum += center[(offset - radius) * stride];
+	}
+	return sum / static_cast< float >(2 * radius + 1);
+}
+
+// Averages the cell and its four direct neighbors
+auto cross_stencil(const float *center) -> float {
+	return (center[0] + center[-1] + center[1] + center[-static_cast< std::ptrdiff_t >(stride)] + center[stride]) / 5;
+}
+
+// Applies the stencil to all cells that are at least radius cells away from the border, visiting them in the order of
+// the given range over the input grid
+template< typename Range, typename Stencil >
+void apply(const Range &cells, const float *input, float *output, Stencil stencil) {
+	for (auto it = cells.begin(); it != cells.end(); ++it) {
+		const iterators::grid_point point = iterators::coordinates(it);
+		if (point.x < radius || point.y < radius || point.x >= size - radius || point.y >= size - radius) {
+			continue;
+		}
+
+		const float *center = &*it;
+		output[static_cast< std::size_t >(center - input)] = stencil(center);
+	}
+}
+
+// Applies the stencil row by row with plain loops
+template< typename Stencil > void apply_rows(const float *input, float *output, Stencil stencil) {
+	for (std::size_t y = radius; y < size - radius; ++y) {
+		for (std::size_t x = radius; x < size - radius; ++x) {
+			output[y * stride + x] = stencil(input + y * stride + x);
+		}
+	}
+}
+
+// Writes the transposed input to the output, visiting the input's cells in the order of the given range
+template< typename Range > void transpose(const Range &cells, float *output) {
+	for (auto it = cells.begin(); it != cells.end(); ++it) {
+		const iterators::grid_point point = iterators::coordinates(it);
+		output[point.x * stride + point.y] = *it;
+	}
+	benchmark::do_not_optimize(output[1]);
+}
+
+auto main() -> int {
+	std::vector< float > input(size * stride);
+	for (std::size_t i = 0; i < input.size(); ++i) {
+		input[i] = static_cast< float >(i % 1000);
+	}
+	std::vector< float > expected(size * stride, 0);
+	std::vector< float > output(size * stride, 0);
+
+	const iterators::grid< const float > grid(input.data(), size, size, stride);
+	const auto rowwise = iterators::tiled(grid, size, 1);
+	const auto tiled   = iterators::tiled(grid, tile, tile);
+	const auto morton = iterators::morton(grid);
+
+	auto run_stencil = [&](const char *name, auto stencil) {
+		std::printf("%s on a %zux%zu grid\n", name, size, size);
+
+		const double rows = benchmark::measure([&]() {
+			apply_rows(input.data(), expected.data(), stencil);
+			benchmark::do_not_optimize(expected[size + 1]);
+		});
+		benchmark::report("row by row (plain loops)", rows);
+
+		const double rowwise_time = benchmark::measure([&]() {
+			apply(rowwise, input.data(), output.data(), stencil);
+			benchmark::do_not_optimize(output[size + 1]);
+		});
+		benchmark::report("row by row (tiled_grid_core)", rowwise_time, rows);
+		benchmark::verify(output == expected, "row-wise results");
+
+		std::fill(output.begin(), output.end(), 0.0F);
+		const double tiled_time = benchmark::measure([&]() {
+			apply(tiled, input.data(), output.data(), stencil);
+			benchmark::do_not_optimize(output[size + 1]);
+		});
+		benchmark::report("64x64 tiles (tiled_grid_core)", tiled_time, rows);
+		benchmark::verify(output == expected, "tiled results");
+
+		std::fill(output.begin(), output.end(), 0.0F);
+		const double morton_time = benchmark::measure([&]() {
+			apply(morton, input.data(), output.data(), stencil);
+			benchmark::do_not_optimize(output[size + 1]);
+		});
+		benchmark::report("Morton order (morton_grid_core)", morton_time, rows);
+		benchmark::verify(output == expected, "Morton results");
+
+		std::printf("\n");
+	};
+
+	run_stencil("5-point stencil", cross_stencil);
+	run_stencil("Vertical 65-point stencil", vertical_stencil);
+
+	std::printf("Transposing a %zux%zu grid\n", size, size);
+
+	const double rows = benchmark::measure([&]() {
+		for (std::size_t y = 0; y < size; ++y) {
+			for (std::size_t x = 0; x < size; ++x) {
+				expected[x * stride + y] = input[y * stride + x];
+			}
+		}
+		benchmark::do_not_optimize(expected[1]);
+	});
+	benchmark::report("row by row (plain loops)", rows);
+
+	const double tiled_time = benchmark::measure([&]() { transpose(tiled, output.data()); });
+	benchmark::report("64x64 tiles (tiled_grid_core)", tiled_time, rows);
+	benchmark::verify(output == expected, "tiled transpose");
+
+	std::fill(output.begin(), output.end(), 0.0F);
+	const double morton_time = benchmark::measure([&]() { transpose(morton, output.data()); });
+	benchmark::report("Morton order (morton_grid_core)", morton_time, rows);
+	benchmark::verify(output == expected, "Morton transpose");
+}
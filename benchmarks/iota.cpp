@@ -0,0 +1,99 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/iota.hpp>
+#include <iterators/iterator_facade.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+
+// A typical ad-hoc counting core: an input iterator yielding its counter by value
+class CountingCore {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+
+	CountingCore() = default;
+	CountingCore(std::uint32_t value) : m_value(value) {}
+
+	[[nodiscard]] auto dereference() const -> std::uint32_t { return m_value; }
+	[[nodiscard]] auto equals(const CountingCore &other) const -> bool { return m_value == other.m_value; }
+	void increment() { ++m_value; }
+
+private:
+	std::uint32_t m_value = 0;
+};
+
+auto main() -> int {
+	constexpr std::uint32_t size = 1U << 26U;
+
+	std::printf("Summing over %u indices\n", size);
+
+	std::uint64_t loop_sum    = 0;
+	std::uint64_t counted_sum = 0;
+	std::uint64_t iota_sum    = 0;
+
+	const double loop = benchmark::measure([&]() {
+		std::uint64_t sum = 0;
+		for (std::uint32_t i = 0; i < size; ++i) {
+			sum += i ^ (i >> 3U);
+		}
+		loop_sum = sum;
+		benchmark::do_not_optimize(loop_sum);
+	});
+	benchmark::report("hand-written loop", loop);
+
+	const double counted = benchmark::measure([&]() {
+		const iterators::iterator_facade< CountingCore > end(CountingCore{ size });
+
+		std::uint64_t sum = 0;
+		for (iterators::iterator_facade< CountingCore > it(CountingCore{ 0 }); it != end; ++it) {
+			sum += *it ^ (*it >> 3U);
+		}
+		counted_sum = sum;
+		benchmark::do_not_optimize(counted_sum);
+	});
+	benchmark::report("ad-hoc counting core", counted, loop);
+
+	const double iota = benchmark::measure([&]() {
+		std::uint64_t sum = 0;
+		for (std::uint32_t i : iterators::iota(0U, size)) {
+			sum += i ^ (i >> 3U);
+		}
+		iota_sum = sum;
+		benchmark::do_not_optimize(iota_sum);
+	});
+	benchmark::report("iota_core", iota, loop);
+
+	benchmark::verify(loop_sum == counted_sum && loop_sum == iota_sum, "sums");
+
+	// Counting in steps, driven by a standard algorithm
+	std::uint64_t stepped_loop_sum = 0;
+	std::uint64_t stepped_iota_sum = 0;
+
+	const double stepped_loop = benchmark::measure([&]() {
+		std::uint64_t sum = 0;
+		for (std::uint32_t i = 0; i < size; i += 3) {
+			sum += i ^ (i >> 3U);
+		}
+		stepped_loop_sum = sum;
+		benchmark::do_not_optimize(stepped_loop_sum);
+	});
+	benchmark::report("hand-written loop (step 3)", stepped_loop);
+
+	const double stepped_iota = benchmark::measure([&]() {
+		const auto indices = iterators::iota(0U, size, 3);
+
+		std::uint64_t sum = 0;
+		std::for_each(indices.begin(), indices.end(), [&sum](std::uint32_t i) { sum += i ^ (i >> 3U); });
+		stepped_iota_sum = sum;
+		benchmark::do_not_optimize(stepped_iota_sum);
+	});
+	benchmark::report("iota_step_core with std::for_each (step 3)", stepped_iota, stepped_loop);
+
+	benchmark::verify(stepped_loop_sum == stepped_iota_sum, "stepped sums");
+}
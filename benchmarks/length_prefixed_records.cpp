@@ -0,0 +1,95 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/length_prefixed_records.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+auto main() -> int {
+	constexpr std::size_t record_count = 1U << 20U;
+	constexpr std::size_t lookups      = 1U << 16U;
+
+	std::mt19937 engine(42);
+	std::uniform_int_distribution< std::uint32_t > length_distribution(8, 248);
+
+	std::vector< std::byte > buffer;
+	for (std::size_t i = 0; i < record_count; ++i) {
+		const std::uint32_t length = length_distribution(engine);
+		for (std::size_t byte = 0; byte < sizeof(length); ++byte) {
+			buffer.push_back(static_cast< std::byte >((length >> (8 * byte)) & 0xFFU));
+		}
+		buffer.insert(buffer.end(), length, static_cast< std::byte >(i));
+	}
+
+	std::printf("%zu records in a buffer of %.1f MiB\n", record_count, static_cast< double >(buffer.size()) / (1 << 20));
+
+	std::uint64_t copy_sum = 0;
+	std::uint64_t view_sum = 0;
+
+	std::printf("\nSequential traversal\n");
+
+	double copy = benchmark::measure([&]() {
+		// What deserialization into owning objects would do
+		std::vector< std::vector< std::byte > > records;
+		records.reserve(record_count);
+		for (const iterators::byte_view &record : iterators::length_prefixed_records<>(buffer.data(), buffer.size())) {
+			records.emplace_back(record.begin(), record.end());
+		}
+
+		copy_sum = 0;
+		for (const std::vector< std::byte > &record : records) {
+			copy_sum += record.size() + static_cast< std::uint64_t >(record.back());
+		}
+		benchmark::do_not_optimize(copy_sum);
+	});
+	benchmark::report("copy records into vectors", copy);
+
+	double view = benchmark::measure([&]() {
+		view_sum = 0;
+		for (const iterators::byte_view &record : iterators::length_prefixed_records<>(buffer.data(), buffer.size())) {
+			view_sum += record.size() + static_cast< std::uint64_t >(record[record.size() - 1]);
+		}
+		benchmark::do_not_optimize(view_sum);
+	});
+	benchmark::report("zero-copy byte_view iteration", view, copy);
+
+	std::printf("%-50s %10.2f GiB/s\n", "zero-copy throughput",
+				static_cast< double >(buffer.size()) / (1U << 30U) / (view / 1000));
+
+	benchmark::verify(copy_sum == view_sum, "sequential sums");
+
+	std::printf("\nRandom access\n");
+
+	std::uniform_int_distribution< std::size_t > index_distribution(0, record_count - 1);
+	std::vector< std::size_t > indices(lookups);
+	for (std::size_t &index : indices) {
+		index = index_distribution(engine);
+	}
+
+	double indexing = benchmark::measure([&]() {
+		const iterators::length_prefixed_records<> records(buffer.data(), buffer.size());
+		benchmark::do_not_optimize(records.size());
+	});
+	benchmark::report("building the offset index", indexing);
+
+	const iterators::length_prefixed_records<> records(buffer.data(), buffer.size());
+	auto random_access = records.random_access();
+
+	std::uint64_t lookup_sum = 0;
+
+	double lookup = benchmark::measure([&]() {
+		lookup_sum = 0;
+		for (std::size_t index : indices) {
+			lookup_sum += random_access.begin()[static_cast< std::ptrdiff_t >(index)].size();
+		}
+		benchmark::do_not_optimize(lookup_sum);
+	});
+	benchmark::report("indexed random lookups", lookup);
+}
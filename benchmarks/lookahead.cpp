@@ -0,0 +1,90 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/lookahead.hpp>
+#include <iterators/iterator_facade.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+// A single-pass core over the characters of a string, standing in for a stream
+class StreamCore {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+
+	StreamCore() = default;
+	StreamCore(const char *current) : m_current(current) {}
+
+	[[nodiscard]] auto dereference() const -> char { return *m_current; }
+	[[nodiscard]] auto equals(const StreamCore &other) const -> bool { return m_current == other.m_current; }
+	void increment() { ++m_current; }
+
+private:
+	const char *m_current = nullptr;
+};
+
+[[nodiscard]] auto is_comparison(char first, char second) -> bool {
+	return second == '=' && (first == '<' || first == '>' || first == '=' || first == '!');
+}
+
+auto main() -> int {
+	constexpr std::size_t size = 1U << 26U;
+
+	const char alphabet[] = "ab<>=! ";
+	std::mt19937 engine(42);
+	std::uniform_int_distribution< std::size_t > distribution(0, sizeof(alphabet) - 2);
+
+	std::string text(size, ' ');
+	for (char &character : text) {
+		character = alphabet[distribution(engine)];
+	}
+
+	const iterators::iterator_facade< StreamCore > begin(StreamCore(text.data()));
+	const iterators::iterator_facade< StreamCore > end(StreamCore(text.data() + text.size()));
+
+	std::printf("Tokenizing %zu characters with a lookahead of one character\n", size);
+
+	std::uint64_t copied_tokens    = 0;
+	std::uint64_t lookahead_tokens = 0;
+
+	const double copied = benchmark::measure([&]() {
+		const std::vector< char > buffer(begin, end);
+
+		copied_tokens = 0;
+		for (std::size_t i = 0; i < buffer.size(); ++i) {
+			if (i + 1 < buffer.size() && is_comparison(buffer[i], buffer[i + 1])) {
+				++i;
+			}
+			++copied_tokens;
+		}
+		benchmark::do_not_optimize(copied_tokens);
+	});
+	benchmark::report("copy into std::vector", copied);
+
+	const double buffered = benchmark::measure([&]() {
+		auto characters = iterators::lookahead< 2 >(begin, end);
+
+		lookahead_tokens = 0;
+		for (auto it = characters.begin(); it != characters.end(); ++it) {
+			const char *next = iterators::peek(it, 1);
+			if (next != nullptr && is_comparison(*it, *next)) {
+				++it;
+			}
+			++lookahead_tokens;
+		}
+		benchmark::do_not_optimize(lookahead_tokens);
+	});
+	benchmark::report("lookahead_core (2 element window)", buffered, copied);
+
+	benchmark::verify(copied_tokens == lookahead_tokens, "token counts");
+	std::printf("Buffer sizes: %zu bytes (std::vector) vs. %zu bytes (lookahead_core)\n", size,
+				sizeof(iterators::lookahead_core< StreamCore, 2 >));
+}
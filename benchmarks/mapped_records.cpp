@@ -0,0 +1,110 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/mapped_records.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+struct Record {
+	std::uint64_t key;
+	std::uint64_t payload[7];
+};
+
+auto main() -> int {
+	constexpr std::size_t record_count = 1U << 20U;
+	constexpr std::size_t lookups      = 1U << 16U;
+
+	const std::string path = (std::filesystem::temp_directory_path() / "iterators_mapped_records_benchmark.bin").string();
+	{
+		std::vector< Record > records(record_count);
+		for (std::size_t i = 0; i < records.size(); ++i) {
+			records[i].key = i;
+		}
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		stream.write(reinterpret_cast< const char * >(records.data()),
+					 static_cast< std::streamsize >(records.size() * sizeof(Record)));
+	}
+
+	std::printf("%zu records of %zu bytes (the file is likely in the page cache)\n", record_count, sizeof(Record));
+
+	std::mt19937_64 engine(42);
+	std::uniform_int_distribution< std::size_t > distribution(0, record_count - 1);
+	std::vector< std::size_t > indices(lookups);
+	for (std::size_t &index : indices) {
+		index = distribution(engine);
+	}
+
+	std::uint64_t read_sum   = 0;
+	std::uint64_t mapped_sum = 0;
+
+	std::printf("\nSequential scan (including opening the file)\n");
+
+	double read = benchmark::measure([&]() {
+		std::ifstream stream(path, std::ios::binary);
+		std::vector< Record > records(record_count);
+		stream.read(reinterpret_cast< char * >(records.data()),
+					static_cast< std::streamsize >(records.size() * sizeof(Record)));
+
+		read_sum = 0;
+		for (const Record &record : records) {
+			read_sum += record.key;
+		}
+		benchmark::do_not_optimize(read_sum);
+	});
+	benchmark::report("read into std::vector", read);
+
+	double mapped = benchmark::measure([&]() {
+		iterators::mapped_records< Record > records(path, iterators::access_pattern::sequential);
+
+		mapped_sum = 0;
+		for (const Record &record : records) {
+			mapped_sum += record.key;
+		}
+		benchmark::do_not_optimize(mapped_sum);
+	});
+	benchmark::report("mapped_records", mapped, read);
+
+	benchmark::verify(read_sum == mapped_sum, "sequential sums");
+
+	std::printf("\nRandom lookups (including opening the file)\n");
+
+	read = benchmark::measure([&]() {
+		std::ifstream stream(path, std::ios::binary);
+		std::vector< Record > records(record_count);
+		stream.read(reinterpret_cast< char * >(records.data()),
+					static_cast< std::streamsize >(records.size() * sizeof(Record)));
+
+		read_sum = 0;
+		for (std::size_t index : indices) {
+			read_sum += records[index].key;
+		}
+		benchmark::do_not_optimize(read_sum);
+	});
+	benchmark::report("read into std::vector", read);
+
+	mapped = benchmark::measure([&]() {
+		iterators::mapped_records< Record > records(path, iterators::access_pattern::random);
+
+		mapped_sum = 0;
+		auto begin = records.begin();
+		for (std::size_t index : indices) {
+			mapped_sum += begin[static_cast< std::ptrdiff_t >(index)].key;
+		}
+		benchmark::do_not_optimize(mapped_sum);
+	});
+	benchmark::report("mapped_records", mapped, read);
+
+	benchmark::verify(read_sum == mapped_sum, "random lookup sums");
+
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,82 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/merge.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+using Core = benchmark::pointer_core< const std::uint64_t >;
+
+auto main() -> int {
+	constexpr std::size_t total = 1U << 22U;
+
+	std::mt19937_64 engine(42);
+
+	std::printf("Merging %zu elements distributed over k sorted runs\n", total);
+
+	for (std::size_t k = 2; k <= 1024; k *= 2) {
+		std::vector< std::vector< std::uint64_t > > runs(k);
+		for (std::size_t i = 0; i < total; ++i) {
+			runs[i % k].push_back(engine() % 1000000000);
+		}
+		for (std::vector< std::uint64_t > &run : runs) {
+			std::sort(run.begin(), run.end());
+		}
+
+		std::printf("\nk = %zu\n", k);
+
+		std::vector< std::uint64_t > heap_output(total);
+		std::vector< std::uint64_t > tree_output(total);
+
+		double heap = benchmark::measure([&]() {
+			using entry = std::pair< std::uint64_t, std::size_t >;
+			std::priority_queue< entry, std::vector< entry >, std::greater<> > queue;
+			std::vector< std::size_t > positions(k, 0);
+
+			for (std::size_t run = 0; run < k; ++run) {
+				if (!runs[run].empty()) {
+					queue.emplace(runs[run][0], run);
+				}
+			}
+
+			std::size_t out = 0;
+			while (!queue.empty()) {
+				const auto [value, run] = queue.top();
+				queue.pop();
+				heap_output[out++] = value;
+
+				if (++positions[run] < runs[run].size()) {
+					queue.emplace(runs[run][positions[run]], run);
+				}
+			}
+			benchmark::do_not_optimize(heap_output.data());
+		});
+		benchmark::report("std::priority_queue", heap);
+
+		double tree = benchmark::measure([&]() {
+			std::vector< std::pair< Core, Core > > inputs;
+			for (const std::vector< std::uint64_t > &run : runs) {
+				inputs.emplace_back(Core(run.data()), Core(run.data() + run.size()));
+			}
+
+			using Iterator = iterators::merge_iterator< Core >;
+			std::copy(Iterator(iterators::merge_core< Core >(std::move(inputs))),
+					  Iterator(iterators::merge_core< Core >()), tree_output.begin());
+			benchmark::do_not_optimize(tree_output.data());
+		});
+		benchmark::report("merge_core (loser tree)", tree, heap);
+
+		benchmark::verify(heap_output == tree_output, "merged sequences");
+	}
+}
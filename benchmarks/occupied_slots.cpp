@@ -0,0 +1,96 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/occupied_slots.hpp>
+#include <iterators/iterator_facade.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <vector>
+
+// The naive approach: check one control byte per increment
+class NaiveSlotCore {
+public:
+	using target_iterator_category = std::forward_iterator_tag;
+
+	NaiveSlotCore() = default;
+	NaiveSlotCore(const std::int8_t *control, const long *slots, std::size_t position, std::size_t end)
+		: m_control(control), m_slots(slots), m_position(position), m_end(end) {
+		skip_empty();
+	}
+
+	[[nodiscard]] auto dereference() const -> const long & { return m_slots[m_position]; }
+	[[nodiscard]] auto equals(const NaiveSlotCore &other) const -> bool { return m_position == other.m_position; }
+
+	void increment() {
+		++m_position;
+		skip_empty();
+	}
+
+private:
+	const std::int8_t *m_control = nullptr;
+	const long *m_slots          = nullptr;
+	std::size_t m_position       = 0;
+	std::size_t m_end            = 0;
+
+	void skip_empty() {
+		while (m_position < m_end && m_control[m_position] < 0) {
+			++m_position;
+		}
+	}
+};
+
+using NaiveIterator = iterators::iterator_facade< NaiveSlotCore >;
+
+auto main() -> int {
+	constexpr std::size_t slot_count = 1U << 22U;
+
+	std::mt19937 engine(42);
+	std::vector< std::int8_t > control(slot_count);
+	std::vector< long > slots(slot_count);
+	for (std::size_t i = 0; i < slot_count; ++i) {
+		slots[i] = static_cast< long >(i);
+	}
+
+	std::printf("Iterating over %zu slots, scanning %zu control bytes at a time\n", slot_count,
+				iterators::occupied_slots_core< const long >::group_width);
+
+	for (double load_factor : { 0.1, 0.25, 0.5, 0.75, 0.875, 0.9 }) {
+		std::bernoulli_distribution occupied(load_factor);
+		for (std::int8_t &current : control) {
+			current = occupied(engine) ? static_cast< std::int8_t >(engine() % 128) : std::int8_t{ -128 };
+		}
+
+		std::printf("\nLoad factor %.1f%%\n", load_factor * 100);
+
+		long naive_sum = 0;
+		long group_sum = 0;
+
+		double naive = benchmark::measure([&]() {
+			naive_sum = 0;
+			NaiveIterator end(NaiveSlotCore(control.data(), slots.data(), slot_count, slot_count));
+			for (NaiveIterator iter(NaiveSlotCore(control.data(), slots.data(), 0, slot_count)); iter != end; ++iter) {
+				naive_sum += *iter;
+			}
+			benchmark::do_not_optimize(naive_sum);
+		});
+		benchmark::report("naive (one control byte per step)", naive);
+
+		double group = benchmark::measure([&]() {
+			group_sum = 0;
+			for (long slot : iterators::occupied_slots< const long >(control.data(), slots.data(), slot_count)) {
+				group_sum += slot;
+			}
+			benchmark::do_not_optimize(group_sum);
+		});
+		benchmark::report("occupied_slots_core", group, naive);
+
+		benchmark::verify(naive_sum == group_sum, "occupied slots");
+	}
+}
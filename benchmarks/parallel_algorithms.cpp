@@ -0,0 +1,117 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/iterator_facade.hpp>
+#include <iterators/parallel/algorithm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using Iterator = iterators::iterator_facade< benchmark::pointer_core< double > >;
+
+auto main() -> int {
+	constexpr std::size_t size = 1U << 24U;
+
+	iterators::parallel::thread_pool &pool = iterators::parallel::thread_pool::default_instance();
+	std::printf("Using %zu worker threads on %zu elements\n\n", pool.size(), size);
+
+	std::vector< double > data(size);
+	std::mt19937_64 engine(42);
+	std::uniform_real_distribution< double > distribution(0.0, 1.0);
+	std::generate(data.begin(), data.end(), [&]() { return distribution(engine); });
+
+	Iterator begin(data.data());
+	Iterator end(data.data() + data.size());
+
+	// for_each
+	{
+		std::vector< double > work = data;
+		Iterator work_begin(work.data());
+		Iterator work_end(work.data() + work.size());
+
+		auto body = [](double &value) { value = std::sqrt(value) * std::exp(-value); };
+
+		double serial = benchmark::measure([&]() { std::for_each(work_begin, work_end, body); });
+		benchmark::report("for_each (serial)", serial);
+		double parallel = benchmark::measure([&]() { iterators::parallel::for_each(work_begin, work_end, body); });
+		benchmark::report("for_each (parallel)", parallel, serial);
+	}
+
+	// transform_reduce
+	{
+		auto transform = [](double value) { return value * value; };
+		double serial_result   = 0;
+		double parallel_result = 0;
+
+		double serial = benchmark::measure([&]() {
+			serial_result = 0;
+			for (Iterator current = begin; current != end; ++current) {
+				serial_result += transform(*current);
+			}
+			benchmark::do_not_optimize(serial_result);
+		});
+		benchmark::report("transform_reduce (serial)", serial);
+		double parallel = benchmark::measure([&]() {
+			parallel_result = iterators::parallel::transform_reduce(begin, end, 0.0, std::plus<>{}, transform);
+			benchmark::do_not_optimize(parallel_result);
+		});
+		benchmark::report("transform_reduce (parallel)", parallel, serial);
+
+		benchmark::verify(std::abs(serial_result - parallel_result) < 1e-6 * serial_result, "transform_reduce");
+	}
+
+	// copy_if
+	{
+		auto predicate = [](double value) { return value < 0.3; };
+		std::vector< double > serial_output(size);
+		std::vector< double > parallel_output(size);
+		std::ptrdiff_t serial_count   = 0;
+		std::ptrdiff_t parallel_count = 0;
+
+		double serial = benchmark::measure([&]() {
+			serial_count = std::copy_if(begin, end, Iterator(serial_output.data()), predicate)
+						   - Iterator(serial_output.data());
+		});
+		benchmark::report("copy_if (serial)", serial);
+		double parallel = benchmark::measure([&]() {
+			parallel_count = iterators::parallel::copy_if(begin, end, Iterator(parallel_output.data()), predicate)
+							 - Iterator(parallel_output.data());
+		});
+		benchmark::report("copy_if (parallel)", parallel, serial);
+
+		benchmark::verify(serial_count == parallel_count && serial_output == parallel_output, "copy_if");
+	}
+
+	// sort
+	{
+		std::vector< double > serial_data;
+		std::vector< double > parallel_data;
+
+		double serial = benchmark::measure(
+			[&]() {
+				serial_data = data;
+				std::sort(Iterator(serial_data.data()), Iterator(serial_data.data() + serial_data.size()));
+			},
+			3);
+		benchmark::report("sort (serial)", serial);
+		double parallel = benchmark::measure(
+			[&]() {
+				parallel_data = data;
+				iterators::parallel::sort(Iterator(parallel_data.data()),
+										  Iterator(parallel_data.data() + parallel_data.size()));
+			},
+			3);
+		benchmark::report("sort (parallel)", parallel, serial);
+
+		benchmark::verify(serial_data == parallel_data, "sort");
+	}
+}
@@ -0,0 +1,90 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/permutation.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using ValueCore = benchmark::pointer_core< const float >;
+using IndexCore = benchmark::pointer_core< const std::int32_t >;
+
+template< std::size_t Distance >
+auto sum_permutation(const std::vector< float > &values, const std::vector< std::int32_t > &indices) -> double {
+	double sum = 0;
+	for (float value : iterators::permuted< Distance >(ValueCore(values.data()), IndexCore(indices.data()),
+													   IndexCore(indices.data() + indices.size()))) {
+		sum += value;
+	}
+	return sum;
+}
+
+auto main() -> int {
+	// The values exceed the caches by far, so that (almost) every access through a random index is a cache miss
+	constexpr std::size_t value_count = 1U << 26U;
+	constexpr std::size_t index_count = 1U << 22U;
+
+	std::vector< float > values(value_count);
+	for (std::size_t i = 0; i < value_count; ++i) {
+		values[i] = static_cast< float >(i % 1000);
+	}
+
+	std::mt19937 generator(42);
+	std::uniform_int_distribution< std::int32_t > distribution(0, static_cast< std::int32_t >(value_count - 1));
+	std::vector< std::int32_t > indices(index_count);
+	for (std::int32_t &index : indices) {
+		index = distribution(generator);
+	}
+
+	std::printf("Summing %zu floats at random indices into %zu floats\n", index_count, value_count);
+#ifndef __AVX2__
+	std::printf("(AVX2 is not enabled, so gather uses its scalar loop)\n");
+#endif
+
+	double loop_sum     = 0;
+	double plain_sum    = 0;
+	double prefetch_sum = 0;
+	double gather_sum   = 0;
+
+	const double loop = benchmark::measure([&]() {
+		double sum = 0;
+		for (std::int32_t index : indices) {
+			sum += values[static_cast< std::size_t >(index)];
+		}
+		loop_sum = sum;
+		benchmark::do_not_optimize(loop_sum);
+	});
+	benchmark::report("explicit gather loop", loop);
+
+	const double plain = benchmark::measure([&]() {
+		plain_sum = sum_permutation< 0 >(values, indices);
+		benchmark::do_not_optimize(plain_sum);
+	});
+	benchmark::report("permutation_core (no prefetching)", plain, loop);
+
+	const double prefetching = benchmark::measure([&]() {
+		prefetch_sum = sum_permutation< 8 >(values, indices);
+		benchmark::do_not_optimize(prefetch_sum);
+	});
+	benchmark::report("permutation_core (prefetching 8 ahead)", prefetching, loop);
+
+	// The bulk gather writes into a buffer, which is summed up separately
+	std::vector< float > buffer(index_count);
+	const double gathered = benchmark::measure([&]() {
+		iterators::gather(values.data(), indices.data(), indices.data() + indices.size(), buffer.data());
+		benchmark::do_not_optimize(buffer.data());
+	});
+	benchmark::report("gather (into a buffer)", gathered, loop);
+
+	for (float value : buffer) {
+		gather_sum += value;
+	}
+
+	benchmark::verify(loop_sum == plain_sum && loop_sum == prefetch_sum && loop_sum == gather_sum, "sums");
+}
@@ -0,0 +1,123 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/filter.hpp>
+#include <iterators/cores/transform.hpp>
+#include <iterators/iterator_facade.hpp>
+#include <iterators/pipeline.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+#if __has_include(<version>)
+#	include <version>
+#endif
+#ifdef __cpp_lib_ranges
+#	include <ranges>
+#endif
+
+using Core = benchmark::pointer_core< const std::uint32_t >;
+
+struct NotDivisibleByThree {
+	auto operator()(std::uint32_t value) const -> bool { return value % 3 != 0; }
+};
+
+struct Scramble {
+	auto operator()(std::uint32_t value) const -> std::uint32_t { return (value * value) ^ 0x5BD1E995U; }
+};
+
+struct IsEven {
+	auto operator()(std::uint32_t value) const -> bool { return value % 2 == 0; }
+};
+
+auto main() -> int {
+	constexpr std::size_t size = 1U << 24U;
+
+	// Consecutive values keep the branches predictable, so that the overhead of the adaptors is not hidden behind
+	// branch mispredictions
+	std::vector< std::uint32_t > values(size);
+	std::iota(values.begin(), values.end(), 0U);
+
+	std::printf("filter | transform | filter over %zu values\n", size);
+
+	std::uint64_t loop_sum     = 0;
+	std::uint64_t nested_sum   = 0;
+	std::uint64_t pipeline_sum = 0;
+	std::uint64_t push_sum     = 0;
+
+	const double loop = benchmark::measure([&]() {
+		loop_sum = 0;
+		for (std::uint32_t value : values) {
+			if (NotDivisibleByThree()(value)) {
+				const std::uint32_t scrambled = Scramble()(value);
+				if (IsEven()(scrambled)) {
+					loop_sum += scrambled;
+				}
+			}
+		}
+		benchmark::do_not_optimize(loop_sum);
+	});
+	benchmark::report("hand-written loop", loop);
+
+	const Core first(values.data());
+	const Core last(values.data() + values.size());
+
+	// Classic nested adaptor cores, each level holding the level below and performing its own end checks
+	const auto nested_range = iterators::filtered(
+		iterators::transformed(iterators::filtered(first, last, NotDivisibleByThree()), Scramble()), IsEven());
+
+	const double nested = benchmark::measure([&]() {
+		nested_sum = 0;
+		for (std::uint32_t value : nested_range) {
+			nested_sum += value;
+		}
+		benchmark::do_not_optimize(nested_sum);
+	});
+	benchmark::report("nested filter_core/transform_core", nested, loop);
+
+	const auto pipeline = values | iterators::filter(NotDivisibleByThree()) | iterators::transform(Scramble())
+						  | iterators::filter(IsEven());
+
+	const double fused = benchmark::measure([&]() {
+		pipeline_sum = 0;
+		for (std::uint32_t value : pipeline) {
+			pipeline_sum += value;
+		}
+		benchmark::do_not_optimize(pipeline_sum);
+	});
+	benchmark::report("pipeline (iterators)", fused, loop);
+
+	const double push = benchmark::measure([&]() {
+		std::uint64_t sum = 0;
+		pipeline.for_each([&sum](std::uint32_t value) { sum += value; });
+		push_sum = sum;
+		benchmark::do_not_optimize(push_sum);
+	});
+	benchmark::report("pipeline (for_each)", push, loop);
+
+	benchmark::verify(loop_sum == nested_sum && loop_sum == pipeline_sum && loop_sum == push_sum, "sums");
+
+#ifdef __cpp_lib_ranges
+	std::uint64_t ranges_sum = 0;
+
+	const double ranges = benchmark::measure([&]() {
+		ranges_sum = 0;
+		for (std::uint32_t value : values | std::views::filter(NotDivisibleByThree())
+									   | std::views::transform(Scramble()) | std::views::filter(IsEven())) {
+			ranges_sum += value;
+		}
+		benchmark::do_not_optimize(ranges_sum);
+	});
+	benchmark::report("std::views", ranges, loop);
+
+	benchmark::verify(loop_sum == ranges_sum, "std::views sum");
+#else
+	std::printf("(std::views are not available, compile as C++20 to compare against them)\n");
+#endif
+}
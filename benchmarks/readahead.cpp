@@ -0,0 +1,92 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/iterator_facade.hpp>
+#include <iterators/parallel/readahead.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <thread>
+
+// Simulates a slow source (e.g. a pipe or a network stream): every block of values only becomes available after
+// waiting for some latency
+class SlowSourceCore {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+
+	static constexpr std::uint64_t block_size = 4096;
+
+	SlowSourceCore() = default;
+	SlowSourceCore(std::uint64_t current, std::chrono::microseconds latency) : m_current(current), m_latency(latency) {}
+
+	[[nodiscard]] auto dereference() const -> const std::uint64_t & { return m_current; }
+	[[nodiscard]] auto equals(const SlowSourceCore &other) const -> bool { return m_current == other.m_current; }
+
+	void increment() {
+		if (++m_current % block_size == 0) {
+			std::this_thread::sleep_for(m_latency);
+		}
+	}
+
+private:
+	std::uint64_t m_current = 0;
+	std::chrono::microseconds m_latency{};
+};
+
+// Simulates processing each value
+auto process(std::uint64_t value) -> std::uint64_t {
+	for (int i = 0; i < 64; ++i) {
+		value ^= value >> 31U;
+		value *= 0x7FB5D329728EA185ULL;
+	}
+	return value;
+}
+
+auto main() -> int {
+	constexpr std::uint64_t count = 1U << 20U;
+
+	std::printf("Processing %llu values from a slow source\n", static_cast< unsigned long long >(count));
+
+	for (long latency : { 100, 400, 1000 }) {
+		std::printf("\nLatency of %ld us per %llu values\n", latency,
+					static_cast< unsigned long long >(SlowSourceCore::block_size));
+
+		const SlowSourceCore begin(0, std::chrono::microseconds(latency));
+		const SlowSourceCore end(count, std::chrono::microseconds(latency));
+
+		std::uint64_t direct_sum    = 0;
+		std::uint64_t readahead_sum = 0;
+
+		double direct = benchmark::measure(
+			[&]() {
+				using Iterator = iterators::iterator_facade< SlowSourceCore >;
+
+				direct_sum = 0;
+				for (Iterator iter(begin); iter != Iterator(end); ++iter) {
+					direct_sum += process(*iter);
+				}
+				benchmark::do_not_optimize(direct_sum);
+			},
+			3);
+		benchmark::report("direct iteration", direct);
+
+		double readahead = benchmark::measure(
+			[&]() {
+				readahead_sum = 0;
+				for (std::uint64_t value : iterators::parallel::readahead(begin, end, SlowSourceCore::block_size)) {
+					readahead_sum += process(value);
+				}
+				benchmark::do_not_optimize(readahead_sum);
+			},
+			3);
+		benchmark::report("readahead_core", readahead, direct);
+
+		benchmark::verify(direct_sum == readahead_sum, "sums");
+	}
+}
@@ -0,0 +1,164 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/reverse.hpp>
+#include <iterators/iterator_facade.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using Core     = benchmark::pointer_core< const std::uint32_t >;
+using Iterator = iterators::iterator_facade< Core >;
+
+// A bidirectional core over a sequence stored in fixed-size chunks (similar to std::deque), for which moving between
+// elements is more expensive than for plain pointers
+class ChunkedCore {
+public:
+	using target_iterator_category = std::bidirectional_iterator_tag;
+
+	ChunkedCore() = default;
+	ChunkedCore(const std::vector< std::vector< std::uint32_t > > *chunks, std::size_t chunk, std::size_t index)
+		: m_chunks(chunks), m_chunk(chunk), m_index(index) {}
+
+	[[nodiscard]] auto dereference() const -> const std::uint32_t & { return (*m_chunks)[m_chunk][m_index]; }
+	[[nodiscard]] auto equals(const ChunkedCore &other) const -> bool {
+		return m_chunk == other.m_chunk && m_index == other.m_index;
+	}
+
+	void increment() {
+		if (++m_index == (*m_chunks)[m_chunk].size()) {
+			++m_chunk;
+			m_index = 0;
+		}
+	}
+
+	void decrement() {
+		if (m_index == 0) {
+			--m_chunk;
+			m_index = (*m_chunks)[m_chunk].size();
+		}
+		--m_index;
+	}
+
+private:
+	const std::vector< std::vector< std::uint32_t > > *m_chunks = nullptr;
+	std::size_t m_chunk                                         = 0;
+	std::size_t m_index                                         = 0;
+};
+
+using ChunkedIterator = iterators::iterator_facade< ChunkedCore >;
+
+auto main() -> int {
+	constexpr std::size_t size    = 1U << 24U;
+	constexpr std::size_t lookups = 1U << 20U;
+
+	std::vector< std::uint32_t > values(size);
+	std::iota(values.begin(), values.end(), 0U);
+
+	const Iterator begin(values.data());
+	const Iterator end(values.data() + values.size());
+
+	std::printf("Scanning %zu sorted values\n", size);
+
+	std::uint64_t ascending_sum = 0;
+	std::uint64_t std_sum       = 0;
+	std::uint64_t reverse_sum   = 0;
+
+	// Summing with early exit to keep the compiler from turning the loop into a plain reduction
+	auto sum_until = [](auto first, auto last, std::uint64_t &sum) {
+		sum = 0;
+		for (; first != last; ++first) {
+			if (*first == 0xFFFFFFFFU) {
+				break;
+			}
+			sum += *first;
+		}
+		benchmark::do_not_optimize(sum);
+	};
+
+	double ascending = benchmark::measure([&]() { sum_until(begin, end, ascending_sum); });
+	benchmark::report("ascending (iterator_facade)", ascending);
+
+	double std_reverse = benchmark::measure([&]() {
+		sum_until(std::reverse_iterator< Iterator >(end), std::reverse_iterator< Iterator >(begin), std_sum);
+	});
+	benchmark::report("descending (std::reverse_iterator)", std_reverse, ascending);
+
+	auto reversed  = iterators::reversed(begin, end);
+	double reverse = benchmark::measure([&]() { sum_until(reversed.begin(), reversed.end(), reverse_sum); });
+	benchmark::report("descending (reverse_core)", reverse, ascending);
+
+	benchmark::verify(ascending_sum == std_sum && ascending_sum == reverse_sum, "sums");
+
+	std::printf("\nScanning %zu values stored in chunks\n", size);
+
+	std::vector< std::vector< std::uint32_t > > chunks;
+	for (std::size_t offset = 0; offset < size; offset += 1000) {
+		const std::size_t chunk_end = std::min< std::size_t >(offset + 1000, size);
+		chunks.emplace_back(values.begin() + static_cast< std::ptrdiff_t >(offset),
+							values.begin() + static_cast< std::ptrdiff_t >(chunk_end));
+	}
+
+	const ChunkedIterator chunked_begin(ChunkedCore(&chunks, 0, 0));
+	const ChunkedIterator chunked_end(ChunkedCore(&chunks, chunks.size(), 0));
+
+	ascending = benchmark::measure([&]() { sum_until(chunked_begin, chunked_end, ascending_sum); });
+	benchmark::report("ascending (iterator_facade)", ascending);
+
+	std_reverse = benchmark::measure([&]() {
+		sum_until(std::reverse_iterator< ChunkedIterator >(chunked_end),
+				  std::reverse_iterator< ChunkedIterator >(chunked_begin), std_sum);
+	});
+	benchmark::report("descending (std::reverse_iterator)", std_reverse, ascending);
+
+	auto chunked_reversed = iterators::reversed(chunked_begin, chunked_end);
+	reverse = benchmark::measure([&]() { sum_until(chunked_reversed.begin(), chunked_reversed.end(), reverse_sum); });
+	benchmark::report("descending (reverse_core)", reverse, ascending);
+
+	benchmark::verify(ascending_sum == std_sum && ascending_sum == reverse_sum, "chunked sums");
+
+	std::printf("\nBinary searches in descending order\n");
+
+	std::mt19937 engine(42);
+	std::uniform_int_distribution< std::uint32_t > distribution(0, size - 1);
+	std::vector< std::uint32_t > targets(lookups);
+	for (std::uint32_t &target : targets) {
+		target = distribution(engine);
+	}
+
+	std::uint64_t std_found     = 0;
+	std::uint64_t reverse_found = 0;
+
+	std_reverse = benchmark::measure([&]() {
+		std_found = 0;
+		for (std::uint32_t target : targets) {
+			std_found += static_cast< std::uint64_t >(*std::lower_bound(std::reverse_iterator< Iterator >(end),
+																		 std::reverse_iterator< Iterator >(begin),
+																		 target, std::greater<>()));
+		}
+		benchmark::do_not_optimize(std_found);
+	});
+	benchmark::report("std::lower_bound (std::reverse_iterator)", std_reverse);
+
+	reverse = benchmark::measure([&]() {
+		reverse_found = 0;
+		for (std::uint32_t target : targets) {
+			reverse_found += static_cast< std::uint64_t >(
+				*std::lower_bound(reversed.begin(), reversed.end(), target, std::greater<>()));
+		}
+		benchmark::do_not_optimize(reverse_found);
+	});
+	benchmark::report("std::lower_bound (reverse_core)", reverse, std_reverse);
+
+	benchmark::verify(std_found == reverse_found, "search results");
+}
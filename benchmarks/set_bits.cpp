@@ -0,0 +1,106 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/set_bits.hpp>
+#include <iterators/iterator_facade.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <vector>
+
+// The naive approach: test one bit per increment
+class NaiveBitCore {
+public:
+	using target_iterator_category = std::forward_iterator_tag;
+
+	NaiveBitCore() = default;
+	NaiveBitCore(const std::uint64_t *words, std::size_t position, std::size_t end)
+		: m_words(words), m_position(position), m_end(end) {
+		skip_unset();
+	}
+
+	[[nodiscard]] auto dereference() const -> const std::size_t & { return m_position; }
+	[[nodiscard]] auto equals(const NaiveBitCore &other) const -> bool { return m_position == other.m_position; }
+
+	void increment() {
+		++m_position;
+		skip_unset();
+	}
+
+private:
+	const std::uint64_t *m_words = nullptr;
+	std::size_t m_position       = 0;
+	std::size_t m_end            = 0;
+
+	void skip_unset() {
+		while (m_position < m_end && ((m_words[m_position / 64] >> (m_position % 64)) & 1U) == 0) {
+			++m_position;
+		}
+	}
+};
+
+using NaiveIterator = iterators::iterator_facade< NaiveBitCore >;
+
+auto main() -> int {
+	constexpr std::size_t word_count = 1U << 16U;
+	constexpr std::size_t bit_count  = word_count * 64;
+
+	std::mt19937_64 engine(42);
+	std::vector< std::uint64_t > words(word_count);
+	std::vector< std::uint32_t > buffer(bit_count);
+
+	std::printf("Iterating over the set bits of %zu bits\n", bit_count);
+
+	for (double density : { 0.001, 0.01, 0.1, 0.25, 0.5, 0.9 }) {
+		std::bernoulli_distribution distribution(density);
+		for (std::uint64_t &word : words) {
+			word = 0;
+			for (unsigned int bit = 0; bit < 64; ++bit) {
+				word |= static_cast< std::uint64_t >(distribution(engine)) << bit;
+			}
+		}
+
+		std::printf("\nDensity %.1f%%\n", density * 100);
+
+		std::size_t naive_sum = 0;
+		std::size_t ctz_sum   = 0;
+		std::size_t bulk_sum  = 0;
+
+		double naive = benchmark::measure([&]() {
+			naive_sum = 0;
+			NaiveIterator end(NaiveBitCore(words.data(), bit_count, bit_count));
+			for (NaiveIterator iter(NaiveBitCore(words.data(), 0, bit_count)); iter != end; ++iter) {
+				naive_sum += *iter;
+			}
+			benchmark::do_not_optimize(naive_sum);
+		});
+		benchmark::report("naive (one bit per step)", naive);
+
+		double ctz = benchmark::measure([&]() {
+			ctz_sum = 0;
+			for (std::size_t position : iterators::set_bits(words.data(), words.size())) {
+				ctz_sum += position;
+			}
+			benchmark::do_not_optimize(ctz_sum);
+		});
+		benchmark::report("set_bits_core", ctz, naive);
+
+		double bulk = benchmark::measure([&]() {
+			std::uint32_t *end = iterators::decode_set_bits(words.data(), words.size(), buffer.data());
+			bulk_sum           = 0;
+			for (const std::uint32_t *current = buffer.data(); current != end; ++current) {
+				bulk_sum += *current;
+			}
+			benchmark::do_not_optimize(bulk_sum);
+		});
+		benchmark::report("decode_set_bits (bulk) + loop over buffer", bulk, naive);
+
+		benchmark::verify(naive_sum == ctz_sum && naive_sum == bulk_sum, "set bits");
+	}
+}
@@ -0,0 +1,104 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/iterator_facade.hpp>
+#include <iterators/iterator_operations.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <vector>
+
+struct Run {
+	int value;
+	std::ptrdiff_t length;
+};
+
+// A forward core over run-length encoded data. Advancing skips whole runs at once.
+class RunLengthCore {
+public:
+	using target_iterator_category = std::forward_iterator_tag;
+
+	RunLengthCore() = default;
+	RunLengthCore(const Run *run) : m_run(run) {}
+
+	[[nodiscard]] auto dereference() const -> const int & { return m_run->value; }
+	[[nodiscard]] auto equals(const RunLengthCore &other) const -> bool {
+		return m_run == other.m_run && m_offset == other.m_offset;
+	}
+
+	void increment() {
+		if (++m_offset == m_run->length) {
+			++m_run;
+			m_offset = 0;
+		}
+	}
+
+	void advance(std::ptrdiff_t amount) {
+		amount += m_offset;
+		while (amount >= m_run->length) {
+			amount -= m_run->length;
+			++m_run;
+		}
+		m_offset = amount;
+	}
+
+private:
+	const Run *m_run         = nullptr;
+	std::ptrdiff_t m_offset = 0;
+};
+
+using Iterator = iterators::iterator_facade< RunLengthCore >;
+
+auto main() -> int {
+	constexpr std::size_t run_count = 1U << 16U;
+	constexpr std::size_t lookups   = 256;
+
+	std::mt19937 engine(42);
+	std::uniform_int_distribution< std::ptrdiff_t > run_length(1, 64);
+
+	std::vector< Run > runs(run_count + 1);
+	std::ptrdiff_t total = 0;
+	for (std::size_t i = 0; i < run_count; ++i) {
+		runs[i] = { static_cast< int >(i), run_length(engine) };
+		total += runs[i].length;
+	}
+	// Sentinel run marking the end
+	runs[run_count] = { -1, 1 };
+
+	std::uniform_int_distribution< std::ptrdiff_t > position(0, total - 1);
+	std::vector< std::ptrdiff_t > positions(lookups);
+	for (std::ptrdiff_t &current : positions) {
+		current = position(engine);
+	}
+
+	Iterator begin(runs.data());
+	long long std_sum  = 0;
+	long long skip_sum = 0;
+
+	std::printf("%zu lookups in %td run-length encoded elements (%zu runs)\n\n", lookups, total, run_count);
+
+	double linear = benchmark::measure([&]() {
+		std_sum = 0;
+		for (std::ptrdiff_t current : positions) {
+			std_sum += *std::next(begin, current);
+		}
+		benchmark::do_not_optimize(std_sum);
+	});
+	benchmark::report("std::next (element-wise increment)", linear);
+
+	double skipping = benchmark::measure([&]() {
+		skip_sum = 0;
+		for (std::ptrdiff_t current : positions) {
+			skip_sum += *iterators::next(begin, current);
+		}
+		benchmark::do_not_optimize(skip_sum);
+	});
+	benchmark::report("iterators::next (core's advance)", skipping, linear);
+
+	benchmark::verify(std_sum == skip_sum, "next");
+}
@@ -0,0 +1,200 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/parallel/spsc_ring.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using iterators::parallel::spsc_ring;
+using iterators::parallel::wait_policy;
+
+// The hand-off the ring replaces: a queue guarded by a mutex, signalling every element
+template< typename T > class MutexQueue {
+public:
+	explicit MutexQueue(std::size_t capacity) : m_capacity(capacity) {}
+
+	void push(T element) {
+		{
+			std::unique_lock< std::mutex > lock(m_mutex);
+			m_space_available.wait(lock, [&]() { return m_elements.size() < m_capacity; });
+			m_elements.push_back(std::move(element));
+		}
+		m_elements_available.notify_one();
+	}
+
+	void close() {
+		{
+			std::lock_guard< std::mutex > guard(m_mutex);
+			m_closed = true;
+		}
+		m_elements_available.notify_one();
+	}
+
+	auto pop() -> std::optional< T > {
+		std::optional< T > element;
+		{
+			std::unique_lock< std::mutex > lock(m_mutex);
+			m_elements_available.wait(lock, [&]() { return !m_elements.empty() || m_closed; });
+			if (m_elements.empty()) {
+				return std::nullopt;
+			}
+			element = std::move(m_elements.front());
+			m_elements.pop_front();
+		}
+		m_space_available.notify_one();
+		return element;
+	}
+
+private:
+	std::size_t m_capacity;
+	std::deque< T > m_elements;
+	bool m_closed = false;
+	std::mutex m_mutex;
+	std::condition_variable m_space_available;
+	std::condition_variable m_elements_available;
+};
+
+constexpr std::size_t capacity = 4096;
+
+auto mutex_throughput(const std::vector< std::uint32_t > &input) -> std::uint64_t {
+	MutexQueue< std::uint32_t > queue(capacity);
+
+	std::thread producer([&]() {
+		for (std::uint32_t element : input) {
+			queue.push(element);
+		}
+		queue.close();
+	});
+
+	std::uint64_t sum = 0;
+	while (std::optional< std::uint32_t > element = queue.pop()) {
+		sum += *element;
+	}
+	producer.join();
+	return sum;
+}
+
+template< wait_policy Policy > auto ring_throughput(const std::vector< std::uint32_t > &input) -> std::uint64_t {
+	spsc_ring< std::uint32_t, Policy > ring(capacity);
+
+	std::thread producer([&]() {
+		std::copy(input.begin(), input.end(), ring.writer());
+		ring.close();
+	});
+
+	std::uint64_t sum = 0;
+	for (std::uint32_t element : ring.reader()) {
+		sum += element;
+	}
+	producer.join();
+	return sum;
+}
+
+// Round trips of a single element: the main thread sends a counter through one queue, the other thread sends it back
+// incremented through a second one
+auto mutex_latency(std::size_t round_trips) -> std::uint32_t {
+	MutexQueue< std::uint32_t > ping(1);
+	MutexQueue< std::uint32_t > pong(1);
+
+	std::thread echo([&]() {
+		while (std::optional< std::uint32_t > element = ping.pop()) {
+			pong.push(*element + 1);
+		}
+	});
+
+	std::uint32_t counter = 0;
+	for (std::size_t i = 0; i < round_trips; ++i) {
+		ping.push(counter);
+		counter = *pong.pop();
+	}
+	ping.close();
+	echo.join();
+	return counter;
+}
+
+template< wait_policy Policy > auto ring_latency(std::size_t round_trips) -> std::uint32_t {
+	// Every element is published right away (batches of one), whereas there is always enough space
+	spsc_ring< std::uint32_t, Policy > ping(64, 1);
+	spsc_ring< std::uint32_t, Policy > pong(64, 1);
+
+	std::thread echo([&]() {
+		for (std::uint32_t element : ping.reader()) {
+			pong.push(element + 1);
+		}
+	});
+
+	auto replies = pong.reader();
+	auto reply   = replies.begin();
+
+	std::uint32_t counter = 0;
+	for (std::size_t i = 0; i < round_trips; ++i) {
+		ping.push(counter);
+		counter = *reply;
+		++reply;
+	}
+	ping.close();
+	echo.join();
+	return counter;
+}
+
+auto main() -> int {
+	constexpr std::size_t size        = 1U << 24U;
+	constexpr std::size_t round_trips = 20000;
+
+	std::vector< std::uint32_t > input(size);
+	std::iota(input.begin(), input.end(), 0U);
+	const std::uint64_t expected = std::accumulate(input.begin(), input.end(), std::uint64_t{ 0 });
+
+	std::printf("Throughput: handing %zu integers from one thread to another (capacity %zu, %u hardware threads)\n",
+				size, capacity, std::thread::hardware_concurrency());
+
+	std::uint64_t mutex_sum    = 0;
+	std::uint64_t blocking_sum = 0;
+	std::uint64_t spinning_sum = 0;
+
+	const double mutex = benchmark::measure([&]() { mutex_sum = mutex_throughput(input); }, 3);
+	benchmark::report("mutex queue", mutex);
+
+	const double blocking = benchmark::measure([&]() { blocking_sum = ring_throughput< wait_policy::block >(input); });
+	benchmark::report("spsc_ring (blocking) via std::copy", blocking, mutex);
+
+	const double spinning = benchmark::measure([&]() { spinning_sum = ring_throughput< wait_policy::spin >(input); });
+	benchmark::report("spsc_ring (spinning) via std::copy", spinning, mutex);
+
+	benchmark::verify(mutex_sum == expected && blocking_sum == expected && spinning_sum == expected, "sums");
+
+	std::printf("Latency: %zu round trips of a single element\n", round_trips);
+
+	std::uint32_t mutex_counter    = 0;
+	std::uint32_t blocking_counter = 0;
+	std::uint32_t spinning_counter = 0;
+
+	const double mutex_round_trips = benchmark::measure([&]() { mutex_counter = mutex_latency(round_trips); }, 3);
+	benchmark::report("mutex queue", mutex_round_trips);
+
+	const double blocking_round_trips =
+		benchmark::measure([&]() { blocking_counter = ring_latency< wait_policy::block >(round_trips); }, 3);
+	benchmark::report("spsc_ring (blocking)", blocking_round_trips, mutex_round_trips);
+
+	const double spinning_round_trips =
+		benchmark::measure([&]() { spinning_counter = ring_latency< wait_policy::spin >(round_trips); }, 3);
+	benchmark::report("spsc_ring (spinning)", spinning_round_trips, mutex_round_trips);
+
+	benchmark::verify(mutex_counter == round_trips && blocking_counter == round_trips
+						  && spinning_counter == round_trips,
+					  "round trips");
+}
@@ -0,0 +1,126 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "Benchmark.hpp"
+
+#include <iterators/cores/transform.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+struct Record {
+	std::uint64_t timestamp;
+	double payload[3];
+};
+
+using Core = benchmark::pointer_core< const Record >;
+
+struct Timestamp {
+	auto operator()(const Record &record) const noexcept -> const std::uint64_t & { return record.timestamp; }
+};
+
+// A key that is computed from the record, i.e. returned by value
+struct Second {
+	auto operator()(const Record &record) const noexcept -> std::uint64_t { return record.timestamp / 1000; }
+};
+
+auto main() -> int {
+	constexpr std::size_t size    = 1U << 22U;
+	constexpr std::size_t queries = 1U << 18U;
+
+	std::mt19937_64 engine(42);
+	std::uniform_int_distribution< std::uint64_t > gap(1, 2000);
+
+	std::vector< Record > records(size);
+	std::uint64_t timestamp = 0;
+	for (Record &record : records) {
+		timestamp += gap(engine);
+		record = { timestamp, { 1.0, 2.0, 3.0 } };
+	}
+
+	std::uniform_int_distribution< std::uint64_t > query(0, timestamp);
+	std::vector< std::uint64_t > keys(queries);
+	for (std::uint64_t &key : keys) {
+		key = query(engine);
+	}
+
+	std::printf("%zu binary searches over %zu records sorted by a projected key\n", queries, size);
+
+	std::uint64_t comparator_sum   = 0;
+	std::uint64_t materialized_sum = 0;
+	std::uint64_t projected_sum    = 0;
+
+	const double comparator = benchmark::measure([&]() {
+		comparator_sum = 0;
+		for (std::uint64_t key : keys) {
+			comparator_sum += static_cast< std::uint64_t >(
+				std::lower_bound(records.begin(), records.end(), key,
+								 [](const Record &record, std::uint64_t value) { return record.timestamp < value; })
+				- records.begin());
+		}
+		benchmark::do_not_optimize(comparator_sum);
+	});
+	benchmark::report("std::lower_bound with comparator", comparator);
+
+	const double materialized = benchmark::measure([&]() {
+		std::vector< std::uint64_t > timestamps(records.size());
+		std::transform(records.begin(), records.end(), timestamps.begin(), Timestamp());
+
+		materialized_sum = 0;
+		for (std::uint64_t key : keys) {
+			materialized_sum += static_cast< std::uint64_t >(
+				std::lower_bound(timestamps.begin(), timestamps.end(), key) - timestamps.begin());
+		}
+		benchmark::do_not_optimize(materialized_sum);
+	});
+	benchmark::report("materialized key array", materialized, comparator);
+
+	const auto timestamps = iterators::transformed(Core(records.data()), Core(records.data() + records.size()),
+												   Timestamp());
+	const double projected = benchmark::measure([&]() {
+		projected_sum = 0;
+		for (std::uint64_t key : keys) {
+			projected_sum += static_cast< std::uint64_t >(
+				std::lower_bound(timestamps.begin(), timestamps.end(), key) - timestamps.begin());
+		}
+		benchmark::do_not_optimize(projected_sum);
+	});
+	benchmark::report("transform_core (projection)", projected, comparator);
+
+	benchmark::verify(comparator_sum == materialized_sum && comparator_sum == projected_sum, "positions");
+
+	// Keys computed by value are cached inside the iterators, so that they can still be random access
+	std::uint64_t computed_comparator_sum = 0;
+	std::uint64_t computed_sum            = 0;
+
+	const double computed_comparator = benchmark::measure([&]() {
+		computed_comparator_sum = 0;
+		for (std::uint64_t key : keys) {
+			computed_comparator_sum += static_cast< std::uint64_t >(
+				std::lower_bound(records.begin(), records.end(), key / 1000,
+								 [](const Record &record, std::uint64_t value) { return Second()(record) < value; })
+				- records.begin());
+		}
+		benchmark::do_not_optimize(computed_comparator_sum);
+	});
+	benchmark::report("std::lower_bound with comparator (computed key)", computed_comparator);
+
+	const auto seconds =
+		iterators::transformed(Core(records.data()), Core(records.data() + records.size()), Second());
+	const double computed = benchmark::measure([&]() {
+		computed_sum = 0;
+		for (std::uint64_t key : keys) {
+			computed_sum += static_cast< std::uint64_t >(std::lower_bound(seconds.begin(), seconds.end(), key / 1000)
+														 - seconds.begin());
+		}
+		benchmark::do_not_optimize(computed_sum);
+	});
+	benchmark::report("transform_core (computed key, cached)", computed, computed_comparator);
+
+	benchmark::verify(computed_comparator_sum == computed_sum, "positions of computed keys");
+}
@@ -8,13 +8,16 @@
 #include "details/arrow_proxy.hpp"
 #include "iterators/type_traits.hpp"
 
+#include <cstddef>
 #include <type_traits>
 
 namespace iterators {
 
 namespace details {
 
-	template< typename, typename = void > struct infer_difference_type { using type = void; };
+	// Cores that don't implement 'distance_to' still need a difference_type in order for the resulting iterator to
+	// be usable with std::distance or the C++20 iterator concepts
+	template< typename, typename = void > struct infer_difference_type { using type = std::ptrdiff_t; };
 
 	template< typename Core >
 	struct infer_difference_type< Core, std::void_t< member_functions::distance_to_type< Core > > > {
@@ -42,6 +45,12 @@ namespace details {
 		using type = std::add_pointer_t< member_functions::dereference_type< Core > >;
 	};
 
+	// Cores may return references to elements that are stored inside the core itself (e.g. computed values), which
+	// only live as long as the core does. Such cores declare 'static constexpr bool stashes_elements = true'.
+	template< typename Core, typename = void > struct is_stashing_core : std::false_type {};
+
+	template< typename Core >
+	struct is_stashing_core< Core, std::enable_if_t< Core::stashes_elements > > : std::true_type {};
 
 } // namespace details
 
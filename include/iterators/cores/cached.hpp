@@ -0,0 +1,148 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_CACHED_HPP_
+#define ITERATORS_CORES_CACHED_HPP_
+
+#include "iterators/core_traits.hpp"
+#include "iterators/details/cache_box.hpp"
+#include "iterators/iterator_facade.hpp"
+#include "iterators/range.hpp"
+#include "iterators/type_traits.hpp"
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace iterators {
+
+// A core that computes the underlying core's element at most once per position: the result of the first dereference
+// is stored inside the core and returned by reference from then on, until the core is moved to a different position.
+// This is useful for cores whose dereference is expensive (decoding, hashing, ...), as the facade dereferences the
+// core again for every *it and it->.
+//
+// As the yielded references refer to the cache, a core that computes its elements (and can thus only back an input
+// iterator on its own) may declare a stronger traversal category, which is then made available by this adaptor. This
+// includes random access: as the elements are stashed inside the core, operator[] returns a copy of the element rather
+// than a reference into the temporary iterator it has been computed by (the same holds for the caching transform_core).
+// If the underlying core yields actual references, there is nothing to gain from caching and the core is merely
+// forwarded to (see the specialization below), so this adaptor can be applied unconditionally.
+//
+// Copies of the core carry their own cache, so they can be used independently. The cache is populated from within the
+// (const) dereference, so concurrent dereferencing of the same iterator requires external synchronization.
+template< typename Core, bool = std::is_reference_v< typename core_traits< Core >::reference > > class cached_core {
+public:
+	using target_iterator_category = typename core_traits< Core >::iterator_category;
+	using value_type               = typename core_traits< Core >::value_type;
+	using difference_type          = typename core_traits< Core >::difference_type;
+
+	static constexpr bool stashes_elements = true;
+
+	cached_core() = default;
+	cached_core(Core core) : m_core(std::move(core)) {}
+
+	[[nodiscard]] auto dereference() const -> const value_type & {
+		if (!m_cache.has_value()) {
+			m_cache.emplace(m_core.dereference());
+		}
+		return *m_cache;
+	}
+
+	[[nodiscard]] auto equals(const cached_core &other) const -> bool { return m_core.equals(other.m_core); }
+
+	void increment() {
+		m_cache.reset();
+		m_core.increment();
+	}
+
+	template< typename C = Core, typename = std::enable_if_t< member_functions::has_decrement_v< C > > >
+	void decrement() {
+		m_cache.reset();
+		m_core.decrement();
+	}
+
+	template< typename C = Core, typename = std::enable_if_t< member_functions::has_advance_v< C > > >
+	void advance(difference_type amount) {
+		if (amount != 0) {
+			m_cache.reset();
+			m_core.advance(amount);
+		}
+	}
+
+	template< typename C = Core, typename = std::enable_if_t< member_functions::has_distance_to_v< C > > >
+	[[nodiscard]] auto distance_to(const cached_core &other) const -> difference_type {
+		return m_core.distance_to(other.m_core);
+	}
+
+	[[nodiscard]] auto base() const -> const Core & { return m_core; }
+
+private:
+	Core m_core;
+	mutable details::cache_box< value_type > m_cache;
+};
+
+// Cores yielding references already give access to their elements without recomputing them, so they are wrapped
+// without any additional storage
+template< typename Core > class cached_core< Core, true > {
+public:
+	using target_iterator_category = typename core_traits< Core >::iterator_category;
+	using difference_type          = typename core_traits< Core >::difference_type;
+
+	static constexpr bool stashes_elements = details::is_stashing_core< Core >::value;
+
+	cached_core() = default;
+	cached_core(Core core) : m_core(std::move(core)) {}
+
+	[[nodiscard]] auto dereference() const -> typename core_traits< Core >::reference { return m_core.dereference(); }
+
+	[[nodiscard]] auto equals(const cached_core &other) const -> bool { return m_core.equals(other.m_core); }
+
+	void increment() { m_core.increment(); }
+
+	template< typename C = Core, typename = std::enable_if_t< member_functions::has_decrement_v< C > > >
+	void decrement() {
+		m_core.decrement();
+	}
+
+	template< typename C = Core, typename = std::enable_if_t< member_functions::has_advance_v< C > > >
+	void advance(difference_type amount) {
+		m_core.advance(amount);
+	}
+
+	template< typename C = Core, typename = std::enable_if_t< member_functions::has_distance_to_v< C > > >
+	[[nodiscard]] auto distance_to(const cached_core &other) const -> difference_type {
+		return m_core.distance_to(other.m_core);
+	}
+
+	[[nodiscard]] auto base() const -> const Core & { return m_core; }
+
+private:
+	Core m_core;
+};
+
+template< typename Core > using cached_iterator = iterator_facade< cached_core< Core > >;
+
+// The elements between the given cores, each of which is computed at most once per iterator position
+template< typename Core, typename = std::enable_if_t< !is_iterator_facade_v< Core > > >
+auto cached(Core first, Core last) -> range< cached_core< Core > > {
+	return { cached_core< Core >(std::move(first)), cached_core< Core >(std::move(last)) };
+}
+
+// The elements in [first, last), each of which is computed at most once per iterator position
+template< typename Core >
+auto cached(const iterator_facade< Core > &first, const iterator_facade< Core > &last) -> range< cached_core< Core > > {
+	return { cached_core< Core >(details::core_access::core(first)),
+			 cached_core< Core >(details::core_access::core(last)) };
+}
+
+// The elements of the given range (whose iterators must be of type iterator_facade< Core >), each of which is computed
+// at most once per iterator position
+template< typename Range >
+auto cached(const Range &range) -> decltype(::iterators::cached(std::begin(range), std::end(range))) {
+	return ::iterators::cached(std::begin(range), std::end(range));
+}
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_CACHED_HPP_
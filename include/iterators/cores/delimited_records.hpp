@@ -0,0 +1,193 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_DELIMITED_RECORDS_HPP_
+#define ITERATORS_CORES_DELIMITED_RECORDS_HPP_
+
+#include "iterators/iterator_facade.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <system_error>
+
+#ifdef _WIN32
+#	include <io.h>
+#else
+#	include <unistd.h>
+#endif
+
+namespace iterators {
+
+class delimited_reader;
+
+// An input core over the records read by a delimited_reader. All copies of a core share the reader's state, so
+// (as for any input iterator) only the most recently incremented copy may be dereferenced.
+class delimited_record_core {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+
+	delimited_record_core() = default;
+	explicit delimited_record_core(delimited_reader *reader) : m_reader(reader) {}
+
+	// The returned view refers to the reader's internal buffer and is invalidated by the next increment
+	[[nodiscard]] auto dereference() const -> std::string_view;
+
+	// All cores that have reached the end of the input compare equal (including default-constructed ones)
+	[[nodiscard]] auto equals(const delimited_record_core &other) const -> bool { return at_end() == other.at_end(); }
+
+	void increment();
+
+private:
+	delimited_reader *m_reader = nullptr;
+
+	[[nodiscard]] auto at_end() const -> bool;
+};
+
+using delimited_record_iterator = iterator_facade< delimited_record_core >;
+
+// Splits the data read from a file descriptor into records separated by a delimiter (e.g. the lines of a log file).
+// The data is read in large blocks into an internal buffer and records are handed out as views into that buffer, so
+// no per-record allocations or copies are made. Delimiters are searched via memchr, which standard libraries
+// implement with vector instructions. A record that straddles the end of the buffer is moved to the front before the
+// buffer is refilled, and the buffer grows if a single record doesn't fit into it.
+//
+// The reader does not take ownership of the file descriptor. The delimiter is not part of the records and a trailing
+// delimiter at the end of the input does not start another (empty) record.
+class delimited_reader {
+public:
+	static constexpr std::size_t default_buffer_size = 64 * 1024;
+
+	explicit delimited_reader(int descriptor, char delimiter = '\n', std::size_t buffer_size = default_buffer_size)
+		: m_descriptor(descriptor), m_delimiter(delimiter), m_buffer(new char[buffer_size > 0 ? buffer_size : 1]),
+		  m_capacity(buffer_size > 0 ? buffer_size : 1) {}
+
+	// The reader is referenced by its iterators and therefore can't be copied or moved
+	delimited_reader(const delimited_reader &) = delete;
+	auto operator=(const delimited_reader &) -> delimited_reader & = delete;
+
+	// Returns an iterator to the current record, reading the first one if that hasn't happened yet. As the input can
+	// only be traversed once, all calls return iterators to the same position.
+	[[nodiscard]] auto begin() -> delimited_record_iterator {
+		if (!m_started) {
+			m_started = true;
+			next();
+		}
+		return delimited_record_iterator(delimited_record_core(this));
+	}
+
+	[[nodiscard]] auto end() const -> delimited_record_iterator {
+		return delimited_record_iterator(delimited_record_core());
+	}
+
+	// The record the reader currently points to
+	[[nodiscard]] auto current() const -> std::string_view { return m_current; }
+
+	[[nodiscard]] auto exhausted() const -> bool { return m_exhausted; }
+
+	// Moves on to the next record. Throws std::system_error if reading from the file descriptor fails.
+	void next() {
+		while (true) {
+			const char *found = static_cast< const char * >(
+				std::memchr(m_buffer.get() + m_scanned, m_delimiter, m_filled - m_scanned));
+
+			if (found != nullptr) {
+				const std::size_t position = static_cast< std::size_t >(found - m_buffer.get());
+				m_current                  = std::string_view(m_buffer.get() + m_start, position - m_start);
+				m_start                    = position + 1;
+				m_scanned                  = m_start;
+				return;
+			}
+
+			// There is no delimiter in the remaining data, so bytes up to m_filled don't need to be searched again
+			m_scanned = m_filled;
+
+			if (m_end_of_input || !refill()) {
+				if (m_start < m_filled) {
+					// The last record is not followed by a delimiter
+					m_current = std::string_view(m_buffer.get() + m_start, m_filled - m_start);
+					m_start   = m_filled;
+				} else {
+					m_current   = {};
+					m_exhausted = true;
+				}
+				return;
+			}
+		}
+	}
+
+private:
+	int m_descriptor;
+	char m_delimiter;
+	std::unique_ptr< char[] > m_buffer;
+	std::size_t m_capacity;
+	// The unconsumed data is located in [m_start, m_filled)
+	std::size_t m_start  = 0;
+	std::size_t m_filled = 0;
+	// Position up to which the unconsumed data is known not to contain the delimiter
+	std::size_t m_scanned = 0;
+	std::string_view m_current;
+	bool m_started      = false;
+	bool m_end_of_input = false;
+	bool m_exhausted    = false;
+
+	// Reads more data into the buffer after moving the unconsumed part to its front. Returns false at the end of the
+	// input.
+	auto refill() -> bool {
+		const std::size_t unconsumed = m_filled - m_start;
+
+		if (unconsumed == m_capacity) {
+			// A single record occupies the entire buffer
+			std::unique_ptr< char[] > larger(new char[2 * m_capacity]);
+			std::memcpy(larger.get(), m_buffer.get() + m_start, unconsumed);
+			m_buffer = std::move(larger);
+			m_capacity *= 2;
+		} else if (m_start > 0) {
+			std::memmove(m_buffer.get(), m_buffer.get() + m_start, unconsumed);
+		}
+
+		m_scanned -= m_start;
+		m_start  = 0;
+		m_filled = unconsumed;
+
+		const std::size_t read = read_some(m_buffer.get() + m_filled, m_capacity - m_filled);
+		if (read == 0) {
+			m_end_of_input = true;
+			return false;
+		}
+
+		m_filled += read;
+		return true;
+	}
+
+	auto read_some(char *destination, std::size_t size) const -> std::size_t {
+		while (true) {
+#ifdef _WIN32
+			const int result =
+				::_read(m_descriptor, destination, static_cast< unsigned int >(size < 0x7FFFFFFF ? size : 0x7FFFFFFF));
+#else
+			const ::ssize_t result = ::read(m_descriptor, destination, size);
+#endif
+			if (result >= 0) {
+				return static_cast< std::size_t >(result);
+			}
+			if (errno != EINTR) {
+				throw std::system_error(errno, std::generic_category(), "Failed to read delimited records");
+			}
+		}
+	}
+};
+
+inline auto delimited_record_core::dereference() const -> std::string_view { return m_reader->current(); }
+
+inline void delimited_record_core::increment() { m_reader->next(); }
+
+inline auto delimited_record_core::at_end() const -> bool { return m_reader == nullptr || m_reader->exhausted(); }
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_DELIMITED_RECORDS_HPP_
@@ -0,0 +1,282 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_DELTA_VBYTE_HPP_
+#define ITERATORS_CORES_DELTA_VBYTE_HPP_
+
+#include "iterators/iterator_facade.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#if defined(__SSSE3__) || defined(__AVX__)
+#	include <tmmintrin.h>
+#	define ITERATORS_DELTA_VBYTE_SSSE3
+#endif
+
+namespace iterators {
+
+namespace details {
+
+	// Lookup tables for decoding a group of four integers: for each control byte, the shuffle mask that moves the
+	// bytes of every integer into its own 32-bit lane (zero-filling the missing bytes) and the total amount of bytes
+	// occupied by the group
+	struct vbyte_tables {
+		std::uint8_t masks[256][16];
+		std::uint8_t lengths[256];
+	};
+
+	constexpr auto make_vbyte_tables() -> vbyte_tables {
+		vbyte_tables tables = {};
+
+		for (unsigned int control = 0; control < 256; ++control) {
+			unsigned int offset = 0;
+
+			for (unsigned int lane = 0; lane < 4; ++lane) {
+				const unsigned int length = ((control >> (2 * lane)) & 3U) + 1;
+
+				for (unsigned int byte = 0; byte < 4; ++byte) {
+					tables.masks[control][4 * lane + byte] =
+						static_cast< std::uint8_t >(byte < length ? offset + byte : 0xFF);
+				}
+
+				offset += length;
+			}
+
+			tables.lengths[control] = static_cast< std::uint8_t >(offset);
+		}
+
+		return tables;
+	}
+
+	inline constexpr vbyte_tables vbyte_lookup = make_vbyte_tables();
+
+	// The encoded representation of a delta_vbyte_sequence (see there)
+	struct delta_vbyte_data {
+		static constexpr std::size_t block_size = 128;
+
+		struct block_info {
+			// The value preceding the block (or 0 for the first block)
+			std::uint32_t base;
+			// The last value in the block
+			std::uint32_t last;
+			// Offset of the block's first group in data
+			std::size_t data_offset;
+		};
+
+		// One control byte per group of four integers holding the byte lengths (minus one) of the integers
+		std::vector< std::uint8_t > control;
+		// The deltas between consecutive values with as few bytes as possible (little-endian). The vector contains 16
+		// bytes of padding at the end, so that groups can always be loaded with a single 16 byte load.
+		std::vector< std::uint8_t > data;
+		std::vector< block_info > blocks;
+		std::size_t size = 0;
+
+		// Decodes the given block into the output, which must have room for block_size values, and returns the amount
+		// of decoded values
+		auto decode_block(std::size_t block, std::uint32_t *output) const -> std::size_t {
+			const std::size_t count  = std::min(block_size, size - block * block_size);
+			const std::size_t groups = (count + 3) / 4;
+
+			const std::uint8_t *controls = control.data() + block * (block_size / 4);
+			const std::uint8_t *bytes    = data.data() + blocks[block].data_offset;
+
+#ifdef ITERATORS_DELTA_VBYTE_SSSE3
+			__m128i previous = _mm_set1_epi32(static_cast< int >(blocks[block].base));
+
+			for (std::size_t group = 0; group < groups; ++group) {
+				const __m128i mask =
+					_mm_loadu_si128(reinterpret_cast< const __m128i * >(vbyte_lookup.masks[controls[group]]));
+				__m128i values = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast< const __m128i * >(bytes)), mask);
+
+				// Prefix sum over the four deltas
+				values = _mm_add_epi32(values, _mm_slli_si128(values, 4));
+				values = _mm_add_epi32(values, _mm_slli_si128(values, 8));
+				values = _mm_add_epi32(values, previous);
+
+				_mm_storeu_si128(reinterpret_cast< __m128i * >(output + 4 * group), values);
+
+				previous = _mm_shuffle_epi32(values, 0xFF);
+				bytes += vbyte_lookup.lengths[controls[group]];
+			}
+#else
+			std::uint32_t previous = blocks[block].base;
+
+			for (std::size_t group = 0; group < groups; ++group) {
+				for (unsigned int lane = 0; lane < 4; ++lane) {
+					const unsigned int length = ((controls[group] >> (2 * lane)) & 3U) + 1;
+
+					std::uint32_t delta = 0;
+					for (unsigned int byte = 0; byte < length; ++byte) {
+						delta |= static_cast< std::uint32_t >(bytes[byte]) << (8 * byte);
+					}
+					bytes += length;
+
+					previous += delta;
+					output[4 * group + lane] = previous;
+				}
+			}
+#endif
+
+			return count;
+		}
+	};
+
+} // namespace details
+
+#undef ITERATORS_DELTA_VBYTE_SSSE3
+
+// An input core over the values of a delta_vbyte_sequence. Values are decoded a whole block at a time into a buffer
+// inside the core and dereferencing yields a reference into that buffer.
+class delta_vbyte_core {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+
+	static constexpr std::size_t block_size = details::delta_vbyte_data::block_size;
+
+	static constexpr bool stashes_elements = true;
+
+	delta_vbyte_core() = default;
+
+	delta_vbyte_core(const details::delta_vbyte_data *data, std::size_t block) : m_data(data) { load_block(block); }
+
+	[[nodiscard]] auto dereference() const -> const std::uint32_t & { return m_buffer[m_index]; }
+
+	[[nodiscard]] auto equals(const delta_vbyte_core &other) const -> bool {
+		return m_block == other.m_block && m_index == other.m_index;
+	}
+
+	void increment() {
+		if (++m_index == m_count) {
+			load_block(m_block + 1);
+		}
+	}
+
+	// Moves to the first value that is not less than the target (or to the end, if there is none). Blocks whose last
+	// value is less than the target are skipped without being decoded. Requires the values to be sorted in ascending
+	// order.
+	void skip_to(std::uint32_t target) {
+		if (m_index == m_count) {
+			return;
+		}
+
+		if (m_data->blocks[m_block].last < target) {
+			auto found = std::partition_point(
+				m_data->blocks.begin() + static_cast< std::ptrdiff_t >(m_block) + 1, m_data->blocks.end(),
+				[target](const details::delta_vbyte_data::block_info &block) { return block.last < target; });
+
+			load_block(static_cast< std::size_t >(found - m_data->blocks.begin()));
+			if (m_count == 0) {
+				return;
+			}
+		}
+
+		m_index = static_cast< std::size_t >(
+			std::lower_bound(m_buffer.data() + m_index, m_buffer.data() + m_count, target) - m_buffer.data());
+	}
+
+private:
+	const details::delta_vbyte_data *m_data = nullptr;
+	std::size_t m_block                     = 0;
+	std::size_t m_index                     = 0;
+	std::size_t m_count                     = 0;
+	std::array< std::uint32_t, block_size > m_buffer;
+
+	void load_block(std::size_t block) {
+		m_block = block;
+		m_index = 0;
+		m_count = block < m_data->blocks.size() ? m_data->decode_block(block, m_buffer.data()) : 0;
+	}
+};
+
+using delta_vbyte_iterator = iterator_facade< delta_vbyte_core >;
+
+// A compressed sequence of 32-bit unsigned integers, e.g. a sorted list of IDs. The differences between consecutive
+// values are stored in the StreamVByte format: the integers are grouped by four, each group being described by a
+// control byte holding the byte lengths of its integers. As the control bytes are stored separately from the data,
+// whole groups can be decoded at once with a table-driven byte shuffle (if SSSE3 is enabled, with a scalar fallback
+// otherwise). The values are split into blocks of 128, which are decoded one at a time during iteration, so that the
+// sequence never has to be decompressed as a whole. Additionally, the last value of each block is stored, which allows
+// skip_to to jump over blocks (e.g. when intersecting sorted lists).
+//
+// Any sequence of integers can be stored (differences wrap around), but skip_to requires the values to be sorted.
+class delta_vbyte_sequence {
+public:
+	static constexpr std::size_t block_size = details::delta_vbyte_data::block_size;
+
+	delta_vbyte_sequence() { m_data.data.resize(16); }
+
+	template< typename InputIterator > delta_vbyte_sequence(InputIterator first, InputIterator last) {
+		std::uint32_t previous  = 0;
+		std::uint32_t deltas[4] = {};
+
+		for (; first != last; ++first) {
+			const auto value = static_cast< std::uint32_t >(*first);
+
+			if (m_data.size % block_size == 0) {
+				m_data.blocks.push_back({ previous, value, m_data.data.size() });
+			}
+
+			deltas[m_data.size % 4]   = value - previous;
+			previous                  = value;
+			m_data.blocks.back().last = value;
+
+			if (++m_data.size % 4 == 0) {
+				append_group(deltas);
+			}
+		}
+
+		if (m_data.size % 4 != 0) {
+			// Pad the last group with zero deltas
+			std::fill(deltas + m_data.size % 4, deltas + 4, 0);
+			append_group(deltas);
+		}
+
+		m_data.data.resize(m_data.data.size() + 16);
+	}
+
+	// Iterators refer to the sequence, so it must not be moved or destroyed while they are in use
+	[[nodiscard]] auto begin() const -> delta_vbyte_iterator { return delta_vbyte_core(&m_data, 0); }
+	[[nodiscard]] auto end() const -> delta_vbyte_iterator { return delta_vbyte_core(&m_data, m_data.blocks.size()); }
+
+	[[nodiscard]] auto size() const -> std::size_t { return m_data.size; }
+	[[nodiscard]] auto empty() const -> bool { return m_data.size == 0; }
+
+	// The amount of bytes occupied by the encoded values (excluding the block index and padding)
+	[[nodiscard]] auto compressed_size() const -> std::size_t {
+		return m_data.control.size() + m_data.data.size() - 16;
+	}
+
+private:
+	details::delta_vbyte_data m_data;
+
+	void append_group(const std::uint32_t (&deltas)[4]) {
+		std::uint8_t control = 0;
+
+		for (unsigned int lane = 0; lane < 4; ++lane) {
+			const std::uint32_t delta = deltas[lane];
+			const unsigned int length = delta < (1U << 8U) ? 1 : delta < (1U << 16U) ? 2 : delta < (1U << 24U) ? 3 : 4;
+
+			control |= static_cast< std::uint8_t >((length - 1) << (2 * lane));
+			for (unsigned int byte = 0; byte < length; ++byte) {
+				m_data.data.push_back(static_cast< std::uint8_t >(delta >> (8 * byte)));
+			}
+		}
+
+		m_data.control.push_back(control);
+	}
+};
+
+// Moves the given iterator to the first value that is not less than the target (see delta_vbyte_core::skip_to)
+inline void skip_to(delta_vbyte_iterator &iterator, std::uint32_t target) {
+	details::core_access::core(iterator).skip_to(target);
+}
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_DELTA_VBYTE_HPP_
@@ -0,0 +1,247 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_FILTER_HPP_
+#define ITERATORS_CORES_FILTER_HPP_
+
+#include "iterators/core_traits.hpp"
+#include "iterators/details/bit_operations.hpp"
+#include "iterators/details/semiregular_box.hpp"
+#include "iterators/iterator_facade.hpp"
+#include "iterators/range.hpp"
+#include "iterators/type_traits.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace iterators {
+
+// Marks a predicate as vectorizable: it is cheap, free of side effects and can be evaluated for any element of the
+// source, so a filter may evaluate it for a whole block of elements ahead of time (see filter_core). Predicates can
+// either be wrapped by vectorizable() or marked by specializing is_vectorizable_predicate.
+template< typename Predicate > struct vectorizable_predicate {
+	Predicate predicate;
+
+	template< typename T > auto operator()(const T &value) const -> bool { return predicate(value); }
+};
+
+template< typename Predicate > struct is_vectorizable_predicate : std::false_type {};
+template< typename Predicate >
+struct is_vectorizable_predicate< vectorizable_predicate< Predicate > > : std::true_type {};
+
+template< typename Predicate >
+constexpr bool is_vectorizable_predicate_v = is_vectorizable_predicate< Predicate >::value;
+
+template< typename Predicate > auto vectorizable(Predicate predicate) -> vectorizable_predicate< Predicate > {
+	return { std::move(predicate) };
+}
+
+// A core yielding only those elements of the underlying core for which the predicate returns true. The predicate is
+// evaluated one element at a time while incrementing, so it is only ever called for elements up to (and including) the
+// next accepted one. The iterator category is at most forward, as filters can't step backwards or jump ahead cheaply.
+//
+// Sources given as pointers to arithmetic elements are handled by the specialization below, which evaluates
+// vectorizable predicates for whole blocks of elements at once.
+template< typename Core, typename Predicate > class filter_core {
+public:
+	using target_iterator_category =
+		std::conditional_t< iterator_category::is_at_least_v< typename core_traits< Core >::iterator_category,
+															  std::forward_iterator_tag >,
+							std::forward_iterator_tag, std::input_iterator_tag >;
+
+	static constexpr bool stashes_elements = details::is_stashing_core< Core >::value;
+
+	filter_core() = default;
+
+	// Creates a core pointing to the first accepted element in [current, end)
+	filter_core(Core current, Core end, Predicate predicate)
+		: m_current(std::move(current)), m_end(std::move(end)), m_predicate(std::move(predicate)) {
+		skip_rejected();
+	}
+
+	[[nodiscard]] auto dereference() const -> typename core_traits< Core >::reference {
+		return m_current.dereference();
+	}
+
+	[[nodiscard]] auto equals(const filter_core &other) const -> bool { return m_current.equals(other.m_current); }
+
+	void increment() {
+		m_current.increment();
+		skip_rejected();
+	}
+
+	[[nodiscard]] auto base() const -> const Core & { return m_current; }
+
+private:
+	Core m_current;
+	Core m_end;
+	details::semiregular_box< Predicate > m_predicate;
+
+	void skip_rejected() {
+		while (!m_current.equals(m_end) && !m_predicate(m_current.dereference())) {
+			m_current.increment();
+		}
+	}
+};
+
+// A filter over a contiguous array. If the elements are arithmetic and the predicate is vectorizable, the predicate is
+// evaluated for a block of block_size elements at once and the results are packed into a bitmask, whose set bits are
+// then visited via count-trailing-zeros (like set_bits_core does). The evaluation of a block is a branch-free loop with
+// a fixed trip count, which the compiler turns into SIMD comparisons, and rejected elements are skipped without a
+// single branch. Otherwise, elements are tested one at a time like in the general filter_core.
+template< typename T, typename Predicate > class filter_core< T *, Predicate > {
+public:
+	using target_iterator_category = std::forward_iterator_tag;
+
+	static constexpr bool uses_blocks =
+		std::is_arithmetic_v< std::remove_cv_t< T > > && is_vectorizable_predicate_v< Predicate >;
+	static constexpr std::size_t block_size = 64;
+
+	filter_core() = default;
+
+	// Creates a core pointing to the first accepted element in [current, end)
+	filter_core(T *current, T *end, Predicate predicate)
+		: m_current(current), m_block(current), m_end(end), m_predicate(std::move(predicate)) {
+		if constexpr (uses_blocks) {
+			if (m_block != m_end) {
+				m_bits = evaluate_block(m_block, static_cast< std::size_t >(m_end - m_block), m_predicate.get());
+			}
+			find_set_bit();
+		} else {
+			skip_rejected();
+		}
+	}
+
+	[[nodiscard]] auto dereference() const -> T & { return *m_current; }
+
+	[[nodiscard]] auto equals(const filter_core &other) const -> bool { return m_current == other.m_current; }
+
+	void increment() {
+		if constexpr (uses_blocks) {
+			m_bits = details::clear_lowest_bit(m_bits);
+			find_set_bit();
+		} else {
+			++m_current;
+			skip_rejected();
+		}
+	}
+
+	[[nodiscard]] auto base() const -> T * { return m_current; }
+
+private:
+	T *m_current = nullptr;
+	// The start of the block whose evaluated predicates are held in m_bits
+	T *m_block = nullptr;
+	T *m_end   = nullptr;
+	// The accepted elements of the current block that have not been visited yet
+	std::uint64_t m_bits = 0;
+	details::semiregular_box< Predicate > m_predicate;
+
+	void skip_rejected() {
+		while (m_current != m_end && !m_predicate(std::as_const(*m_current))) {
+			++m_current;
+		}
+	}
+
+	void find_set_bit() {
+		while (m_bits == 0) {
+			if (m_end - m_block <= static_cast< std::ptrdiff_t >(block_size)) {
+				m_current = m_end;
+				return;
+			}
+
+			m_block += block_size;
+			m_bits = evaluate_block(m_block, static_cast< std::size_t >(m_end - m_block), m_predicate.get());
+		}
+
+		m_current = m_block + details::count_trailing_zeros(m_bits);
+	}
+
+	// Evaluates the predicate for the count (at most block_size) elements starting at block. This is a static function,
+	// so that the core itself doesn't escape into a function that is not necessarily inlined and can be kept in
+	// registers while iterating.
+	[[nodiscard]] static auto evaluate_block(const T *block, std::size_t count, const Predicate &predicate)
+		-> std::uint64_t {
+		if (count < block_size) {
+			std::uint64_t bits = 0;
+			for (std::size_t i = 0; i < count; ++i) {
+				bits |= static_cast< std::uint64_t >(static_cast< bool >(predicate(block[i]))) << i;
+			}
+			return bits;
+		}
+
+		// Storing the results as bytes first keeps the loop free of cross-lane dependencies, so that it vectorizes
+		// well. Shifting every result into its bit directly performs about half as fast.
+		unsigned char flags[block_size];
+		for (std::size_t i = 0; i < block_size; ++i) {
+			flags[i] = static_cast< unsigned char >(static_cast< bool >(predicate(block[i])));
+		}
+
+		std::uint64_t bits = 0;
+		for (std::size_t byte = 0; byte < block_size; byte += 8) {
+			std::uint64_t packed = 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+			for (std::size_t i = 0; i < 8; ++i) {
+				packed |= static_cast< std::uint64_t >(flags[byte + i]) << (8 * i);
+			}
+#else
+			std::memcpy(&packed, flags + byte, sizeof(packed));
+#endif
+			bits |= details::pack_byte_flags(packed) << byte;
+		}
+		return bits;
+	}
+};
+
+template< typename Core, typename Predicate > using filter_iterator = iterator_facade< filter_core< Core, Predicate > >;
+
+// The elements between the given cores (or pointers) for which the predicate returns true
+template< typename Core, typename Predicate, typename = std::enable_if_t< !is_iterator_facade_v< Core > > >
+auto filtered(Core first, Core last, Predicate predicate) -> range< filter_core< Core, Predicate > > {
+	return { filter_core< Core, Predicate >(first, last, predicate),
+			 filter_core< Core, Predicate >(last, last, predicate) };
+}
+
+// The elements in [first, last) for which the predicate returns true
+template< typename Core, typename Predicate >
+auto filtered(const iterator_facade< Core > &first, const iterator_facade< Core > &last, Predicate predicate)
+	-> range< filter_core< Core, Predicate > > {
+	return ::iterators::filtered(details::core_access::core(first), details::core_access::core(last),
+								 std::move(predicate));
+}
+
+namespace details {
+
+	template< typename Range, typename = void > struct is_contiguous_range : std::false_type {};
+	template< typename Range >
+	struct is_contiguous_range< Range, std::void_t< decltype(std::data(std::declval< Range & >())),
+													decltype(std::size(std::declval< Range & >())) > >
+		: std::true_type {};
+
+} // namespace details
+
+// The elements of the given range for which the predicate returns true. Contiguous ranges (containers exposing data()
+// and size(), such as std::vector) are filtered via pointers, so that vectorizable predicates are evaluated in blocks.
+// Other ranges must consist of iterator facades.
+template< typename Range, typename Predicate,
+		  typename = std::enable_if_t< details::is_contiguous_range< Range >::value > >
+auto filtered(Range &range, Predicate predicate)
+	-> decltype(::iterators::filtered(std::data(range), std::data(range), std::move(predicate))) {
+	return ::iterators::filtered(std::data(range), std::data(range) + std::size(range), std::move(predicate));
+}
+
+template< typename Range, typename Predicate,
+		  typename = std::enable_if_t< !details::is_contiguous_range< Range >::value > >
+auto filtered(const Range &range, Predicate predicate)
+	-> decltype(::iterators::filtered(std::begin(range), std::end(range), std::move(predicate))) {
+	return ::iterators::filtered(std::begin(range), std::end(range), std::move(predicate));
+}
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_FILTER_HPP_
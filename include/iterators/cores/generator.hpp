@@ -0,0 +1,350 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_GENERATOR_HPP_
+#define ITERATORS_CORES_GENERATOR_HPP_
+
+#if __has_include(<version>)
+#	include <version>
+#endif
+
+// Generators are built on coroutines, so this header is empty unless compiling as C++20 (or later)
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#	include "iterators/iterator_facade.hpp"
+
+#	include <coroutine>
+#	include <cstddef>
+#	include <exception>
+#	include <iterator>
+#	include <memory>
+#	include <new>
+#	include <type_traits>
+#	include <utility>
+
+namespace iterators {
+
+template< typename T > class generator;
+template< typename T > class generator_core;
+
+// Yielding elements_of(nested) from a generator yields all elements of the nested generator in its place
+template< typename Generator > struct elements_of {
+	Generator generator;
+
+	explicit elements_of(Generator nested) noexcept : generator(std::move(nested)) {}
+};
+
+template< typename Generator > elements_of(Generator) -> elements_of< Generator >;
+
+namespace details {
+
+	// Recycles the memory of coroutine frames. Recursive generators (e.g. tree walks) create a frame for every
+	// nested call, which would otherwise cost a heap allocation for (almost) every element. Freed frames are kept in
+	// per-thread free lists for sizes rounded up to a multiple of granularity and handed out again for frames of the
+	// same size class. At most max_cached frames are kept per size class and frames larger than
+	// granularity * size_classes bytes are not recycled.
+	//
+	// Generators may outlive the thread-local objects of their thread, e.g. those with static storage duration or those
+	// destroyed by atexit handlers (thread-local objects of the main thread are destroyed before objects with static
+	// storage duration). The pool itself is therefore trivially destructible, so that it stays usable until the very
+	// end. Its cached frames are released by a separate guard instead, after which frames are no longer recycled but
+	// allocated and freed directly.
+	class coroutine_frame_pool {
+	public:
+		static constexpr std::size_t granularity  = 64;
+		static constexpr std::size_t size_classes = 16;
+		static constexpr std::size_t max_cached   = 256;
+
+		constexpr coroutine_frame_pool() = default;
+
+		coroutine_frame_pool(const coroutine_frame_pool &)                     = delete;
+		auto operator=(const coroutine_frame_pool &) -> coroutine_frame_pool & = delete;
+
+		// The pool of the calling thread
+		[[nodiscard]] static auto local() -> coroutine_frame_pool & {
+			constinit thread_local coroutine_frame_pool pool;
+			thread_local const release_guard guard{ pool };
+			return pool;
+		}
+
+		[[nodiscard]] auto allocate(std::size_t size) -> void * {
+			const std::size_t size_class = size_class_of(size);
+			if (size_class >= size_classes || m_released) {
+				return ::operator new(size);
+			}
+
+			free_list &list = m_free[size_class];
+			if (list.head == nullptr) {
+				return ::operator new((size_class + 1) * granularity);
+			}
+
+			block *recycled = list.head;
+			list.head       = recycled->next;
+			--list.count;
+			return recycled;
+		}
+
+		void deallocate(void *memory, std::size_t size) noexcept {
+			const std::size_t size_class = size_class_of(size);
+			if (size_class >= size_classes || m_released || m_free[size_class].count >= max_cached) {
+				::operator delete(memory);
+				return;
+			}
+
+			free_list &list = m_free[size_class];
+			list.head       = ::new (memory) block{ list.head };
+			++list.count;
+		}
+
+	private:
+		struct block {
+			block *next;
+		};
+
+		struct free_list {
+			block *head        = nullptr;
+			std::size_t count = 0;
+		};
+
+		// Frees the cached frames when the thread's thread-local objects are destroyed
+		struct release_guard {
+			coroutine_frame_pool &pool;
+
+			~release_guard() { pool.release(); }
+		};
+
+		free_list m_free[size_classes];
+		bool m_released = false;
+
+		void release() noexcept {
+			m_released = true;
+			for (free_list &list : m_free) {
+				while (list.head != nullptr) {
+					block *next = list.head->next;
+					::operator delete(list.head);
+					list.head = next;
+				}
+				list.count = 0;
+			}
+		}
+
+		[[nodiscard]] static constexpr auto size_class_of(std::size_t size) noexcept -> std::size_t {
+			return size == 0 ? 0 : (size - 1) / granularity;
+		}
+	};
+
+	// The promise of a generator< T >. Nested generators (see elements_of) form a stack of coroutines, of which only
+	// the innermost one (the leaf) is running. The outermost one (the root) keeps track of the leaf as well as the
+	// current element, so that incrementing resumes the leaf directly and dereferencing doesn't depend on the depth of
+	// the nesting either. Control is passed between nested generators via symmetric transfer, i.e. without growing the
+	// stack.
+	template< typename T > class generator_promise {
+	public:
+		using reference = std::conditional_t< std::is_reference_v< T >, T, const T & >;
+
+		[[nodiscard]] auto get_return_object() noexcept -> generator< T > {
+			m_leaf = std::coroutine_handle< generator_promise >::from_promise(*this);
+			return generator< T >(std::coroutine_handle< generator_promise >::from_promise(*this));
+		}
+
+		[[nodiscard]] static auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+
+		struct final_awaiter {
+			[[nodiscard]] static auto await_ready() noexcept -> bool { return false; }
+
+			// Continues with the generator this one is nested in (if any)
+			[[nodiscard]] static auto await_suspend(std::coroutine_handle< generator_promise > handle) noexcept
+				-> std::coroutine_handle<> {
+				generator_promise &promise = handle.promise();
+				if (promise.m_parent == nullptr) {
+					return std::noop_coroutine();
+				}
+
+				const auto parent     = std::coroutine_handle< generator_promise >::from_promise(*promise.m_parent);
+				promise.m_root->m_leaf = parent;
+				return parent;
+			}
+
+			static void await_resume() noexcept {}
+		};
+
+		[[nodiscard]] static auto final_suspend() noexcept -> final_awaiter { return {}; }
+
+		// The element is referenced rather than copied. Temporaries live until the generator is resumed, as the
+		// suspension is part of the full expression containing co_yield.
+		auto yield_value(reference element) noexcept -> std::suspend_always {
+			m_root->m_element = std::addressof(element);
+			return {};
+		}
+
+		struct nested_awaiter {
+			generator< T > nested;
+
+			[[nodiscard]] auto await_ready() const noexcept -> bool { return !nested.m_handle; }
+
+			// Starts the nested generator, which becomes the new leaf
+			[[nodiscard]] auto await_suspend(std::coroutine_handle< generator_promise > handle) noexcept
+				-> std::coroutine_handle<> {
+				generator_promise &parent = handle.promise();
+				generator_promise &child  = nested.m_handle.promise();
+
+				child.m_root          = parent.m_root;
+				child.m_parent        = &parent;
+				child.m_owner         = &nested;
+				parent.m_root->m_leaf = nested.m_handle;
+				return nested.m_handle;
+			}
+
+			// Exceptions of the nested generator propagate to the generator it is nested in
+			void await_resume() const {
+				if (nested.m_handle && nested.m_handle.promise().m_exception) {
+					std::rethrow_exception(nested.m_handle.promise().m_exception);
+				}
+			}
+		};
+
+		[[nodiscard]] auto yield_value(elements_of< generator< T > > elements) noexcept -> nested_awaiter {
+			return { std::move(elements.generator) };
+		}
+
+		void return_void() noexcept {}
+
+		void unhandled_exception() {
+			if (m_parent == nullptr) {
+				throw;
+			}
+			m_exception = std::current_exception();
+		}
+
+		[[nodiscard]] static auto operator new(std::size_t size) -> void * {
+			return coroutine_frame_pool::local().allocate(size);
+		}
+
+		static void operator delete(void *frame, std::size_t size) noexcept {
+			coroutine_frame_pool::local().deallocate(frame, size);
+		}
+
+	private:
+		friend class generator< T >;
+		friend class generator_core< T >;
+
+		// Only maintained by the root
+		std::add_pointer_t< reference > m_element = nullptr;
+		std::coroutine_handle< generator_promise > m_leaf;
+
+		generator_promise *m_root   = this;
+		generator_promise *m_parent = nullptr;
+		// The generator object owning a nested generator's coroutine
+		generator< T > *m_owner = nullptr;
+		std::exception_ptr m_exception;
+	};
+
+} // namespace details
+
+// An input core over the elements yielded by a generator. Incrementing resumes the generator (or rather, its innermost
+// nested generator) until it yields the next element, which is referenced by the core (the reference is valid until
+// the next increment). Cores are handles to the generator's state, so all copies share the same position and the
+// generator has to outlive them. A core that has been default-constructed marks the end.
+template< typename T > class generator_core {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+	using promise_type             = details::generator_promise< T >;
+	using reference                = typename promise_type::reference;
+
+	generator_core() noexcept = default;
+	explicit generator_core(std::coroutine_handle< promise_type > handle) noexcept : m_handle(handle) {}
+
+	[[nodiscard]] auto dereference() const noexcept -> reference {
+		return static_cast< reference >(*m_handle.promise().m_element);
+	}
+
+	[[nodiscard]] auto equals(const generator_core &other) const noexcept -> bool { return done() == other.done(); }
+
+	void increment() { m_handle.promise().m_leaf.resume(); }
+
+private:
+	std::coroutine_handle< promise_type > m_handle;
+
+	[[nodiscard]] auto done() const noexcept -> bool { return !m_handle || m_handle.done(); }
+};
+
+template< typename T > using generator_iterator = iterator_facade< generator_core< T > >;
+
+// The return type of coroutines yielding elements of type T (by const reference, or as the given reference type if T
+// is a reference), e.g.
+//
+//     auto walk(const Node *node) -> iterators::generator< int > {
+//         if (node != nullptr) {
+//             co_yield iterators::elements_of(walk(node->left));
+//             co_yield node->value;
+//             co_yield iterators::elements_of(walk(node->right));
+//         }
+//     }
+//
+// Generators are move-only input ranges that own the coroutine. The coroutine starts running once begin() is called,
+// which may only happen once. Nested generators are resumed directly instead of passing every element up through all
+// levels of the nesting, and frames are allocated from a per-thread pool (see coroutine_frame_pool).
+template< typename T > class generator {
+public:
+	using promise_type = details::generator_promise< T >;
+	using iterator     = generator_iterator< T >;
+
+	generator() noexcept = default;
+
+	generator(generator &&other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+
+	auto operator=(generator &&other) noexcept -> generator & {
+		if (this != &other) {
+			destroy();
+			m_handle = std::exchange(other.m_handle, {});
+		}
+		return *this;
+	}
+
+	~generator() { destroy(); }
+
+	[[nodiscard]] auto begin() -> iterator {
+		if (m_handle) {
+			m_handle.resume();
+		}
+		return iterator(generator_core< T >(m_handle));
+	}
+
+	[[nodiscard]] auto end() const noexcept -> iterator { return iterator(generator_core< T >()); }
+
+private:
+	friend promise_type;
+
+	std::coroutine_handle< promise_type > m_handle;
+
+	explicit generator(std::coroutine_handle< promise_type > handle) noexcept : m_handle(handle) {}
+
+	// Destroying a coroutine destroys the generators nested in it, so destroying a deeply nested generator directly
+	// would recurse through all levels. Instead, the nested generators are destroyed from the leaf upwards.
+	void destroy() noexcept {
+		if (!m_handle) {
+			return;
+		}
+
+		promise_type &promise = m_handle.promise();
+		if (promise.m_root == &promise) {
+			for (auto leaf = promise.m_leaf; leaf != m_handle;) {
+				promise_type &nested = leaf.promise();
+				const auto parent    = std::coroutine_handle< promise_type >::from_promise(*nested.m_parent);
+
+				nested.m_owner->m_handle = {};
+				leaf.destroy();
+				leaf = parent;
+			}
+		}
+
+		m_handle.destroy();
+	}
+};
+
+} // namespace iterators
+
+#endif
+
+#endif // ITERATORS_CORES_GENERATOR_HPP_
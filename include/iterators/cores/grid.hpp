@@ -0,0 +1,273 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_GRID_HPP_
+#define ITERATORS_CORES_GRID_HPP_
+
+#include "iterators/details/bit_operations.hpp"
+#include "iterators/iterator_facade.hpp"
+#include "iterators/range.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+
+namespace iterators {
+
+struct grid_point {
+	std::size_t x = 0;
+	std::size_t y = 0;
+
+	[[nodiscard]] friend auto operator==(const grid_point &lhs, const grid_point &rhs) -> bool {
+		return lhs.x == rhs.x && lhs.y == rhs.y;
+	}
+	[[nodiscard]] friend auto operator!=(const grid_point &lhs, const grid_point &rhs) -> bool {
+		return !(lhs == rhs);
+	}
+};
+
+// A non-owning view of a two-dimensional grid stored in row-major order. Consecutive rows start stride elements apart
+// (which allows viewing a part of a larger grid).
+template< typename T > class grid {
+public:
+	constexpr grid() = default;
+	constexpr grid(T *data, std::size_t width, std::size_t height)
+		: m_data(data), m_width(width), m_height(height), m_stride(width) {}
+	constexpr grid(T *data, std::size_t width, std::size_t height, std::size_t stride)
+		: m_data(data), m_width(width), m_height(height), m_stride(stride) {}
+
+	[[nodiscard]] constexpr auto data() const -> T * { return m_data; }
+	[[nodiscard]] constexpr auto width() const -> std::size_t { return m_width; }
+	[[nodiscard]] constexpr auto height() const -> std::size_t { return m_height; }
+	[[nodiscard]] constexpr auto stride() const -> std::size_t { return m_stride; }
+	[[nodiscard]] constexpr auto size() const -> std::size_t { return m_width * m_height; }
+
+	[[nodiscard]] constexpr auto operator()(std::size_t x, std::size_t y) const -> T & {
+		return m_data[y * m_stride + x];
+	}
+	[[nodiscard]] constexpr auto operator[](grid_point point) const -> T & { return (*this)(point.x, point.y); }
+
+private:
+	T *m_data            = nullptr;
+	std::size_t m_width  = 0;
+	std::size_t m_height = 0;
+	std::size_t m_stride = 0;
+};
+
+// A random access core traversing a grid tile by tile: the grid is partitioned into tiles of a fixed size, which are
+// visited in row-major order, and the cells within a tile are visited in row-major order as well. Tiles at the right
+// and bottom edges are cut off if the grid's dimensions are not multiples of the tile's. Consecutive elements thus stay
+// within a small block of rows, so that e.g. a stencil accessing the neighboring rows of each cell finds them in the
+// cache, as long as a tile's rows (plus the neighbors) fit into it.
+//
+// Incrementing only bumps the coordinates (moving to the next row or tile when necessary), whereas advancing computes
+// the coordinates from the resulting index with a fixed amount of divisions.
+template< typename T > class tiled_grid_core {
+public:
+	using target_iterator_category = std::random_access_iterator_tag;
+	using difference_type          = std::ptrdiff_t;
+
+	tiled_grid_core() = default;
+
+	// Creates a core pointing to the cell with the given index in tile order (index == size yields the end core)
+	tiled_grid_core(const grid< T > &cells, std::size_t tile_width, std::size_t tile_height, std::size_t index = 0)
+		: m_grid(cells), m_tile_width(tile_width), m_tile_height(tile_height) {
+		if (tile_width == 0 || tile_height == 0) {
+			throw std::invalid_argument("Tiles must not be empty");
+		}
+		set_index(index);
+	}
+
+	[[nodiscard]] auto dereference() const -> T & { return *m_element; }
+
+	[[nodiscard]] auto equals(const tiled_grid_core &other) const -> bool { return m_index == other.m_index; }
+
+	void increment() {
+		++m_index;
+		++m_element;
+		if (++m_x < m_tile_right) {
+			return;
+		}
+
+		m_x = m_tile_left;
+		if (++m_y == m_tile_bottom) {
+			// Move on to the next tile
+			m_tile_left += m_tile_width;
+			if (m_tile_left >= m_grid.width()) {
+				m_tile_left = 0;
+				m_tile_top  = m_tile_bottom;
+				if (m_tile_top == m_grid.height()) {
+					m_element = nullptr;
+					return;
+				}
+				m_tile_bottom = std::min(m_tile_top + m_tile_height, m_grid.height());
+			}
+			m_tile_right = std::min(m_tile_left + m_tile_width, m_grid.width());
+			m_x          = m_tile_left;
+			m_y          = m_tile_top;
+		}
+		m_element = &m_grid(m_x, m_y);
+	}
+
+	void decrement() { set_index(m_index - 1); }
+
+	void advance(difference_type amount) {
+		set_index(static_cast< std::size_t >(static_cast< difference_type >(m_index) + amount));
+	}
+
+	[[nodiscard]] auto distance_to(const tiled_grid_core &other) const -> difference_type {
+		return static_cast< difference_type >(other.m_index) - static_cast< difference_type >(m_index);
+	}
+
+	// The position of the current cell in tile order
+	[[nodiscard]] auto index() const -> std::size_t { return m_index; }
+
+	// The coordinates of the current cell (must not be called on the end core)
+	[[nodiscard]] auto coordinates() const -> grid_point { return { m_x, m_y }; }
+
+private:
+	grid< T > m_grid;
+	std::size_t m_tile_width  = 1;
+	std::size_t m_tile_height = 1;
+	std::size_t m_index       = 0;
+	std::size_t m_x           = 0;
+	std::size_t m_y           = 0;
+	// The bounds of the current tile (right and bottom being exclusive)
+	std::size_t m_tile_left   = 0;
+	std::size_t m_tile_top    = 0;
+	std::size_t m_tile_right  = 0;
+	std::size_t m_tile_bottom = 0;
+	T *m_element              = nullptr;
+
+	void set_index(std::size_t index) {
+		m_index = index;
+		if (index >= m_grid.size()) {
+			m_element = nullptr;
+			return;
+		}
+
+		// Every row of tiles but the last one spans m_tile_height full rows
+		const std::size_t tile_row   = index / (m_tile_height * m_grid.width());
+		const std::size_t row_offset = index - tile_row * m_tile_height * m_grid.width();
+		m_tile_top                   = tile_row * m_tile_height;
+		m_tile_bottom                = std::min(m_tile_top + m_tile_height, m_grid.height());
+
+		// Within a row of tiles, every tile but the last one spans m_tile_width full columns
+		const std::size_t rows        = m_tile_bottom - m_tile_top;
+		const std::size_t tile_column = row_offset / (m_tile_width * rows);
+		const std::size_t tile_offset = row_offset - tile_column * m_tile_width * rows;
+		m_tile_left                   = tile_column * m_tile_width;
+		m_tile_right                  = std::min(m_tile_left + m_tile_width, m_grid.width());
+
+		const std::size_t columns = m_tile_right - m_tile_left;
+		m_x                       = m_tile_left + tile_offset % columns;
+		m_y                       = m_tile_top + tile_offset / columns;
+		m_element                 = &m_grid(m_x, m_y);
+	}
+};
+
+// A random access core traversing a grid along the Morton curve (Z-order): the cell with index i is located at the
+// coordinates obtained by splitting the bits of i alternately between x (even bits) and y (odd bits). This visits the
+// grid recursively in quadrants, which keeps cells that are close to each other in two dimensions close in the
+// traversal order as well, independent of the cache size.
+//
+// The grid's width and height must be powers of two (std::invalid_argument is thrown otherwise). If they differ, the
+// excess bits of the index (above twice the smaller dimension's bit count) belong to the larger dimension, i.e. the
+// grid is traversed as a sequence of square Morton-ordered blocks.
+template< typename T > class morton_grid_core {
+public:
+	using target_iterator_category = std::random_access_iterator_tag;
+	using difference_type          = std::ptrdiff_t;
+
+	morton_grid_core() = default;
+
+	// Creates a core pointing to the cell with the given index in Morton order (index == size yields the end core)
+	explicit morton_grid_core(const grid< T > &cells, std::size_t index = 0) : m_grid(cells) {
+		if (!is_power_of_two(cells.width()) || !is_power_of_two(cells.height())) {
+			throw std::invalid_argument("The dimensions of a Morton-ordered grid must be powers of two");
+		}
+
+		const unsigned int width_bits  = details::count_trailing_zeros(cells.width());
+		const unsigned int height_bits = details::count_trailing_zeros(cells.height());
+
+		m_square_bits = 2 * std::min(width_bits, height_bits);
+		m_wide        = width_bits > height_bits;
+		set_index(index);
+	}
+
+	[[nodiscard]] auto dereference() const -> T & { return m_grid(m_x, m_y); }
+
+	[[nodiscard]] auto equals(const morton_grid_core &other) const -> bool { return m_index == other.m_index; }
+
+	void increment() { set_index(m_index + 1); }
+
+	void decrement() { set_index(m_index - 1); }
+
+	void advance(difference_type amount) {
+		set_index(static_cast< std::size_t >(static_cast< difference_type >(m_index) + amount));
+	}
+
+	[[nodiscard]] auto distance_to(const morton_grid_core &other) const -> difference_type {
+		return static_cast< difference_type >(other.m_index) - static_cast< difference_type >(m_index);
+	}
+
+	// The position of the current cell in Morton order
+	[[nodiscard]] auto index() const -> std::size_t { return m_index; }
+
+	// The coordinates of the current cell (must not be called on the end core)
+	[[nodiscard]] auto coordinates() const -> grid_point { return { m_x, m_y }; }
+
+private:
+	grid< T > m_grid;
+	std::size_t m_index        = 0;
+	std::size_t m_x            = 0;
+	std::size_t m_y            = 0;
+	// The amount of index bits that are interleaved
+	unsigned int m_square_bits = 0;
+	// Whether the excess index bits belong to x (rather than y)
+	bool m_wide = false;
+
+	static constexpr auto is_power_of_two(std::size_t value) -> bool {
+		return value != 0 && details::clear_lowest_bit(value) == 0;
+	}
+
+	void set_index(std::size_t index) {
+		m_index = index;
+
+		// As the grid's size fits into a std::size_t, fewer than 64 bits are interleaved
+		const std::uint64_t interleaved = index & ((std::uint64_t(1) << m_square_bits) - 1);
+		const std::size_t excess        = (index >> m_square_bits) << (m_square_bits / 2);
+
+		m_x = static_cast< std::size_t >(details::compact_even_bits(interleaved)) | (m_wide ? excess : 0);
+		m_y = static_cast< std::size_t >(details::compact_even_bits(interleaved >> 1U)) | (m_wide ? 0 : excess);
+	}
+};
+
+template< typename T > using tiled_grid_iterator  = iterator_facade< tiled_grid_core< T > >;
+template< typename T > using morton_grid_iterator = iterator_facade< morton_grid_core< T > >;
+
+// The cells of the given grid in tile order (see tiled_grid_core)
+template< typename T >
+auto tiled(const grid< T > &cells, std::size_t tile_width, std::size_t tile_height) -> range< tiled_grid_core< T > > {
+	return { tiled_grid_core< T >(cells, tile_width, tile_height),
+			 tiled_grid_core< T >(cells, tile_width, tile_height, cells.size()) };
+}
+
+// The cells of the given grid in Morton order (see morton_grid_core)
+template< typename T > auto morton(const grid< T > &cells) -> range< morton_grid_core< T > > {
+	return { morton_grid_core< T >(cells), morton_grid_core< T >(cells, cells.size()) };
+}
+
+// The coordinates of the cell the given grid iterator points to
+template< typename Core >
+auto coordinates(const iterator_facade< Core > &iterator)
+	-> decltype(details::core_access::core(iterator).coordinates()) {
+	return details::core_access::core(iterator).coordinates();
+}
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_GRID_HPP_
@@ -0,0 +1,160 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_IOTA_HPP_
+#define ITERATORS_CORES_IOTA_HPP_
+
+#include "iterators/iterator_facade.hpp"
+#include "iterators/range.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+namespace iterators {
+
+namespace details {
+
+	// All arithmetic of the iota cores is carried out in this unsigned type, which wraps around instead of
+	// overflowing. It is at least as wide as both the integer type and std::ptrdiff_t, so that differences between any
+	// two values (and offsets of any difference_type) are representable modulo 2^N.
+	template< typename Integer >
+	using iota_unsigned_t = std::make_unsigned_t< std::common_type_t< Integer, std::ptrdiff_t > >;
+
+	// The signed difference b - a, computed without signed overflow. It is exact as long as the true difference is
+	// representable in std::ptrdiff_t (which for 64-bit integers excludes ranges spanning more than half their domain).
+	template< typename Integer > constexpr auto iota_difference(Integer a, Integer b) noexcept -> std::ptrdiff_t {
+		using unsigned_type = iota_unsigned_t< Integer >;
+
+		const auto difference = static_cast< unsigned_type >(b) - static_cast< unsigned_type >(a);
+		if (difference <= static_cast< unsigned_type >(std::numeric_limits< std::ptrdiff_t >::max())) {
+			return static_cast< std::ptrdiff_t >(difference);
+		}
+		// Negative differences: negate in the unsigned domain and convert the (then non-negative) magnitude
+		return -static_cast< std::ptrdiff_t >(static_cast< unsigned_type >(-difference) - 1) - 1;
+	}
+
+	// a + offset, wrapping around within the unsigned domain instead of overflowing
+	template< typename Integer >
+	constexpr auto iota_add(Integer a, std::ptrdiff_t offset) noexcept -> Integer {
+		using unsigned_type = iota_unsigned_t< Integer >;
+
+		return static_cast< Integer >(static_cast< unsigned_type >(a) + static_cast< unsigned_type >(offset));
+	}
+
+} // namespace details
+
+// A random access core counting upwards from a given integer. The elements are the integers themselves, so they are
+// computed rather than stored in memory. As the facade requires forward iterators to yield references, the current
+// value is kept inside the core and returned by reference (hence operator[] returns a copy, see stashes_elements).
+//
+// All operations are constexpr and noexcept and boil down to plain integer arithmetic, so that a loop over an iota
+// range compiles to the very same code as a hand-written counting loop: the trip count is known up front (end - begin),
+// which allows the compiler to vectorize the loop. Arithmetic is carried out in an unsigned type, so that neither large
+// unsigned values (beyond the range of difference_type) nor signed ranges near the limits of their type overflow.
+// distance_to is exact whenever the distance is representable as difference_type.
+template< typename Integer > class iota_core {
+public:
+	static_assert(std::is_integral_v< Integer > && !std::is_same_v< Integer, bool >,
+				  "iota_core can only count integers");
+
+	using target_iterator_category = std::random_access_iterator_tag;
+	using difference_type          = std::ptrdiff_t;
+
+	static constexpr bool stashes_elements = true;
+
+	constexpr iota_core() noexcept = default;
+	constexpr iota_core(Integer value) noexcept : m_value(value) {}
+
+	[[nodiscard]] constexpr auto dereference() const noexcept -> const Integer & { return m_value; }
+
+	[[nodiscard]] constexpr auto equals(const iota_core &other) const noexcept -> bool {
+		return m_value == other.m_value;
+	}
+
+	constexpr void increment() noexcept { m_value = details::iota_add(m_value, 1); }
+
+	constexpr void decrement() noexcept { m_value = details::iota_add(m_value, -1); }
+
+	constexpr void advance(difference_type amount) noexcept { m_value = details::iota_add(m_value, amount); }
+
+	[[nodiscard]] constexpr auto distance_to(const iota_core &other) const noexcept -> difference_type {
+		return details::iota_difference(m_value, other.m_value);
+	}
+
+private:
+	Integer m_value = 0;
+};
+
+// A random access core counting from a given integer in steps of a fixed (positive or negative) size. Ranges of this
+// core end at first + count * step (see iota), so that comparing against the end is exact even if the last value of
+// the range would be beyond the upper bound. The step is kept inside the core, so prefer iota_core for a step of 1.
+template< typename Integer > class iota_step_core {
+public:
+	static_assert(std::is_integral_v< Integer > && !std::is_same_v< Integer, bool >,
+				  "iota_step_core can only count integers");
+
+	using target_iterator_category = std::random_access_iterator_tag;
+	using difference_type          = std::ptrdiff_t;
+
+	static constexpr bool stashes_elements = true;
+
+	constexpr iota_step_core() noexcept = default;
+	constexpr iota_step_core(Integer value, difference_type step) noexcept : m_value(value), m_step(step) {}
+
+	[[nodiscard]] constexpr auto dereference() const noexcept -> const Integer & { return m_value; }
+
+	[[nodiscard]] constexpr auto equals(const iota_step_core &other) const noexcept -> bool {
+		return m_value == other.m_value;
+	}
+
+	constexpr void increment() noexcept { m_value = details::iota_add(m_value, m_step); }
+
+	constexpr void decrement() noexcept { m_value = details::iota_add(m_value, -m_step); }
+
+	constexpr void advance(difference_type amount) noexcept { m_value = details::iota_add(m_value, amount * m_step); }
+
+	// Both cores have to be part of the same range, i.e. their values differ by a multiple of the step
+	[[nodiscard]] constexpr auto distance_to(const iota_step_core &other) const noexcept -> difference_type {
+		return details::iota_difference(m_value, other.m_value) / m_step;
+	}
+
+	[[nodiscard]] constexpr auto step() const noexcept -> difference_type { return m_step; }
+
+private:
+	Integer m_value         = 0;
+	difference_type m_step = 1;
+};
+
+template< typename Integer > using iota_iterator      = iterator_facade< iota_core< Integer > >;
+template< typename Integer > using iota_step_iterator = iterator_facade< iota_step_core< Integer > >;
+
+// The integers in [first, last). last must not be smaller than first.
+template< typename Integer >
+constexpr auto iota(Integer first, Integer last) noexcept -> range< iota_core< Integer > > {
+	return { iota_core< Integer >(first), iota_core< Integer >(last) };
+}
+
+// The integers first, first + step, first + 2 * step, ... that lie in [first, last) (or in (last, first] for negative
+// steps). The step must not be zero and the end of the range (the first value beyond last) must be representable as
+// Integer, e.g. iota< std::uint8_t >(0, 250, 100) is not supported as its end would be 300.
+template< typename Integer >
+constexpr auto iota(Integer first, Integer last, std::ptrdiff_t step) noexcept -> range< iota_step_core< Integer > > {
+	const std::ptrdiff_t length = details::iota_difference(first, last);
+	if (length == 0 || (length > 0) != (step > 0)) {
+		return { iota_step_core< Integer >(first, step), iota_step_core< Integer >(first, step) };
+	}
+
+	// The amount of values is rounded up, i.e. the end lies at or beyond last. It is computed as the last value plus
+	// one step, so that intermediate results can't overflow.
+	const std::ptrdiff_t count = 1 + (length > 0 ? length - 1 : length + 1) / step;
+	const Integer end          = details::iota_add(details::iota_add(first, (count - 1) * step), step);
+
+	return { iota_step_core< Integer >(first, step), iota_step_core< Integer >(end, step) };
+}
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_IOTA_HPP_
@@ -0,0 +1,183 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_LENGTH_PREFIXED_RECORDS_HPP_
+#define ITERATORS_CORES_LENGTH_PREFIXED_RECORDS_HPP_
+
+#include "iterators/cores/record_core.hpp"
+#include "iterators/iterator_facade.hpp"
+#include "iterators/range.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if __has_include(<version>)
+#	include <version>
+#endif
+#ifdef __cpp_lib_span
+#	include <span>
+#endif
+
+namespace iterators {
+
+// A non-owning view of a sequence of bytes (std::span< const std::byte > is not available in C++17)
+class byte_view {
+public:
+	constexpr byte_view() = default;
+	constexpr byte_view(const std::byte *data, std::size_t size) : m_data(data), m_size(size) {}
+
+	[[nodiscard]] constexpr auto data() const -> const std::byte * { return m_data; }
+	[[nodiscard]] constexpr auto size() const -> std::size_t { return m_size; }
+	[[nodiscard]] constexpr auto empty() const -> bool { return m_size == 0; }
+
+	[[nodiscard]] constexpr auto begin() const -> const std::byte * { return m_data; }
+	[[nodiscard]] constexpr auto end() const -> const std::byte * { return m_data + m_size; }
+
+	[[nodiscard]] constexpr auto operator[](std::size_t index) const -> const std::byte & { return m_data[index]; }
+
+#ifdef __cpp_lib_span
+	constexpr operator std::span< const std::byte >() const { return { m_data, m_size }; }
+#endif
+
+private:
+	const std::byte *m_data = nullptr;
+	std::size_t m_size      = 0;
+};
+
+// A forward core over variable-size records stored back to back in a buffer, each record being preceded by its length
+// (in bytes, stored as a little-endian Length). Dereferencing yields a view of the current record's bytes inside the
+// buffer, so nothing is copied.
+//
+// Lengths are validated when moving to a record: if the length prefix or the record itself would extend beyond the
+// end of the buffer, a std::out_of_range exception is thrown.
+template< typename Length = std::uint32_t > class length_prefixed_core {
+public:
+	static_assert(std::is_unsigned_v< Length >, "The length prefix must be an unsigned integer");
+
+	using target_iterator_category = std::forward_iterator_tag;
+
+	static constexpr bool stashes_elements = true;
+
+	length_prefixed_core() = default;
+
+	// Creates a core pointing to the record whose length prefix starts at the given offset
+	length_prefixed_core(const std::byte *buffer, std::size_t buffer_size, std::size_t offset)
+		: m_buffer(buffer), m_buffer_size(buffer_size), m_offset(offset) {
+		parse();
+	}
+
+	// The returned reference refers to a member of this core (and thus only lives as long as the core)
+	[[nodiscard]] auto dereference() const -> const byte_view & { return m_record; }
+
+	[[nodiscard]] auto equals(const length_prefixed_core &other) const -> bool { return m_offset == other.m_offset; }
+
+	void increment() {
+		m_offset += sizeof(Length) + m_record.size();
+		parse();
+	}
+
+	// The offset of the current record's length prefix within the buffer
+	[[nodiscard]] auto offset() const -> std::size_t { return m_offset; }
+
+private:
+	const std::byte *m_buffer = nullptr;
+	std::size_t m_buffer_size = 0;
+	std::size_t m_offset      = 0;
+	byte_view m_record;
+
+	void parse() {
+		if (m_offset == m_buffer_size) {
+			m_record = {};
+			return;
+		}
+
+		const std::size_t remaining = m_buffer_size - m_offset;
+		if (remaining < sizeof(Length)) {
+			throw std::out_of_range("Truncated length prefix at offset " + std::to_string(m_offset));
+		}
+
+		// Assembling the length byte by byte is endianness-independent and compiles down to a single load
+		Length length = 0;
+		for (std::size_t byte = 0; byte < sizeof(Length); ++byte) {
+			length |= static_cast< Length >(static_cast< Length >(m_buffer[m_offset + byte]) << (8 * byte));
+		}
+
+		if (length > remaining - sizeof(Length)) {
+			throw std::out_of_range("The record at offset " + std::to_string(m_offset)
+									+ " extends beyond the end of the buffer");
+		}
+
+		m_record = byte_view(m_buffer + m_offset + sizeof(Length), length);
+	}
+};
+
+template< typename Length = std::uint32_t >
+using length_prefixed_iterator = iterator_facade< length_prefixed_core< Length > >;
+
+// The length-prefixed records stored in a buffer (see length_prefixed_core), which is not owned by this object.
+//
+// Iterating over the records is a forward traversal. In order to also allow random access, an index of all records is
+// populated lazily: operator[] parses the buffer only up to the requested record, whereas size() and random_access()
+// index the remaining records as well. The index is not synchronized, so concurrent calls to these functions require
+// external synchronization.
+template< typename Length = std::uint32_t > class length_prefixed_records {
+public:
+	using iterator            = length_prefixed_iterator< Length >;
+	using const_iterator      = iterator;
+	using random_access_range = range< record_core< byte_view > >;
+
+	length_prefixed_records(const std::byte *buffer, std::size_t size) : m_buffer(buffer), m_size(size) {}
+
+	[[nodiscard]] auto begin() const -> iterator { return length_prefixed_core< Length >(m_buffer, m_size, 0); }
+	[[nodiscard]] auto end() const -> iterator { return length_prefixed_core< Length >(m_buffer, m_size, m_size); }
+
+	// Accesses the record with the given index. Throws std::out_of_range if there are not enough records.
+	[[nodiscard]] auto operator[](std::size_t index) const -> byte_view {
+		index_until(index + 1);
+
+		if (index >= m_index.size()) {
+			throw std::out_of_range("There are only " + std::to_string(m_index.size()) + " records");
+		}
+		return m_index[index];
+	}
+
+	// The amount of records
+	[[nodiscard]] auto size() const -> std::size_t {
+		index_until(static_cast< std::size_t >(-1));
+		return m_index.size();
+	}
+
+	[[nodiscard]] auto empty() const -> bool { return m_size == 0; }
+
+	// A random access range over all records. Its iterators remain valid as long as this object exists.
+	[[nodiscard]] auto random_access() const -> random_access_range {
+		index_until(static_cast< std::size_t >(-1));
+		return { record_core< byte_view >(m_index.data()), record_core< byte_view >(m_index.data() + m_index.size()) };
+	}
+
+private:
+	const std::byte *m_buffer;
+	std::size_t m_size;
+	mutable std::vector< byte_view > m_index;
+	// The offset of the first record that has not been indexed yet
+	mutable std::size_t m_indexed_offset = 0;
+
+	void index_until(std::size_t count) const {
+		while (m_index.size() < count && m_indexed_offset < m_size) {
+			const length_prefixed_core< Length > current(m_buffer, m_size, m_indexed_offset);
+
+			m_index.push_back(current.dereference());
+			m_indexed_offset += sizeof(Length) + m_index.back().size();
+		}
+	}
+};
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_LENGTH_PREFIXED_RECORDS_HPP_
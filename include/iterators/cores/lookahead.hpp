@@ -0,0 +1,194 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_LOOKAHEAD_HPP_
+#define ITERATORS_CORES_LOOKAHEAD_HPP_
+
+#include "iterators/core_traits.hpp"
+#include "iterators/iterator_facade.hpp"
+#include "iterators/range.hpp"
+#include "iterators/type_traits.hpp"
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace iterators {
+
+// An input core that buffers the elements of another (typically single-pass) core in a ring buffer of Capacity
+// elements, which makes the upcoming elements available via peek and allows to return to a previously marked position
+// via rewind. Each element is read from the underlying core exactly once.
+//
+// The buffer (the window) holds the elements from the mark (or the current element, if no mark is set) up to the
+// furthest element that has been peeked at. As its capacity is fixed at compile time, the core never allocates. Trying
+// to grow the window beyond Capacity elements (by peeking too far ahead or by moving too far past the mark) throws a
+// std::length_error.
+//
+// As for any input iterator, only the most recently incremented copy of a core may be used for further iteration.
+template< typename Core, std::size_t Capacity > class lookahead_core {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+	using value_type               = typename core_traits< Core >::value_type;
+
+	static_assert(Capacity > 0, "The lookahead buffer must be able to hold at least one element");
+	static_assert(std::is_default_constructible_v< value_type > && std::is_copy_assignable_v< value_type >,
+				  "The buffered elements must be default-constructible and copy-assignable");
+
+	static constexpr std::size_t capacity = Capacity;
+
+	static constexpr bool stashes_elements = true;
+
+	// Creates the past-the-end core
+	lookahead_core() = default;
+
+	lookahead_core(Core begin, Core end) : m_core(std::move(begin)), m_end(std::move(end)) { fill(1); }
+
+	[[nodiscard]] auto dereference() const -> const value_type & { return m_buffer[slot(m_offset)]; }
+
+	// All cores that have reached the end compare equal (including default-constructed ones)
+	[[nodiscard]] auto equals(const lookahead_core &other) const -> bool {
+		if (at_end() || other.at_end()) {
+			return at_end() == other.at_end();
+		}
+		return m_position == other.m_position;
+	}
+
+	void increment() {
+		if (m_marked) {
+			// The window has to hold the next element as well, which might exceed its capacity
+			fill(m_offset + 2);
+			++m_offset;
+		} else {
+			m_first = slot(1);
+			--m_count;
+			fill(1);
+		}
+		++m_position;
+	}
+
+	// The element the given amount of elements ahead of the current one (peek(0) being the current element) or nullptr,
+	// if the input ends before
+	[[nodiscard]] auto peek(std::size_t ahead) -> const value_type * {
+		const std::size_t offset = m_offset + ahead;
+		if (offset >= m_count) {
+			if (offset >= Capacity) {
+				throw_window_exceeded();
+			}
+
+			fill(offset + 1);
+			if (offset >= m_count) {
+				return nullptr;
+			}
+		}
+		return &m_buffer[slot(offset)];
+	}
+
+	// Sets the mark to the current element, so that the elements from here on are retained until the mark is reset
+	void mark() {
+		drop_preceding();
+		m_marked = true;
+	}
+
+	// Returns to the marked element (which must have been set before)
+	void rewind() {
+		m_position -= m_offset;
+		m_offset = 0;
+	}
+
+	// Removes the mark, which releases the elements preceding the current one
+	void reset_mark() {
+		drop_preceding();
+		m_marked = false;
+	}
+
+	// The amount of elements preceding the current one
+	[[nodiscard]] auto position() const -> std::size_t { return m_position; }
+
+private:
+	Core m_core;
+	Core m_end;
+	std::array< value_type, Capacity > m_buffer = {};
+	// The slot holding the first element of the window
+	std::size_t m_first = 0;
+	// The amount of elements in the window
+	std::size_t m_count = 0;
+	// The offset of the current element within the window (non-zero only while a mark is set)
+	std::size_t m_offset   = 0;
+	std::size_t m_position = 0;
+	bool m_marked          = false;
+
+	[[nodiscard]] auto at_end() const -> bool { return m_offset == m_count; }
+
+	[[nodiscard]] auto slot(std::size_t offset) const -> std::size_t { return (m_first + offset) % Capacity; }
+
+	// Reads elements from the underlying core until the window holds the given amount of them (or the input ends)
+	void fill(std::size_t count) {
+		while (m_count < count && !m_core.equals(m_end)) {
+			if (m_count == Capacity) {
+				throw_window_exceeded();
+			}
+
+			m_buffer[slot(m_count)] = m_core.dereference();
+			m_core.increment();
+			++m_count;
+		}
+	}
+
+	[[noreturn]] static void throw_window_exceeded() {
+		throw std::length_error("The lookahead window is limited to " + std::to_string(Capacity) + " elements");
+	}
+
+	void drop_preceding() {
+		m_first = slot(m_offset);
+		m_count -= m_offset;
+		m_offset = 0;
+	}
+};
+
+template< typename Core, std::size_t Capacity >
+using lookahead_iterator = iterator_facade< lookahead_core< Core, Capacity > >;
+
+// Buffers the elements between the given cores (see lookahead_core)
+template< std::size_t Capacity, typename Core, typename = std::enable_if_t< !is_iterator_facade_v< Core > > >
+auto lookahead(Core begin, Core end) -> range< lookahead_core< Core, Capacity > > {
+	return { lookahead_core< Core, Capacity >(std::move(begin), std::move(end)), lookahead_core< Core, Capacity >() };
+}
+
+// Buffers the elements between the given iterators (see lookahead_core)
+template< std::size_t Capacity, typename Core >
+auto lookahead(const iterator_facade< Core > &begin, const iterator_facade< Core > &end)
+	-> range< lookahead_core< Core, Capacity > > {
+	return lookahead< Capacity >(details::core_access::core(begin), details::core_access::core(end));
+}
+
+// The element the given amount of elements ahead of the iterator's current one or nullptr, if there is none (see
+// lookahead_core::peek)
+template< typename Core, std::size_t Capacity >
+auto peek(lookahead_iterator< Core, Capacity > &iterator, std::size_t ahead)
+	-> const typename lookahead_core< Core, Capacity >::value_type * {
+	return details::core_access::core(iterator).peek(ahead);
+}
+
+// Sets the mark to the iterator's current element (see lookahead_core::mark)
+template< typename Core, std::size_t Capacity > void mark(lookahead_iterator< Core, Capacity > &iterator) {
+	details::core_access::core(iterator).mark();
+}
+
+// Returns the iterator to the marked element (see lookahead_core::rewind)
+template< typename Core, std::size_t Capacity > void rewind(lookahead_iterator< Core, Capacity > &iterator) {
+	details::core_access::core(iterator).rewind();
+}
+
+// Removes the iterator's mark (see lookahead_core::reset_mark)
+template< typename Core, std::size_t Capacity > void reset_mark(lookahead_iterator< Core, Capacity > &iterator) {
+	details::core_access::core(iterator).reset_mark();
+}
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_LOOKAHEAD_HPP_
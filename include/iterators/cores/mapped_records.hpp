@@ -0,0 +1,251 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_MAPPED_RECORDS_HPP_
+#define ITERATORS_CORES_MAPPED_RECORDS_HPP_
+
+#include "iterators/cores/record_core.hpp"
+#include "iterators/iterator_facade.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#ifdef _WIN32
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace iterators {
+
+// Hints about how a mapped file is going to be accessed
+enum class access_pattern {
+	normal,
+	// Elements will be accessed in order, so aggressive read-ahead pays off and pages can be dropped early
+	sequential,
+	// Elements will be accessed in no particular order, so read-ahead would only waste I/O bandwidth
+	random,
+	// The whole file will be needed soon, so it should be paged in right away
+	will_need,
+};
+
+// A read-only memory mapping of a whole file
+class mapped_file {
+public:
+	mapped_file() = default;
+
+	explicit mapped_file(const std::string &path) {
+#ifdef _WIN32
+		m_file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+							   FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_file == INVALID_HANDLE_VALUE) {
+			throw last_error("Failed to open " + path);
+		}
+
+		LARGE_INTEGER size;
+		if (!::GetFileSizeEx(m_file, &size)) {
+			const std::system_error error = last_error("Failed to determine the size of " + path);
+			close();
+			throw error;
+		}
+		m_size = static_cast< std::size_t >(size.QuadPart);
+
+		if (m_size > 0) {
+			m_mapping = ::CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (m_mapping == nullptr) {
+				const std::system_error error = last_error("Failed to map " + path);
+				close();
+				throw error;
+			}
+
+			m_data = ::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+			if (m_data == nullptr) {
+				const std::system_error error = last_error("Failed to map " + path);
+				close();
+				throw error;
+			}
+		}
+#else
+		const int descriptor = ::open(path.c_str(), O_RDONLY);
+		if (descriptor < 0) {
+			throw last_error("Failed to open " + path);
+		}
+
+		struct stat status = {};
+		if (::fstat(descriptor, &status) != 0) {
+			const std::system_error error = last_error("Failed to determine the size of " + path);
+			::close(descriptor);
+			throw error;
+		}
+		m_size = static_cast< std::size_t >(status.st_size);
+
+		if (m_size > 0) {
+			void *data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+			if (data == MAP_FAILED) {
+				const std::system_error error = last_error("Failed to map " + path);
+				::close(descriptor);
+				throw error;
+			}
+			m_data = data;
+		}
+
+		// The mapping stays valid after the descriptor has been closed
+		::close(descriptor);
+#endif
+	}
+
+	mapped_file(const mapped_file &) = delete;
+	auto operator=(const mapped_file &) -> mapped_file & = delete;
+
+	mapped_file(mapped_file &&other) noexcept { swap(other); }
+	auto operator=(mapped_file &&other) noexcept -> mapped_file & {
+		mapped_file(std::move(other)).swap(*this);
+		return *this;
+	}
+
+	~mapped_file() { close(); }
+
+	[[nodiscard]] auto data() const -> const std::byte * { return static_cast< const std::byte * >(m_data); }
+	[[nodiscard]] auto size() const -> std::size_t { return m_size; }
+
+	// Passes the given access pattern on to the operating system. This is only a hint and may have no effect.
+	void advise(access_pattern pattern) const {
+#ifdef _WIN32
+		// Windows does not support per-mapping access hints
+		(void) pattern;
+#else
+		if (m_data == nullptr) {
+			return;
+		}
+
+		int advice = MADV_NORMAL;
+		switch (pattern) {
+			case access_pattern::normal:
+				advice = MADV_NORMAL;
+				break;
+			case access_pattern::sequential:
+				advice = MADV_SEQUENTIAL;
+				break;
+			case access_pattern::random:
+				advice = MADV_RANDOM;
+				break;
+			case access_pattern::will_need:
+				advice = MADV_WILLNEED;
+				break;
+		}
+
+		::madvise(m_data, m_size, advice);
+#endif
+	}
+
+	void swap(mapped_file &other) noexcept {
+		std::swap(m_data, other.m_data);
+		std::swap(m_size, other.m_size);
+#ifdef _WIN32
+		std::swap(m_file, other.m_file);
+		std::swap(m_mapping, other.m_mapping);
+#endif
+	}
+
+private:
+	void *m_data       = nullptr;
+	std::size_t m_size = 0;
+#ifdef _WIN32
+	HANDLE m_file    = INVALID_HANDLE_VALUE;
+	HANDLE m_mapping = nullptr;
+#endif
+
+	// Has to be called before cleaning up, as that may overwrite the error code
+	[[nodiscard]] static auto last_error(const std::string &message) -> std::system_error {
+#ifdef _WIN32
+		return std::system_error(static_cast< int >(::GetLastError()), std::system_category(), message);
+#else
+		return std::system_error(errno, std::system_category(), message);
+#endif
+	}
+
+	void close() noexcept {
+#ifdef _WIN32
+		if (m_data != nullptr) {
+			::UnmapViewOfFile(m_data);
+		}
+		if (m_mapping != nullptr) {
+			::CloseHandle(m_mapping);
+		}
+		if (m_file != INVALID_HANDLE_VALUE) {
+			::CloseHandle(m_file);
+		}
+		m_mapping = nullptr;
+		m_file    = INVALID_HANDLE_VALUE;
+#else
+		if (m_data != nullptr) {
+			::munmap(m_data, m_size);
+		}
+#endif
+		m_data = nullptr;
+		m_size = 0;
+	}
+};
+
+
+// A file consisting of fixed-size binary records, exposed as a random access range via a memory mapping. In
+// contrast to reading the file into a container, only the pages that are actually accessed are loaded and no
+// additional copy of the data is made.
+template< typename Record > class mapped_records {
+public:
+	static_assert(std::is_trivially_copyable_v< Record >, "Records must be trivially copyable");
+
+	using value_type     = Record;
+	using iterator       = iterator_facade< record_core< Record > >;
+	using const_iterator = iterator;
+	using size_type      = std::size_t;
+
+	mapped_records() = default;
+
+	explicit mapped_records(const std::string &path, access_pattern pattern = access_pattern::normal)
+		: m_file(path) {
+		if (m_file.size() % sizeof(Record) != 0) {
+			throw std::runtime_error("The size of " + path + " is not a multiple of the record size");
+		}
+
+		// Mappings start at page boundaries, so this only fails for records with extreme alignment requirements
+		if (reinterpret_cast< std::uintptr_t >(m_file.data()) % alignof(Record) != 0) {
+			throw std::runtime_error("The mapping of " + path + " is not suitably aligned for the record type");
+		}
+
+		m_file.advise(pattern);
+	}
+
+	[[nodiscard]] auto begin() const -> iterator { return iterator(data()); }
+	[[nodiscard]] auto end() const -> iterator { return iterator(data() + size()); }
+
+	[[nodiscard]] auto size() const -> size_type { return m_file.size() / sizeof(Record); }
+	[[nodiscard]] auto empty() const -> bool { return size() == 0; }
+
+	[[nodiscard]] auto data() const -> const Record * { return reinterpret_cast< const Record * >(m_file.data()); }
+
+	[[nodiscard]] auto operator[](size_type index) const -> const Record & { return data()[index]; }
+
+	void advise(access_pattern pattern) const { m_file.advise(pattern); }
+
+private:
+	mapped_file m_file;
+};
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_MAPPED_RECORDS_HPP_
@@ -0,0 +1,231 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_MERGE_HPP_
+#define ITERATORS_CORES_MERGE_HPP_
+
+#include "iterators/core_traits.hpp"
+#include "iterators/details/semiregular_box.hpp"
+#include "iterators/iterator_facade.hpp"
+#include "iterators/range.hpp"
+#include "iterators/type_traits.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iterators {
+
+enum class merge_mode {
+	// Yield all elements of all inputs
+	all,
+	// Yield only the first of several equivalent elements (within and across inputs)
+	unique,
+};
+
+namespace details {
+
+	// The current element of one of the inputs of a merge_core. If the input's core yields actual references to
+	// elements outside of itself, only a pointer to the element is stored. Otherwise (including references into
+	// stashing cores, which would dangle once the merge_core is copied), the element itself has to be stored.
+	template< typename Core >
+	constexpr bool merge_element_by_pointer_v =
+		std::is_reference_v< typename core_traits< Core >::reference > && !is_stashing_core< Core >::value;
+
+	template< typename Core, bool = merge_element_by_pointer_v< Core > > class merge_element {
+	public:
+		using reference = typename core_traits< Core >::reference;
+
+		void load(const Core &core) { m_element = std::addressof(core.dereference()); }
+		void clear() { m_element = nullptr; }
+
+		[[nodiscard]] auto empty() const -> bool { return m_element == nullptr; }
+		[[nodiscard]] auto get() const -> reference { return *m_element; }
+
+	private:
+		std::remove_reference_t< reference > *m_element = nullptr;
+	};
+
+	template< typename Core > class merge_element< Core, false > {
+	public:
+		using value_type = typename core_traits< Core >::value_type;
+		using reference  = const value_type &;
+
+		void load(const Core &core) { m_element = core.dereference(); }
+		void clear() { m_element.reset(); }
+
+		[[nodiscard]] auto empty() const -> bool { return !m_element.has_value(); }
+		[[nodiscard]] auto get() const -> reference { return *m_element; }
+
+	private:
+		std::optional< value_type > m_element;
+	};
+
+} // namespace details
+
+// A core merging an arbitrary amount of sorted inputs (each given as a pair of cores of the same type) into a single
+// sorted sequence. Equivalent elements are yielded in the order of the inputs, so the merge is stable.
+//
+// The inputs are arranged in a tournament tree of losers: every inner node stores the input that lost the comparison
+// at that node (along with a pointer to its current element), while the overall winner (the input holding the
+// smallest element) is stored separately. After the winner has been advanced, only the matches on the path from its
+// leaf to the root have to be replayed, which takes exactly ceil(log2(k)) comparisons for k inputs. A binary heap (as
+// used by std::priority_queue) needs up to twice as many comparisons for a pop followed by a push.
+template< typename Core, typename Compare = std::less<>, merge_mode Mode = merge_mode::all > class merge_core {
+public:
+	using target_iterator_category =
+		std::conditional_t< iterator_category::is_at_least_v< typename core_traits< Core >::iterator_category,
+															  std::forward_iterator_tag >,
+							std::forward_iterator_tag, std::input_iterator_tag >;
+
+	static constexpr bool stashes_elements = !details::merge_element_by_pointer_v< Core >;
+
+	// Creates the past-the-end core
+	merge_core() = default;
+
+	explicit merge_core(std::vector< std::pair< Core, Core > > inputs, Compare compare = {})
+		: m_inputs(std::move(inputs)), m_tree(m_inputs.size() + 1), m_compare(std::move(compare)) {
+		if (!m_inputs.empty()) {
+			m_tree[0] = build(1);
+		}
+	}
+
+	[[nodiscard]] auto dereference() const -> typename details::merge_element< Core >::reference {
+		return m_tree[0].element.get();
+	}
+
+	// Two cores are equal if they are both exhausted or if all of their inputs are at the same positions
+	[[nodiscard]] auto equals(const merge_core &other) const -> bool {
+		if (at_end() || other.at_end()) {
+			return at_end() == other.at_end();
+		}
+
+		for (std::size_t i = 0; i < m_inputs.size(); ++i) {
+			if (!m_inputs[i].first.equals(other.m_inputs[i].first)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void increment() {
+		if constexpr (Mode == merge_mode::unique) {
+			const typename core_traits< Core >::value_type previous = dereference();
+
+			do {
+				advance_winner();
+			} while (!at_end() && !m_compare(previous, dereference()));
+		} else {
+			advance_winner();
+		}
+	}
+
+private:
+	struct node {
+		std::size_t input = 0;
+		// The input's current element (empty if the input is exhausted)
+		details::merge_element< Core > element;
+	};
+
+	std::vector< std::pair< Core, Core > > m_inputs;
+	// m_tree[0] holds the winning input and m_tree[1..k-1] the losers of the inner nodes. The leaf of input i is the
+	// (implicit) node k + i, so that the parent of any node n is n / 2.
+	std::vector< node > m_tree;
+	details::semiregular_box< Compare > m_compare;
+
+	[[nodiscard]] auto at_end() const -> bool { return m_inputs.empty() || m_tree[0].element.empty(); }
+
+	[[nodiscard]] auto leaf(std::size_t input) const -> node {
+		node leaf;
+		leaf.input = input;
+		if (!m_inputs[input].first.equals(m_inputs[input].second)) {
+			leaf.element.load(m_inputs[input].first);
+		}
+		return leaf;
+	}
+
+	// Whether the given node's element has to be yielded before the other's. Exhausted inputs lose against all others
+	// and ties are broken by the index of the input in order to keep the merge stable.
+	[[nodiscard]] auto wins(const node &lhs, const node &rhs) const -> bool {
+		if (lhs.element.empty()) {
+			return false;
+		}
+		if (rhs.element.empty()) {
+			return true;
+		}
+
+		if (m_compare(lhs.element.get(), rhs.element.get())) {
+			return true;
+		}
+		return lhs.input < rhs.input && !m_compare(rhs.element.get(), lhs.element.get());
+	}
+
+	// Plays all matches of the subtree rooted at the given node and returns the subtree's winner
+	auto build(std::size_t index) -> node {
+		const std::size_t leaf_count = m_inputs.size();
+		if (index >= leaf_count) {
+			return leaf(index - leaf_count);
+		}
+
+		node left  = build(2 * index);
+		node right = build(2 * index + 1);
+
+		if (wins(left, right)) {
+			m_tree[index] = std::move(right);
+			return left;
+		}
+		m_tree[index] = std::move(left);
+		return right;
+	}
+
+	void advance_winner() {
+		const std::size_t input = m_tree[0].input;
+		m_inputs[input].first.increment();
+
+		node winner = leaf(input);
+		for (std::size_t index = (input + m_inputs.size()) / 2; index > 0; index /= 2) {
+			if (wins(m_tree[index], winner)) {
+				std::swap(m_tree[index], winner);
+			}
+		}
+
+		m_tree[0] = std::move(winner);
+	}
+};
+
+template< typename Core, typename Compare = std::less<>, merge_mode Mode = merge_mode::all >
+using merge_iterator = iterator_facade< merge_core< Core, Compare, Mode > >;
+
+namespace details {
+
+	// The core type of the iterators of the ranges contained in Ranges
+	template< typename Ranges >
+	using input_core_t =
+		typename std::decay_t< decltype(std::begin(*std::begin(std::declval< const Ranges & >()))) >::core_type;
+
+} // namespace details
+
+// Merges the given sorted ranges, whose iterators must be of type iterator_facade< Core >
+template< merge_mode Mode = merge_mode::all, typename Ranges, typename Compare = std::less<> >
+auto merge(const Ranges &inputs, Compare compare = {})
+	-> range< merge_core< details::input_core_t< Ranges >, Compare, Mode > > {
+	using core_type = details::input_core_t< Ranges >;
+
+	std::vector< std::pair< core_type, core_type > > cores;
+	for (const auto &input : inputs) {
+		cores.emplace_back(details::core_access::core(std::begin(input)), details::core_access::core(std::end(input)));
+	}
+
+	return { merge_core< core_type, Compare, Mode >(std::move(cores), std::move(compare)),
+			 merge_core< core_type, Compare, Mode >() };
+}
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_MERGE_HPP_
@@ -0,0 +1,176 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_OCCUPIED_SLOTS_HPP_
+#define ITERATORS_CORES_OCCUPIED_SLOTS_HPP_
+
+#include "iterators/details/bit_operations.hpp"
+#include "iterators/iterator_facade.hpp"
+#include "iterators/range.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+#if defined(__AVX2__)
+#	include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define ITERATORS_OCCUPIED_SLOTS_SSE2
+#endif
+
+namespace iterators {
+
+namespace details {
+
+	// Scans the control bytes of an open-addressing hash table one group at a time. A slot is considered occupied if
+	// the most significant bit of its control byte is clear (the SwissTable convention: full slots store 7 bits of
+	// their hash, whereas the special markers for empty and deleted slots are negative).
+	struct control_group {
+#if defined(__AVX2__)
+		static constexpr std::size_t width = 32;
+
+		static auto occupied(const std::int8_t *control) -> std::uint64_t {
+			const __m256i bytes = _mm256_loadu_si256(reinterpret_cast< const __m256i * >(control));
+			return ~static_cast< std::uint64_t >(static_cast< std::uint32_t >(_mm256_movemask_epi8(bytes)))
+				   & 0xFFFFFFFFU;
+		}
+#elif defined(ITERATORS_OCCUPIED_SLOTS_SSE2)
+		static constexpr std::size_t width = 16;
+
+		static auto occupied(const std::int8_t *control) -> std::uint64_t {
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast< const __m128i * >(control));
+			return ~static_cast< std::uint64_t >(_mm_movemask_epi8(bytes)) & 0xFFFFU;
+		}
+#else
+		static constexpr std::size_t width = 8;
+
+		// Portable fallback processing 8 control bytes per step (SWAR). The inverted most significant bit of every
+		// byte is gathered into the lowest byte via a multiplication (the bits don't overlap, so no carries occur),
+		// which yields the same one-bit-per-slot mask as movemask does (on little-endian targets).
+		static auto occupied(const std::int8_t *control) -> std::uint64_t {
+			std::uint64_t bytes = 0;
+			std::memcpy(&bytes, control, sizeof(bytes));
+
+			const std::uint64_t high_bits = (~bytes & 0x8080808080808080ULL) >> 7U;
+			return (high_bits * 0x0102040810204080ULL) >> 56U;
+		}
+#endif
+
+		// Loads a group that extends beyond the end of the control bytes. The missing bytes are treated as empty.
+		static auto occupied_partial(const std::int8_t *control, std::size_t count) -> std::uint64_t {
+			std::int8_t padded[width];
+			std::memset(padded, 0x80, width);
+			std::memcpy(padded, control, count);
+
+			return occupied(padded);
+		}
+	};
+
+} // namespace details
+
+#undef ITERATORS_OCCUPIED_SLOTS_SSE2
+
+// A forward core over the occupied slots of an open-addressing hash table that stores its control bytes separately
+// from its slots (as e.g. SwissTable does). Rather than checking one control byte per increment, the control bytes
+// are scanned a whole group at a time (32 slots with AVX2, 16 with SSE2 and 8 otherwise) and the occupied slots of a
+// group are then visited via the resulting bit mask.
+template< typename Slot > class occupied_slots_core {
+public:
+	using target_iterator_category = std::forward_iterator_tag;
+
+	static constexpr std::size_t group_width = details::control_group::width;
+
+	occupied_slots_core() = default;
+
+	// Creates a core pointing to the first occupied slot
+	occupied_slots_core(const std::int8_t *control, Slot *slots, std::size_t slot_count)
+		: m_control(control), m_slots(slots), m_slot_count(slot_count) {
+		if (slot_count > 0) {
+			load_group();
+		}
+		skip_empty_groups();
+	}
+
+	// Creates the past-the-end core
+	static auto end(const std::int8_t *control, Slot *slots, std::size_t slot_count) -> occupied_slots_core {
+		occupied_slots_core core;
+		core.m_control    = control;
+		core.m_slots      = slots;
+		core.m_slot_count = slot_count;
+		core.m_group      = slot_count;
+		core.m_position   = slot_count;
+		return core;
+	}
+
+	[[nodiscard]] auto dereference() const -> Slot & { return m_slots[m_position]; }
+
+	[[nodiscard]] auto equals(const occupied_slots_core &other) const -> bool {
+		return m_position == other.m_position;
+	}
+
+	void increment() {
+		m_mask = details::clear_lowest_bit(m_mask);
+		skip_empty_groups();
+	}
+
+	// The index of the current slot
+	[[nodiscard]] auto index() const -> std::size_t { return m_position; }
+
+private:
+	const std::int8_t *m_control = nullptr;
+	Slot *m_slots                = nullptr;
+	std::size_t m_slot_count     = 0;
+	// Index of the first slot in the current group
+	std::size_t m_group = 0;
+	// The occupied slots of the current group that have not been visited yet
+	std::uint64_t m_mask   = 0;
+	std::size_t m_position = 0;
+
+	void load_group() {
+		const std::size_t remaining = m_slot_count - m_group;
+
+		if (remaining >= group_width) {
+			m_mask = details::control_group::occupied(m_control + m_group);
+		} else {
+			m_mask = details::control_group::occupied_partial(m_control + m_group, remaining);
+		}
+	}
+
+	void skip_empty_groups() {
+		while (m_mask == 0) {
+			m_group += group_width;
+
+			if (m_group >= m_slot_count) {
+				m_group    = m_slot_count;
+				m_position = m_slot_count;
+				return;
+			}
+
+			load_group();
+		}
+
+		m_position = m_group + details::count_trailing_zeros(m_mask);
+	}
+};
+
+template< typename Slot > using occupied_slots_iterator = iterator_facade< occupied_slots_core< Slot > >;
+
+// The range of all occupied slots
+template< typename Slot >
+auto occupied_slots(const std::int8_t *control, Slot *slots, std::size_t slot_count)
+	-> range< occupied_slots_core< Slot > > {
+	return { occupied_slots_core< Slot >(control, slots, slot_count),
+			 occupied_slots_core< Slot >::end(control, slots, slot_count) };
+}
+
+// The index of the slot the given iterator points to (the slot count for the past-the-end iterator)
+template< typename Slot > auto index(const occupied_slots_iterator< Slot > &iterator) -> std::size_t {
+	return details::core_access::core(iterator).index();
+}
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_OCCUPIED_SLOTS_HPP_
@@ -0,0 +1,239 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_PERMUTATION_HPP_
+#define ITERATORS_CORES_PERMUTATION_HPP_
+
+#include "iterators/core_traits.hpp"
+#include "iterators/details/prefetch.hpp"
+#include "iterators/iterator_facade.hpp"
+#include "iterators/range.hpp"
+#include "iterators/type_traits.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#ifdef __AVX2__
+#	include <immintrin.h>
+#endif
+
+namespace iterators {
+
+// A core yielding the elements of a random access value core in the order given by an index core, i.e. values[i0],
+// values[i1], ... where i0, i1, ... are the elements of the index core. The iterator category is the one of the index
+// core.
+//
+// Sparse workloads access the values at effectively random positions, so every element is a potential cache miss
+// stalling the loop. The core therefore prefetches the value Distance positions ahead of the current one while
+// incrementing, so that the memory accesses of the following elements overlap with the current iteration. For that, it
+// keeps a second index core running ahead of the current one (plus the end of the indices, in order to not read past
+// them). Moving backwards or jumping resets the look-ahead, which is then rebuilt by the following increment. A
+// Distance of 0 disables prefetching, as do single-pass index cores, whose copies can't run ahead without consuming the
+// indices for all of them.
+template< typename ValueCore, typename IndexCore, std::size_t Distance = 8 > class permutation_core {
+public:
+	static_assert(iterator_category::is_at_least_v< typename core_traits< ValueCore >::iterator_category,
+													std::random_access_iterator_tag >,
+				  "The values of a permutation must be random access");
+	static_assert(!details::is_stashing_core< ValueCore >::value,
+				  "The values of a permutation must not be stored inside the value core");
+
+	using target_iterator_category = typename core_traits< IndexCore >::iterator_category;
+	using difference_type          = typename core_traits< IndexCore >::difference_type;
+
+	static constexpr std::size_t prefetch_distance =
+		iterator_category::is_at_least_v< typename core_traits< IndexCore >::iterator_category,
+										  std::forward_iterator_tag >
+			? Distance
+			: 0;
+
+	permutation_core() = default;
+
+	// Creates a core pointing to the value at the index index refers to. end is the end of the indices.
+	permutation_core(ValueCore values, IndexCore index, IndexCore end)
+		: m_values(std::move(values)), m_index(std::move(index)), m_ahead(m_index), m_end(std::move(end)) {
+		prefetch_ahead();
+	}
+
+	[[nodiscard]] auto dereference() const -> typename core_traits< ValueCore >::reference {
+		return value_at(m_index.dereference());
+	}
+
+	[[nodiscard]] auto equals(const permutation_core &other) const -> bool { return m_index.equals(other.m_index); }
+
+	void increment() {
+		m_index.increment();
+
+		if constexpr (prefetch_distance > 0) {
+			if (m_lead > 0) {
+				--m_lead;
+			} else {
+				m_ahead = m_index;
+			}
+			prefetch_ahead();
+		}
+	}
+
+	template< typename C = IndexCore, typename = std::enable_if_t< member_functions::has_decrement_v< C > > >
+	void decrement() {
+		m_index.decrement();
+		reset_ahead();
+	}
+
+	template< typename C = IndexCore, typename = std::enable_if_t< member_functions::has_advance_v< C > > >
+	void advance(difference_type amount) {
+		m_index.advance(amount);
+		reset_ahead();
+	}
+
+	template< typename C = IndexCore, typename = std::enable_if_t< member_functions::has_distance_to_v< C > > >
+	[[nodiscard]] auto distance_to(const permutation_core &other) const -> difference_type {
+		return m_index.distance_to(other.m_index);
+	}
+
+	// The current position in the indices
+	[[nodiscard]] auto base() const -> const IndexCore & { return m_index; }
+
+private:
+	ValueCore m_values;
+	IndexCore m_index;
+	// The position of the last prefetched value, which is m_lead positions ahead of m_index
+	IndexCore m_ahead;
+	IndexCore m_end;
+	std::size_t m_lead = 0;
+
+	template< typename Index > [[nodiscard]] auto value_at(const Index &index) const -> decltype(auto) {
+		ValueCore value = m_values;
+		value.advance(static_cast< typename core_traits< ValueCore >::difference_type >(index));
+		return value.dereference();
+	}
+
+	void prefetch_ahead() {
+		if constexpr (prefetch_distance > 0) {
+			while (m_lead < prefetch_distance && !m_ahead.equals(m_end)) {
+				m_ahead.increment();
+				++m_lead;
+
+				if (!m_ahead.equals(m_end)) {
+					details::prefetch(std::addressof(value_at(m_ahead.dereference())));
+				}
+			}
+		}
+	}
+
+	void reset_ahead() {
+		m_ahead = m_index;
+		m_lead  = 0;
+	}
+};
+
+template< typename ValueCore, typename IndexCore, std::size_t Distance = 8 >
+using permutation_iterator = iterator_facade< permutation_core< ValueCore, IndexCore, Distance > >;
+
+// The values at the indices between first and last
+template< std::size_t Distance = 8, typename ValueCore, typename IndexCore,
+		  typename = std::enable_if_t< !is_iterator_facade_v< ValueCore > && !is_iterator_facade_v< IndexCore > > >
+auto permuted(ValueCore values, IndexCore first, IndexCore last)
+	-> range< permutation_core< ValueCore, IndexCore, Distance > > {
+	return { permutation_core< ValueCore, IndexCore, Distance >(values, std::move(first), last),
+			 permutation_core< ValueCore, IndexCore, Distance >(values, last, last) };
+}
+
+// The values (starting at values) at the indices in [first, last)
+template< std::size_t Distance = 8, typename ValueCore, typename IndexCore >
+auto permuted(const iterator_facade< ValueCore > &values, const iterator_facade< IndexCore > &first,
+			  const iterator_facade< IndexCore > &last) -> range< permutation_core< ValueCore, IndexCore, Distance > > {
+	return ::iterators::permuted< Distance >(details::core_access::core(values), details::core_access::core(first),
+											 details::core_access::core(last));
+}
+
+namespace details {
+
+	template< typename T, typename Index, typename OutputIterator >
+	constexpr bool uses_avx2_gather_v =
+#ifdef __AVX2__
+		std::is_same_v< Index, std::int32_t > && std::is_same_v< OutputIterator, T * >
+		&& (std::is_same_v< T, float > || std::is_same_v< T, double > || std::is_same_v< T, std::int32_t >
+			|| std::is_same_v< T, std::uint32_t > || std::is_same_v< T, std::int64_t >
+			|| std::is_same_v< T, std::uint64_t >);
+#else
+		false;
+#endif
+
+} // namespace details
+
+// Bulk version of iterating over a permutation: writes values[index] for every index in [first, last) to the output
+// and returns the end of the written sequence.
+//
+// If AVX2 is enabled at compile time, 32-bit signed indices into arrays of 32- or 64-bit arithmetic values are
+// gathered by the hardware gather instructions, several values at a time (writing to a pointer of the value type).
+// All other combinations use a scalar loop. Both prefetch the values PrefetchDistance indices ahead.
+template< std::size_t PrefetchDistance = 16, typename T, typename Index, typename OutputIterator >
+auto gather(const T *values, const Index *first, const Index *last, OutputIterator output) -> OutputIterator {
+	const auto count = static_cast< std::size_t >(last - first);
+	std::size_t i    = 0;
+
+#ifdef __AVX2__
+	if constexpr (details::uses_avx2_gather_v< T, Index, OutputIterator >) {
+		constexpr std::size_t lanes = 32 / sizeof(T);
+
+		for (; i + lanes <= count; i += lanes) {
+			if (i + PrefetchDistance + lanes <= count) {
+				for (std::size_t lane = 0; lane < lanes; ++lane) {
+					details::prefetch(values + first[i + PrefetchDistance + lane]);
+				}
+			}
+
+			// The unmasked gathers start from an undefined source register, which GCC reports as maybe uninitialized.
+			// The masked ones with a zeroed source and all lanes enabled compile to the same instruction.
+			if constexpr (sizeof(T) == 4) {
+				const __m256i indices = _mm256_loadu_si256(reinterpret_cast< const __m256i * >(first + i));
+				const __m256i all     = _mm256_set1_epi32(-1);
+				if constexpr (std::is_same_v< T, float >) {
+					_mm256_storeu_ps(output + i, _mm256_mask_i32gather_ps(_mm256_setzero_ps(), values, indices,
+																		  _mm256_castsi256_ps(all), 4));
+				} else {
+					_mm256_storeu_si256(reinterpret_cast< __m256i * >(output + i),
+										_mm256_mask_i32gather_epi32(_mm256_setzero_si256(),
+																	reinterpret_cast< const int * >(values), indices,
+																	all, 4));
+				}
+			} else {
+				const __m128i indices = _mm_loadu_si128(reinterpret_cast< const __m128i * >(first + i));
+				const __m256i all     = _mm256_set1_epi64x(-1);
+				if constexpr (std::is_same_v< T, double >) {
+					_mm256_storeu_pd(output + i, _mm256_mask_i32gather_pd(_mm256_setzero_pd(), values, indices,
+																		  _mm256_castsi256_pd(all), 8));
+				} else {
+					_mm256_storeu_si256(reinterpret_cast< __m256i * >(output + i),
+										_mm256_mask_i32gather_epi64(_mm256_setzero_si256(),
+																	reinterpret_cast< const long long * >(values),
+																	indices, all, 8));
+				}
+			}
+		}
+
+		output += i;
+	}
+#endif
+
+	for (; i < count; ++i) {
+		if (i + PrefetchDistance < count) {
+			details::prefetch(values + first[i + PrefetchDistance]);
+		}
+
+		*output = values[first[i]];
+		++output;
+	}
+
+	return output;
+}
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_PERMUTATION_HPP_
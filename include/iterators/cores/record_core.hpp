@@ -0,0 +1,37 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_RECORD_CORE_HPP_
+#define ITERATORS_CORES_RECORD_CORE_HPP_
+
+#include <cstddef>
+#include <iterator>
+
+namespace iterators {
+
+// A random access core over fixed-size records stored contiguously in memory. Records are never copied:
+// dereferencing yields a reference into the underlying memory.
+template< typename Record > class record_core {
+public:
+	using target_iterator_category = std::random_access_iterator_tag;
+
+	record_core() = default;
+	record_core(const Record *record) : m_record(record) {}
+
+	[[nodiscard]] auto dereference() const -> const Record & { return *m_record; }
+	[[nodiscard]] auto equals(const record_core &other) const -> bool { return m_record == other.m_record; }
+	void increment() { ++m_record; }
+	void decrement() { --m_record; }
+	[[nodiscard]] auto distance_to(const record_core &other) const -> std::ptrdiff_t {
+		return other.m_record - m_record;
+	}
+	void advance(std::ptrdiff_t amount) { m_record += amount; }
+
+private:
+	const Record *m_record = nullptr;
+};
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_RECORD_CORE_HPP_
@@ -0,0 +1,153 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_REVERSE_HPP_
+#define ITERATORS_CORES_REVERSE_HPP_
+
+#include "iterators/core_traits.hpp"
+#include "iterators/iterator_facade.hpp"
+#include "iterators/range.hpp"
+#include "iterators/type_traits.hpp"
+
+#include <cassert>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace iterators {
+
+// A core traversing the elements of another (at least bidirectional) core in reverse order. Random access is retained
+// if the underlying core provides it (advance and distance_to are translated accordingly).
+//
+// In contrast to std::reverse_iterator, which refers to the element preceding the one its underlying iterator points
+// to and therefore has to copy and decrement the underlying iterator on every dereference, the underlying core is
+// kept on the current element itself. Since there is no element preceding the first one, the past-the-end position of
+// the reversed sequence is represented by the first element plus a flag. This requires storing the first position as
+// well, which the increment compares against before moving backwards.
+template< typename Core > class reverse_core {
+public:
+	static_assert(iterator_category::is_at_least_v< typename core_traits< Core >::iterator_category,
+													std::bidirectional_iterator_tag >,
+				  "Only bidirectional cores can be reversed");
+
+	using target_iterator_category = typename core_traits< Core >::iterator_category;
+	using difference_type          = typename core_traits< Core >::difference_type;
+
+	static constexpr bool stashes_elements = details::is_stashing_core< Core >::value;
+
+	reverse_core() = default;
+
+	// Creates a core pointing to the last element in [first, last) (or the past-the-end core if the range is empty)
+	reverse_core(Core first, Core last) : m_current(std::move(last)), m_first(std::move(first)) {
+		if (m_current.equals(m_first)) {
+			m_done = true;
+		} else {
+			m_current.decrement();
+		}
+	}
+
+	// Creates the past-the-end core of the reversal of a range starting at first
+	static auto end(Core first) -> reverse_core {
+		reverse_core core;
+		core.m_current = first;
+		core.m_first   = std::move(first);
+		core.m_done    = true;
+		return core;
+	}
+
+	[[nodiscard]] auto dereference() const -> typename core_traits< Core >::reference {
+		return m_current.dereference();
+	}
+
+	[[nodiscard]] auto equals(const reverse_core &other) const -> bool {
+		return m_done == other.m_done && (m_done || m_current.equals(other.m_current));
+	}
+
+	void increment() {
+		if (m_current.equals(m_first)) {
+			m_done = true;
+		} else {
+			m_current.decrement();
+		}
+	}
+
+	void decrement() {
+		if (m_done) {
+			m_done = false;
+		} else {
+			m_current.increment();
+		}
+	}
+
+	template< typename C = Core, typename = std::enable_if_t< member_functions::has_distance_to_v< C > > >
+	[[nodiscard]] auto distance_to(const reverse_core &other) const -> difference_type {
+		if (!m_done && !other.m_done) {
+			return other.m_current.distance_to(m_current);
+		}
+		return static_cast< difference_type >(index() - other.index());
+	}
+
+	template< typename C = Core, typename = std::enable_if_t< member_functions::has_distance_to_v< C >
+															  && member_functions::has_advance_v< C > > >
+	void advance(difference_type amount) {
+		if (amount > 0) {
+			const difference_type index = m_first.distance_to(m_current);
+
+			if (amount > index) {
+				assert(amount == index + 1 && "Advanced beyond the end of the reversed sequence");
+
+				m_current = m_first;
+				m_done    = true;
+				return;
+			}
+		} else if (amount < 0 && m_done) {
+			m_done = false;
+			++amount;
+		}
+
+		m_current.advance(static_cast< difference_type >(-amount));
+	}
+
+	// The underlying core pointing behind the current element (in the original order), i.e. to the element that
+	// std::reverse_iterator::base() would point to
+	[[nodiscard]] auto base() const -> Core {
+		if (m_done) {
+			return m_first;
+		}
+
+		Core base = m_current;
+		base.increment();
+		return base;
+	}
+
+private:
+	Core m_current;
+	Core m_first;
+	bool m_done = false;
+
+	// The index of the current element in the original sequence (-1 for the past-the-end position)
+	[[nodiscard]] auto index() const -> difference_type {
+		return m_done ? difference_type(-1) : m_first.distance_to(m_current);
+	}
+};
+
+template< typename Core > using reverse_iterator = iterator_facade< reverse_core< Core > >;
+
+// The elements in [first, last) in reverse order
+template< typename Core >
+auto reversed(const iterator_facade< Core > &first, const iterator_facade< Core > &last)
+	-> range< reverse_core< Core > > {
+	return { reverse_core< Core >(details::core_access::core(first), details::core_access::core(last)),
+			 reverse_core< Core >::end(details::core_access::core(first)) };
+}
+
+// The elements of the given range (whose iterators must be of type iterator_facade< Core >) in reverse order
+template< typename Range >
+auto reversed(const Range &range) -> decltype(::iterators::reversed(std::begin(range), std::end(range))) {
+	return ::iterators::reversed(std::begin(range), std::end(range));
+}
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_REVERSE_HPP_
@@ -0,0 +1,109 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_SET_BITS_HPP_
+#define ITERATORS_CORES_SET_BITS_HPP_
+
+#include "iterators/details/bit_operations.hpp"
+#include "iterators/iterator_facade.hpp"
+#include "iterators/range.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace iterators {
+
+// A forward core yielding the positions of all set bits in a contiguous array of 64-bit words (bit i of word w has
+// position 64 * w + i). Instead of testing one bit at a time, the core jumps straight to the next set bit via
+// count-trailing-zeros and skips words without any set bits entirely.
+class set_bits_core {
+public:
+	using target_iterator_category = std::forward_iterator_tag;
+
+	static constexpr std::size_t bits_per_word = 64;
+
+	static constexpr bool stashes_elements = true;
+
+	set_bits_core() = default;
+
+	// Creates a core pointing to the first set bit in the given words
+	set_bits_core(const std::uint64_t *words, std::size_t word_count)
+		: m_words(words), m_word_count(word_count), m_bits(word_count > 0 ? words[0] : 0) {
+		skip_empty_words();
+	}
+
+	// Creates the past-the-end core for the given words
+	static auto end(const std::uint64_t *words, std::size_t word_count) -> set_bits_core {
+		set_bits_core core;
+		core.m_words      = words;
+		core.m_word_count = word_count;
+		core.m_word       = word_count;
+		core.m_position   = word_count * bits_per_word;
+		return core;
+	}
+
+	// The returned reference refers to a member of this core (and thus only lives as long as the core)
+	[[nodiscard]] auto dereference() const -> const std::size_t & { return m_position; }
+
+	[[nodiscard]] auto equals(const set_bits_core &other) const -> bool { return m_position == other.m_position; }
+
+	void increment() {
+		m_bits = details::clear_lowest_bit(m_bits);
+		skip_empty_words();
+	}
+
+private:
+	const std::uint64_t *m_words = nullptr;
+	std::size_t m_word_count     = 0;
+	std::size_t m_word           = 0;
+	// The bits of the current word that have not been visited yet
+	std::uint64_t m_bits    = 0;
+	std::size_t m_position = 0;
+
+	void skip_empty_words() {
+		while (m_bits == 0) {
+			if (++m_word >= m_word_count) {
+				m_word     = m_word_count;
+				m_position = m_word_count * bits_per_word;
+				return;
+			}
+
+			m_bits = m_words[m_word];
+		}
+
+		m_position = m_word * bits_per_word + details::count_trailing_zeros(m_bits);
+	}
+};
+
+using set_bits_iterator = iterator_facade< set_bits_core >;
+
+// The range of the positions of all set bits in the given words
+inline auto set_bits(const std::uint64_t *words, std::size_t word_count) -> range< set_bits_core > {
+	return { set_bits_core(words, word_count), set_bits_core::end(words, word_count) };
+}
+
+// Bulk version of iterating over set_bits(words, word_count): writes the positions of all set bits into the output
+// and returns the end of the written sequence. The output must have room for as many positions as there are set
+// bits. Decoding whole words at once avoids the per-element overhead of the iterator interface and lets the compiler
+// pipeline the bit scans.
+template< typename OutputIterator >
+auto decode_set_bits(const std::uint64_t *words, std::size_t word_count, OutputIterator output) -> OutputIterator {
+	for (std::size_t word = 0; word < word_count; ++word) {
+		std::uint64_t bits     = words[word];
+		const std::size_t base = word * set_bits_core::bits_per_word;
+
+		while (bits != 0) {
+			*output = base + details::count_trailing_zeros(bits);
+			++output;
+			bits = details::clear_lowest_bit(bits);
+		}
+	}
+
+	return output;
+}
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_SET_BITS_HPP_
@@ -0,0 +1,184 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_CORES_TRANSFORM_HPP_
+#define ITERATORS_CORES_TRANSFORM_HPP_
+
+#include "iterators/core_traits.hpp"
+#include "iterators/details/cache_box.hpp"
+#include "iterators/details/semiregular_box.hpp"
+#include "iterators/iterator_facade.hpp"
+#include "iterators/range.hpp"
+#include "iterators/type_traits.hpp"
+
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace iterators {
+
+namespace details {
+
+	template< typename Core, typename Function >
+	using transform_result_t = std::invoke_result_t< const Function &, typename core_traits< Core >::reference >;
+
+	// Results have to be cached if the function computes values but the iterator category demands references
+	template< typename Core, typename Function >
+	constexpr bool transform_caches_results_v =
+		!std::is_reference_v< transform_result_t< Core, Function > >
+		&& iterator_category::is_at_least_v< typename core_traits< Core >::iterator_category,
+											 std::forward_iterator_tag >;
+
+} // namespace details
+
+// A core applying a function to every element of the underlying core, which keeps the underlying core's iterator
+// category. Depending on what the function returns, the elements are provided as follows:
+//  - References (e.g. a projection onto a member) are passed on as they are.
+//  - Values are returned as they are by input iterators, which may yield proxies.
+//  - Values are computed at most once per position and cached inside the core for all stronger categories, which
+//    have to yield references (see also cached_core). The references refer to the cache and are thus invalidated once
+//    the core is moved or destroyed. For random access, operator[] returns a copy of the element for that reason.
+//
+// Thus e.g. std::lower_bound can search through projected keys without materializing them in a separate array, and
+// calls the function only once per probed element. All operations are constexpr and propagate the noexcept-ness of the
+// function and the underlying core.
+template< typename Core, typename Function, bool = details::transform_caches_results_v< Core, Function > >
+class transform_core {
+public:
+	using target_iterator_category = typename core_traits< Core >::iterator_category;
+	using difference_type          = typename core_traits< Core >::difference_type;
+	using result_type              = details::transform_result_t< Core, Function >;
+
+	// Projections of elements stashed inside the underlying core refer into this core as well
+	static constexpr bool stashes_elements =
+		std::is_reference_v< result_type > && details::is_stashing_core< Core >::value;
+
+	constexpr transform_core() = default;
+	constexpr transform_core(Core core, Function function) : m_core(std::move(core)), m_function(std::move(function)) {}
+
+	[[nodiscard]] constexpr auto dereference() const
+		noexcept(std::is_nothrow_invocable_v< const Function &, typename core_traits< Core >::reference >
+				 && noexcept(std::declval< const Core & >().dereference())) -> result_type {
+		return m_function(m_core.dereference());
+	}
+
+	[[nodiscard]] constexpr auto equals(const transform_core &other) const
+		noexcept(noexcept(std::declval< const Core & >().equals(std::declval< const Core & >()))) -> bool {
+		return m_core.equals(other.m_core);
+	}
+
+	constexpr void increment() noexcept(noexcept(std::declval< Core & >().increment())) { m_core.increment(); }
+
+	template< typename C = Core, typename = std::enable_if_t< member_functions::has_decrement_v< C > > >
+	constexpr void decrement() noexcept(noexcept(std::declval< C & >().decrement())) {
+		m_core.decrement();
+	}
+
+	template< typename C = Core, typename = std::enable_if_t< member_functions::has_advance_v< C > > >
+	constexpr void advance(difference_type amount) noexcept(noexcept(std::declval< C & >().advance(amount))) {
+		m_core.advance(amount);
+	}
+
+	template< typename C = Core, typename = std::enable_if_t< member_functions::has_distance_to_v< C > > >
+	[[nodiscard]] constexpr auto distance_to(const transform_core &other) const
+		noexcept(noexcept(std::declval< const C & >().distance_to(std::declval< const C & >()))) -> difference_type {
+		return m_core.distance_to(other.m_core);
+	}
+
+	[[nodiscard]] constexpr auto base() const noexcept -> const Core & { return m_core; }
+
+private:
+	Core m_core;
+	details::semiregular_box< Function > m_function;
+};
+
+// Caches the computed values, so that references can be handed out
+template< typename Core, typename Function > class transform_core< Core, Function, true > {
+public:
+	using target_iterator_category = typename core_traits< Core >::iterator_category;
+	using difference_type          = typename core_traits< Core >::difference_type;
+	using value_type               = std::remove_cv_t< details::transform_result_t< Core, Function > >;
+
+	static constexpr bool stashes_elements = true;
+
+	constexpr transform_core() = default;
+	constexpr transform_core(Core core, Function function) : m_core(std::move(core)), m_function(std::move(function)) {}
+
+	[[nodiscard]] constexpr auto dereference() const
+		noexcept(std::is_nothrow_invocable_v< const Function &, typename core_traits< Core >::reference >
+				 && noexcept(std::declval< const Core & >().dereference())) -> const value_type & {
+		if (!m_cache.has_value()) {
+			m_cache.emplace(m_function(m_core.dereference()));
+		}
+		return *m_cache;
+	}
+
+	[[nodiscard]] constexpr auto equals(const transform_core &other) const
+		noexcept(noexcept(std::declval< const Core & >().equals(std::declval< const Core & >()))) -> bool {
+		return m_core.equals(other.m_core);
+	}
+
+	constexpr void increment() noexcept(noexcept(std::declval< Core & >().increment())) {
+		m_cache.reset();
+		m_core.increment();
+	}
+
+	template< typename C = Core, typename = std::enable_if_t< member_functions::has_decrement_v< C > > >
+	constexpr void decrement() noexcept(noexcept(std::declval< C & >().decrement())) {
+		m_cache.reset();
+		m_core.decrement();
+	}
+
+	template< typename C = Core, typename = std::enable_if_t< member_functions::has_advance_v< C > > >
+	constexpr void advance(difference_type amount) noexcept(noexcept(std::declval< C & >().advance(amount))) {
+		if (amount != 0) {
+			m_cache.reset();
+			m_core.advance(amount);
+		}
+	}
+
+	template< typename C = Core, typename = std::enable_if_t< member_functions::has_distance_to_v< C > > >
+	[[nodiscard]] constexpr auto distance_to(const transform_core &other) const
+		noexcept(noexcept(std::declval< const C & >().distance_to(std::declval< const C & >()))) -> difference_type {
+		return m_core.distance_to(other.m_core);
+	}
+
+	[[nodiscard]] constexpr auto base() const noexcept -> const Core & { return m_core; }
+
+private:
+	Core m_core;
+	details::semiregular_box< Function > m_function;
+	mutable details::cache_box< value_type > m_cache;
+};
+
+template< typename Core, typename Function >
+using transform_iterator = iterator_facade< transform_core< Core, Function > >;
+
+// The results of applying the function to the elements between the given cores
+template< typename Core, typename Function, typename = std::enable_if_t< !is_iterator_facade_v< Core > > >
+auto transformed(Core first, Core last, Function function) -> range< transform_core< Core, Function > > {
+	return { transform_core< Core, Function >(std::move(first), function),
+			 transform_core< Core, Function >(std::move(last), function) };
+}
+
+// The results of applying the function to the elements in [first, last)
+template< typename Core, typename Function >
+auto transformed(const iterator_facade< Core > &first, const iterator_facade< Core > &last, Function function)
+	-> range< transform_core< Core, Function > > {
+	return ::iterators::transformed(details::core_access::core(first), details::core_access::core(last),
+									std::move(function));
+}
+
+// The results of applying the function to the elements of the given range (whose iterators must be of type
+// iterator_facade< Core >)
+template< typename Range, typename Function >
+auto transformed(const Range &range, Function function)
+	-> decltype(::iterators::transformed(std::begin(range), std::end(range), std::move(function))) {
+	return ::iterators::transformed(std::begin(range), std::end(range), std::move(function));
+}
+
+} // namespace iterators
+
+#endif // ITERATORS_CORES_TRANSFORM_HPP_
@@ -12,9 +12,9 @@ namespace iterators::details {
 
 template< typename Value > class arrow_proxy {
 public:
-	arrow_proxy(Value val) : m_val(std::move(val)) {}
+	constexpr arrow_proxy(Value val) : m_val(std::move(val)) {}
 
-	auto operator->() -> Value * { return std::addressof(m_val); }
+	constexpr auto operator->() -> Value * { return std::addressof(m_val); }
 
 private:
 	Value m_val;
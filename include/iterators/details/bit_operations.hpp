@@ -0,0 +1,85 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_DETAILS_BIT_OPERATIONS_HPP_
+#define ITERATORS_DETAILS_BIT_OPERATIONS_HPP_
+
+#include <cstdint>
+
+#if __has_include(<version>)
+#	include <version>
+#endif
+
+#ifdef __cpp_lib_bitops
+#	include <bit>
+#elif defined(_MSC_VER)
+#	include <intrin.h>
+#endif
+
+#ifdef __BMI2__
+#	include <immintrin.h>
+#endif
+
+namespace iterators::details {
+
+// Index of the lowest set bit. The given value must not be zero.
+inline auto count_trailing_zeros(std::uint64_t value) -> unsigned int {
+#ifdef __cpp_lib_bitops
+	return static_cast< unsigned int >(std::countr_zero(value));
+#elif defined(__GNUC__) || defined(__clang__)
+	return static_cast< unsigned int >(__builtin_ctzll(value));
+#elif defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index = 0;
+	_BitScanForward64(&index, value);
+	return static_cast< unsigned int >(index);
+#else
+	unsigned int index = 0;
+	while ((value & 1U) == 0) {
+		value >>= 1U;
+		++index;
+	}
+	return index;
+#endif
+}
+
+inline auto popcount(std::uint64_t value) -> unsigned int {
+#ifdef __cpp_lib_bitops
+	return static_cast< unsigned int >(std::popcount(value));
+#elif defined(__GNUC__) || defined(__clang__)
+	return static_cast< unsigned int >(__builtin_popcountll(value));
+#else
+	unsigned int count = 0;
+	for (; value != 0; value &= value - 1) {
+		++count;
+	}
+	return count;
+#endif
+}
+
+// Clears the lowest set bit
+constexpr auto clear_lowest_bit(std::uint64_t value) -> std::uint64_t { return value & (value - 1); }
+
+// Packs the lowest bits of the eight bytes of the given value into an 8-bit mask (the lowest bit of byte i ends up in
+// bit i). All other bits must be zero, so that the multiplication moves every bit into the top byte without carries.
+constexpr auto pack_byte_flags(std::uint64_t flags) -> std::uint64_t { return (flags * 0x0102040810204080ULL) >> 56U; }
+
+// Gathers the bits at even positions (0, 2, 4, ...) of the given value into its lower half, e.g. in order to extract
+// one coordinate from an interleaved (Morton) code
+inline auto compact_even_bits(std::uint64_t value) -> std::uint64_t {
+#ifdef __BMI2__
+	return _pext_u64(value, 0x5555555555555555ULL);
+#else
+	value &= 0x5555555555555555ULL;
+	value = (value | (value >> 1U)) & 0x3333333333333333ULL;
+	value = (value | (value >> 2U)) & 0x0F0F0F0F0F0F0F0FULL;
+	value = (value | (value >> 4U)) & 0x00FF00FF00FF00FFULL;
+	value = (value | (value >> 8U)) & 0x0000FFFF0000FFFFULL;
+	value = (value | (value >> 16U)) & 0x00000000FFFFFFFFULL;
+	return value;
+#endif
+}
+
+} // namespace iterators::details
+
+#endif // ITERATORS_DETAILS_BIT_OPERATIONS_HPP_
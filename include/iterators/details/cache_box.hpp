@@ -0,0 +1,57 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_DETAILS_CACHE_BOX_HPP_
+#define ITERATORS_DETAILS_CACHE_BOX_HPP_
+
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace iterators::details {
+
+// Holds the element a core has computed for its current position (if any). Values that can be default-constructed and
+// assigned to are stored as they are, next to a flag telling whether they are up to date. Compilers can follow the
+// initialization of such a member (whereas reading from an std::optional that has been populated conditionally makes
+// e.g. GCC report the value as maybe uninitialized), and assigning to it reuses the value's resources (e.g. a string's
+// buffer) from one position to the next. All other values are stored in an std::optional.
+template< typename T, typename = void > class cache_box {
+public:
+	[[nodiscard]] constexpr auto has_value() const noexcept -> bool { return m_value.has_value(); }
+
+	template< typename U > constexpr auto emplace(U &&value) -> const T & {
+		return m_value.emplace(std::forward< U >(value));
+	}
+
+	constexpr void reset() noexcept { m_value.reset(); }
+
+	[[nodiscard]] constexpr auto operator*() const noexcept -> const T & { return *m_value; }
+
+private:
+	std::optional< T > m_value;
+};
+
+template< typename T >
+class cache_box< T, std::enable_if_t< std::is_default_constructible_v< T > && std::is_move_assignable_v< T > > > {
+public:
+	[[nodiscard]] constexpr auto has_value() const noexcept -> bool { return m_filled; }
+
+	template< typename U > constexpr auto emplace(U &&value) -> const T & {
+		m_value  = std::forward< U >(value);
+		m_filled = true;
+		return m_value;
+	}
+
+	constexpr void reset() noexcept { m_filled = false; }
+
+	[[nodiscard]] constexpr auto operator*() const noexcept -> const T & { return m_value; }
+
+private:
+	T m_value{};
+	bool m_filled = false;
+};
+
+} // namespace iterators::details
+
+#endif // ITERATORS_DETAILS_CACHE_BOX_HPP_
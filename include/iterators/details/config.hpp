@@ -0,0 +1,44 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_DETAILS_CONFIG_HPP_
+#define ITERATORS_DETAILS_CONFIG_HPP_
+
+// MSVC only applies the empty base optimization to the first base class unless explicitly told otherwise. Classes
+// that (may) derive from multiple empty bases are marked with this in order to have the same layout on all ABIs.
+#if defined(_MSC_VER) && !defined(__clang__)
+#	define ITERATORS_EMPTY_BASES __declspec(empty_bases)
+#else
+#	define ITERATORS_EMPTY_BASES
+#endif
+
+// Unoptimized builds don't inline anything, so every operator of an iterator_facade costs several calls (operator,
+// core(), core method), which makes iterator-heavy code in debug and sanitizer builds very slow. Defining
+// ITERATORS_FORCE_INLINE (before including any header of this library, e.g. via -DITERATORS_FORCE_INLINE) forces the
+// thin layers forwarding to the core to be inlined in builds without optimization (-O0). They are also marked as
+// artificial where supported, so that debuggers step right into the core instead of through the forwarding layers.
+// With (any) optimization, e.g. -Og, GCC and Clang inline these layers on their own. Forcing it there would even be
+// counterproductive, as GCC then stops inlining the core's functions (see benchmarks/debug_overhead.cpp).
+#if defined(ITERATORS_FORCE_INLINE)
+#	if defined(__GNUC__) || defined(__clang__)
+#		if !defined(__OPTIMIZE__)
+#			if defined(__has_attribute)
+#				if __has_attribute(artificial)
+#					define ITERATORS_ALWAYS_INLINE __attribute__((always_inline, artificial))
+#				endif
+#			endif
+#			ifndef ITERATORS_ALWAYS_INLINE
+#				define ITERATORS_ALWAYS_INLINE __attribute__((always_inline))
+#			endif
+#		endif
+#	elif defined(_MSC_VER)
+#		define ITERATORS_ALWAYS_INLINE __forceinline
+#	endif
+#endif
+
+#ifndef ITERATORS_ALWAYS_INLINE
+#	define ITERATORS_ALWAYS_INLINE
+#endif
+
+#endif // ITERATORS_DETAILS_CONFIG_HPP_
@@ -6,16 +6,49 @@
 #define ITERATORS_DETAILS_ITERATOR_FACADE_BASE_HPP_
 
 #include "arrow_proxy.hpp"
+#include "config.hpp"
 #include "iterators/core_traits.hpp"
 #include "iterators/type_traits.hpp"
 
 #include <iterator>
 #include <type_traits>
+#include <utility>
 
 namespace iterators::details {
 
 template< typename Derived, typename Core, typename IteratorCategory > class iterator_facade_base;
 
+// Cores of different types (e.g. those of an iterator and of the corresponding const_iterator) are compared directly
+// if either of them implements equals (respectively distance_to) for the other one. Mixed comparisons and subtractions
+// then don't have to convert (i.e. copy) one of the cores first.
+template< typename Core, typename OtherCore >
+constexpr bool has_heterogeneous_equals_v = !std::is_same_v< Core, OtherCore >
+											&& (member_functions::has_equals_with_v< Core, OtherCore >
+												|| member_functions::has_equals_with_v< OtherCore, Core >);
+
+template< typename Core, typename OtherCore >
+constexpr bool has_heterogeneous_distance_to_v = !std::is_same_v< Core, OtherCore >
+												 && (member_functions::has_distance_to_with_v< Core, OtherCore >
+													 || member_functions::has_distance_to_with_v< OtherCore, Core >);
+
+template< typename Core, typename OtherCore >
+ITERATORS_ALWAYS_INLINE constexpr auto heterogeneous_equals(const Core &lhs, const OtherCore &rhs) -> bool {
+	if constexpr (member_functions::has_equals_with_v< Core, OtherCore >) {
+		return lhs.equals(rhs);
+	} else {
+		return rhs.equals(lhs);
+	}
+}
+
+template< typename Difference, typename Core, typename OtherCore >
+ITERATORS_ALWAYS_INLINE constexpr auto heterogeneous_distance_to(const Core &from, const OtherCore &to) -> Difference {
+	if constexpr (member_functions::has_distance_to_with_v< Core, OtherCore >) {
+		return static_cast< Difference >(from.distance_to(to));
+	} else {
+		return static_cast< Difference >(-to.distance_to(from));
+	}
+}
+
 // Output iterator
 template< typename Derived, typename Core > class iterator_facade_base< Derived, Core, std::output_iterator_tag > {
 public:
@@ -23,17 +56,19 @@ public:
 
 	iterator_facade_base() = delete;
 
-	auto operator*() const -> typename core_traits::reference {
+	ITERATORS_ALWAYS_INLINE constexpr auto operator*() const -> typename core_traits::reference {
 		// TODO: Assert that Derived::reference can be used as an lvalue
 		return core().dereference();
 	}
 
 private:
-	auto core() const -> const Core & { return static_cast< const Derived & >(*this).m_core; }
+	ITERATORS_ALWAYS_INLINE constexpr auto core() const -> const Core & {
+		return static_cast< const Derived & >(*this).m_core;
+	}
 
 protected:
 	struct DefaultCtorTag {};
-	iterator_facade_base(DefaultCtorTag) {}
+	ITERATORS_ALWAYS_INLINE constexpr iterator_facade_base(DefaultCtorTag) {}
 };
 
 // Input iterator
@@ -48,12 +83,13 @@ public:
 
 	iterator_facade_base() = delete;
 
-	auto operator*() const -> typename core_traits::reference {
+	ITERATORS_ALWAYS_INLINE constexpr auto operator*() const
+		noexcept(noexcept(std::declval< const Core & >().dereference())) -> typename core_traits::reference {
 		// TODO: Assert that Derived::reference can (only) be used as an rvalue
 		return core().dereference();
 	}
 
-	auto operator->() const -> typename core_traits::pointer {
+	ITERATORS_ALWAYS_INLINE constexpr auto operator->() const -> typename core_traits::pointer {
 		if constexpr (std::is_reference_v< typename Derived::reference >) {
 			return std::addressof(operator*());
 		} else {
@@ -65,19 +101,44 @@ public:
 		}
 	}
 
-	friend auto operator==(const Derived &lhs, const Derived &rhs) -> bool {
+	ITERATORS_ALWAYS_INLINE constexpr friend auto operator==(const Derived &lhs, const Derived &rhs) noexcept(
+		noexcept(std::declval< const Core & >().equals(std::declval< const Core & >()))) -> bool {
 		return static_cast< const iterator_facade_base & >(lhs).core().equals(
 			static_cast< const iterator_facade_base & >(rhs).core());
 	}
 
-	friend auto operator!=(const Derived &lhs, const Derived &rhs) -> bool { return !(lhs == rhs); }
+	ITERATORS_ALWAYS_INLINE constexpr friend auto operator!=(const Derived &lhs, const Derived &rhs) noexcept(
+		noexcept(lhs == rhs)) -> bool {
+		return !(lhs == rhs);
+	}
+
+	// Mixed comparisons, e.g. between an iterator and a const_iterator (see has_heterogeneous_equals_v)
+	template< typename OtherCore, typename = std::enable_if_t< has_heterogeneous_equals_v< Core, OtherCore > > >
+	ITERATORS_ALWAYS_INLINE constexpr friend auto
+		operator==(const Derived &lhs, const ::iterators::iterator_facade< OtherCore > &rhs) -> bool {
+		return heterogeneous_equals(static_cast< const iterator_facade_base & >(lhs).core(), core_of(rhs));
+	}
+
+	template< typename OtherCore, typename = std::enable_if_t< has_heterogeneous_equals_v< Core, OtherCore > > >
+	ITERATORS_ALWAYS_INLINE constexpr friend auto
+		operator!=(const Derived &lhs, const ::iterators::iterator_facade< OtherCore > &rhs) -> bool {
+		return !(lhs == rhs);
+	}
 
 private:
-	auto core() const -> const Core & { return static_cast< const Derived & >(*this).m_core; }
+	ITERATORS_ALWAYS_INLINE constexpr auto core() const -> const Core & {
+		return static_cast< const Derived & >(*this).m_core;
+	}
+
+	template< typename OtherCore >
+	ITERATORS_ALWAYS_INLINE static constexpr auto core_of(const ::iterators::iterator_facade< OtherCore > &iterator)
+		-> const OtherCore & {
+		return iterator.m_core;
+	}
 
 protected:
 	struct DefaultCtorTag {};
-	iterator_facade_base(DefaultCtorTag) {}
+	ITERATORS_ALWAYS_INLINE constexpr iterator_facade_base(DefaultCtorTag) {}
 };
 
 // Forward iterator = input iterator + default-constructibility
@@ -98,10 +159,11 @@ public:
 
 	// Access the protected "default" constructor of the base class to not require the actual default constructor (which
 	// is deleted)
-	iterator_facade_base() : base_type(typename base_type::DefaultCtorTag{}) {}
+	ITERATORS_ALWAYS_INLINE constexpr iterator_facade_base() : base_type(typename base_type::DefaultCtorTag{}) {}
 
 protected:
-	iterator_facade_base(typename base_type::DefaultCtorTag) : iterator_facade_base() {}
+	ITERATORS_ALWAYS_INLINE constexpr iterator_facade_base(typename base_type::DefaultCtorTag)
+		: iterator_facade_base() {}
 };
 
 // Bidirectional iterator = forward iterator + decrement-support
@@ -115,24 +177,26 @@ public:
 	using base_type   = iterator_facade_base< Derived, Core, std::forward_iterator_tag >;
 	using core_traits = ::iterators::core_traits< Core >;
 
-	iterator_facade_base() = default;
+	ITERATORS_ALWAYS_INLINE constexpr iterator_facade_base() = default;
 
-	auto operator--() -> Derived & {
+	ITERATORS_ALWAYS_INLINE constexpr auto operator--() noexcept(noexcept(std::declval< Core & >().decrement()))
+		-> Derived & {
 		core().decrement();
 		return static_cast< Derived & >(*this);
 	}
 
-	auto operator--(int) -> Derived {
+	ITERATORS_ALWAYS_INLINE constexpr auto operator--(int) -> Derived {
 		Derived copy(static_cast< Derived & >(*this));
 		operator--();
 		return copy;
 	}
 
 private:
-	auto core() -> Core & { return static_cast< Derived & >(*this).m_core; }
+	ITERATORS_ALWAYS_INLINE constexpr auto core() -> Core & { return static_cast< Derived & >(*this).m_core; }
 
 protected:
-	iterator_facade_base(typename base_type::DefaultCtorTag) : iterator_facade_base() {}
+	ITERATORS_ALWAYS_INLINE constexpr iterator_facade_base(typename base_type::DefaultCtorTag)
+		: iterator_facade_base() {}
 };
 
 // Random access iterator = bidirectional iterator + arithmetic operations (+/-)
@@ -150,62 +214,130 @@ public:
 	using base_type   = iterator_facade_base< Derived, Core, std::bidirectional_iterator_tag >;
 	using core_traits = ::iterators::core_traits< Core >;
 
-	static_assert(std::is_convertible_v< typename core_traits::difference_type, int >,
-				  "The chosen difference_type must be convertible to a signed arithmetic type");
-	static_assert(std::is_convertible_v< int, typename core_traits::difference_type >,
-				  "The chosen difference_type must be convertible from a signed arithmetic type");
+	// Any signed integer type may be used, including narrow ones such as std::int32_t (e.g. in order to use compact
+	// index-based cores). All arithmetic is carried out in the core's difference_type.
+	static_assert(std::is_integral_v< typename core_traits::difference_type >
+					  && std::is_signed_v< typename core_traits::difference_type >,
+				  "The chosen difference_type must be a signed integer type");
 
-	iterator_facade_base() = default;
+	ITERATORS_ALWAYS_INLINE constexpr iterator_facade_base() = default;
 
 	// Compound assignment
-	friend auto operator+=(Derived &iterator, typename core_traits::difference_type offset) -> Derived & {
+	ITERATORS_ALWAYS_INLINE constexpr friend auto operator+=(Derived &iterator,
+															 typename core_traits::difference_type offset) noexcept(
+		noexcept(std::declval< Core & >().advance(offset))) -> Derived & {
 		static_cast< iterator_facade_base & >(iterator).core().advance(offset);
 
 		return iterator;
 	}
 
-	friend auto operator-=(Derived &iterator, typename core_traits::difference_type offset) -> Derived & {
-		return iterator += -offset;
+	ITERATORS_ALWAYS_INLINE constexpr friend auto operator-=(Derived &iterator,
+															 typename core_traits::difference_type offset) noexcept(
+		noexcept(iterator += offset)) -> Derived & {
+		return iterator += static_cast< typename core_traits::difference_type >(-offset);
 	}
 
 	// Arithmetic operators
-	friend auto operator+(const Derived &iterator, typename core_traits::difference_type offset) -> Derived {
+	ITERATORS_ALWAYS_INLINE constexpr friend auto operator+(const Derived &iterator,
+															typename core_traits::difference_type offset) -> Derived {
 		Derived copy(iterator);
 		copy += offset;
 		return copy;
 	}
 
-	friend auto operator+(typename core_traits::difference_type offset, const Derived &iterator) -> Derived {
+	ITERATORS_ALWAYS_INLINE constexpr friend auto operator+(typename core_traits::difference_type offset,
+															const Derived &iterator) -> Derived {
 		return iterator + offset;
 	}
 
-	friend auto operator-(const Derived &iterator, typename core_traits::difference_type offset) -> Derived {
-		return iterator - offset;
+	ITERATORS_ALWAYS_INLINE constexpr friend auto operator-(const Derived &iterator,
+															typename core_traits::difference_type offset) -> Derived {
+		Derived copy(iterator);
+		copy -= offset;
+		return copy;
 	}
 
-	friend auto operator-(const Derived &lhs, const Derived &rhs) -> typename core_traits::difference_type {
-		return rhs.distance_to(lhs);
+	ITERATORS_ALWAYS_INLINE constexpr friend auto operator-(const Derived &lhs, const Derived &rhs) noexcept(
+		noexcept(std::declval< const Core & >().distance_to(std::declval< const Core & >())))
+		-> typename core_traits::difference_type {
+		return static_cast< const iterator_facade_base & >(rhs).core().distance_to(
+			static_cast< const iterator_facade_base & >(lhs).core());
 	}
 
 	// Inequality comparisons
-	auto friend operator<(const Derived &lhs, const Derived &rhs) -> bool { return lhs - rhs < 0; }
+	ITERATORS_ALWAYS_INLINE constexpr auto friend operator<(const Derived &lhs, const Derived &rhs) -> bool {
+		return lhs - rhs < 0;
+	}
 
-	auto friend operator<=(const Derived &lhs, const Derived &rhs) -> bool { return lhs == rhs || lhs < rhs; }
+	ITERATORS_ALWAYS_INLINE constexpr auto friend operator<=(const Derived &lhs, const Derived &rhs) -> bool {
+		return lhs == rhs || lhs < rhs;
+	}
 
-	auto friend operator>(const Derived &lhs, const Derived &rhs) -> bool { return !(lhs <= rhs); }
+	ITERATORS_ALWAYS_INLINE constexpr auto friend operator>(const Derived &lhs, const Derived &rhs) -> bool {
+		return !(lhs <= rhs);
+	}
+
+	ITERATORS_ALWAYS_INLINE constexpr auto friend operator>=(const Derived &lhs, const Derived &rhs) -> bool {
+		return !(lhs < rhs);
+	}
+
+	// Mixed subtraction and comparisons, e.g. between an iterator and a const_iterator (see
+	// has_heterogeneous_distance_to_v)
+	template< typename OtherCore, typename = std::enable_if_t< has_heterogeneous_distance_to_v< Core, OtherCore > > >
+	ITERATORS_ALWAYS_INLINE constexpr friend auto
+		operator-(const Derived &lhs, const ::iterators::iterator_facade< OtherCore > &rhs) ->
+		typename core_traits::difference_type {
+		return heterogeneous_distance_to< typename core_traits::difference_type >(
+			core_of(rhs), static_cast< const iterator_facade_base & >(lhs).core());
+	}
+
+	template< typename OtherCore, typename = std::enable_if_t< has_heterogeneous_distance_to_v< Core, OtherCore > > >
+	ITERATORS_ALWAYS_INLINE constexpr friend auto
+		operator<(const Derived &lhs, const ::iterators::iterator_facade< OtherCore > &rhs) -> bool {
+		return lhs - rhs < 0;
+	}
 
-	auto friend operator>=(const Derived &lhs, const Derived &rhs) -> bool { return lhs - rhs > 0; }
+	template< typename OtherCore, typename = std::enable_if_t< has_heterogeneous_distance_to_v< Core, OtherCore > > >
+	ITERATORS_ALWAYS_INLINE constexpr friend auto
+		operator<=(const Derived &lhs, const ::iterators::iterator_facade< OtherCore > &rhs) -> bool {
+		return lhs - rhs <= 0;
+	}
 
-	// Offset dereference
-	auto operator[](typename core_traits::difference_type offset) const -> typename core_traits::reference {
-		return *(static_cast< Derived & >(*this) + offset);
+	template< typename OtherCore, typename = std::enable_if_t< has_heterogeneous_distance_to_v< Core, OtherCore > > >
+	ITERATORS_ALWAYS_INLINE constexpr friend auto
+		operator>(const Derived &lhs, const ::iterators::iterator_facade< OtherCore > &rhs) -> bool {
+		return lhs - rhs > 0;
+	}
+
+	template< typename OtherCore, typename = std::enable_if_t< has_heterogeneous_distance_to_v< Core, OtherCore > > >
+	ITERATORS_ALWAYS_INLINE constexpr friend auto
+		operator>=(const Derived &lhs, const ::iterators::iterator_facade< OtherCore > &rhs) -> bool {
+		return lhs - rhs >= 0;
+	}
+
+	// Offset dereference. The element is obtained from a temporary iterator, so for cores that stash their elements
+	// a reference would dangle and a copy of the element is returned instead.
+	ITERATORS_ALWAYS_INLINE constexpr auto operator[](typename core_traits::difference_type offset) const
+		-> std::conditional_t< is_stashing_core< Core >::value, typename core_traits::value_type,
+							   typename core_traits::reference > {
+		return *(static_cast< const Derived & >(*this) + offset);
 	}
 
 private:
-	auto core() const -> const Core & { return static_cast< const Derived & >(*this).m_core; }
+	ITERATORS_ALWAYS_INLINE constexpr auto core() const -> const Core & {
+		return static_cast< const Derived & >(*this).m_core;
+	}
+	ITERATORS_ALWAYS_INLINE constexpr auto core() -> Core & { return static_cast< Derived & >(*this).m_core; }
+
+	template< typename OtherCore >
+	ITERATORS_ALWAYS_INLINE static constexpr auto core_of(const ::iterators::iterator_facade< OtherCore > &iterator)
+		-> const OtherCore & {
+		return iterator.m_core;
+	}
 
 protected:
-	iterator_facade_base(typename base_type::DefaultCtorTag) : iterator_facade_base() {}
+	ITERATORS_ALWAYS_INLINE constexpr iterator_facade_base(typename base_type::DefaultCtorTag)
+		: iterator_facade_base() {}
 };
 
 } // namespace iterators::details
@@ -0,0 +1,28 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_DETAILS_PREFETCH_HPP_
+#define ITERATORS_DETAILS_PREFETCH_HPP_
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#	include <xmmintrin.h>
+#endif
+
+namespace iterators::details {
+
+// Hints the CPU to load the cache line containing the given address for reading. This never faults, so the address
+// doesn't have to be valid.
+inline void prefetch(const void *address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(address, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	_mm_prefetch(static_cast< const char * >(address), _MM_HINT_T0);
+#else
+	static_cast< void >(address);
+#endif
+}
+
+} // namespace iterators::details
+
+#endif // ITERATORS_DETAILS_PREFETCH_HPP_
@@ -0,0 +1,87 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_DETAILS_SEMIREGULAR_BOX_HPP_
+#define ITERATORS_DETAILS_SEMIREGULAR_BOX_HPP_
+
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace iterators::details {
+
+// std::invoke is only constexpr as of C++20. Function objects are called directly, so that calls through a box can be
+// evaluated at compile time in C++17 as well.
+template< typename Function, typename... Args >
+constexpr auto invoke(const Function &function, Args &&...args) -> decltype(auto) {
+	if constexpr (std::is_member_pointer_v< Function >) {
+		return std::invoke(function, std::forward< Args >(args)...);
+	} else {
+		return function(std::forward< Args >(args)...);
+	}
+}
+
+// Wraps a function object that is stored inside a core. Cores have to be default-constructible and copy-assignable,
+// which lambdas are not (prior to C++20). Such function objects are stored in an std::optional that is re-constructed
+// on assignment, whereas all others are stored as they are.
+template< typename Function, typename = void > class semiregular_box {
+public:
+	constexpr semiregular_box() = default;
+	constexpr semiregular_box(Function function) : m_function(std::move(function)) {}
+
+	semiregular_box(const semiregular_box &) = default;
+	semiregular_box(semiregular_box &&)      = default;
+
+	auto operator=(const semiregular_box &other) -> semiregular_box & {
+		if (this != &other) {
+			if (other.m_function) {
+				m_function.emplace(*other.m_function);
+			} else {
+				m_function.reset();
+			}
+		}
+		return *this;
+	}
+
+	auto operator=(semiregular_box &&other) noexcept(std::is_nothrow_move_constructible_v< Function >)
+		-> semiregular_box & {
+		if (other.m_function) {
+			m_function.emplace(std::move(*other.m_function));
+		} else {
+			m_function.reset();
+		}
+		return *this;
+	}
+
+	[[nodiscard]] constexpr auto get() const -> const Function & { return *m_function; }
+
+	template< typename... Args > constexpr auto operator()(Args &&...args) const -> decltype(auto) {
+		return details::invoke(*m_function, std::forward< Args >(args)...);
+	}
+
+private:
+	std::optional< Function > m_function;
+};
+
+template< typename Function >
+class semiregular_box< Function, std::enable_if_t< std::is_default_constructible_v< Function >
+													 && std::is_copy_assignable_v< Function > > > {
+public:
+	constexpr semiregular_box() = default;
+	constexpr semiregular_box(Function function) : m_function(std::move(function)) {}
+
+	[[nodiscard]] constexpr auto get() const -> const Function & { return m_function; }
+
+	template< typename... Args > constexpr auto operator()(Args &&...args) const -> decltype(auto) {
+		return details::invoke(m_function, std::forward< Args >(args)...);
+	}
+
+private:
+	Function m_function;
+};
+
+} // namespace iterators::details
+
+#endif // ITERATORS_DETAILS_SEMIREGULAR_BOX_HPP_
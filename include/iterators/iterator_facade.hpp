@@ -6,15 +6,19 @@
 #define ITERATORS_ITERATOR_FACADE_HPP_
 
 #include "core_traits.hpp"
+#include "details/config.hpp"
 #include "details/core_satisfies_iterator_category.hpp"
 #include "details/iterator_facade_base.hpp"
 #include "is_semantically_const.hpp"
 #include "iterators/type_traits.hpp"
 
 #include <type_traits>
+#include <utility>
 
 namespace iterators {
 
+template< typename > class iterator_facade;
+
 namespace details {
 
 	template< typename ToCore, typename FromCore >
@@ -25,10 +29,25 @@ namespace details {
 		return std::forward< FromCore >(core);
 	}
 
+	// Grants library components access to the core of an iterator_facade without widening the facade's interface
+	struct core_access {
+		template< typename Core >
+		ITERATORS_ALWAYS_INLINE static constexpr auto core(const iterator_facade< Core > &iterator) -> const Core & {
+			return iterator.m_core;
+		}
+
+		template< typename Core >
+		ITERATORS_ALWAYS_INLINE static constexpr auto core(iterator_facade< Core > &iterator) -> Core & {
+			return iterator.m_core;
+		}
+	};
+
 } // namespace details
 
+// An iterator_facade has exactly the size and alignment of its Core: all base classes are empty and the core is the
+// only data member. Hence, wrapping a core in a facade never costs any memory (see tests/layout.cpp).
 template< typename Core >
-class iterator_facade
+class ITERATORS_EMPTY_BASES iterator_facade
 	: public details::iterator_facade_base< iterator_facade< Core >, Core, typename Core::target_iterator_category > {
 public:
 	static_assert(std::is_copy_constructible_v< Core >, "Iterator cores must be copy-constructible");
@@ -52,30 +71,31 @@ public:
 	using pointer           = typename core_traits::pointer;
 	using iterator_category = typename core_traits::iterator_category;
 
-	static_assert(std::disjunction_v< std::is_signed< difference_type >, std::is_void< difference_type > >,
-				  "An iterator's difference_type must be a signed integer type or void");
+	static_assert(std::is_signed_v< difference_type >, "An iterator's difference_type must be a signed integer type");
 
 
-	iterator_facade(Core core) : base_type(typename base_type::DefaultCtorTag{}), m_core(std::move(core)) {}
+	ITERATORS_ALWAYS_INLINE constexpr iterator_facade(Core core)
+		: base_type(typename base_type::DefaultCtorTag{}), m_core(std::move(core)) {}
 
-	iterator_facade(const iterator_facade &)                                                   = default;
-	iterator_facade(iterator_facade &&) noexcept(std::is_nothrow_move_constructible_v< Core >) = default;
-	~iterator_facade()                                                                         = default;
+	constexpr iterator_facade(const iterator_facade &)                                                   = default;
+	constexpr iterator_facade(iterator_facade &&) noexcept(std::is_nothrow_move_constructible_v< Core >) = default;
+	~iterator_facade()                                                                                   = default;
 
-	auto operator=(const iterator_facade &) -> iterator_facade & = default;
-	auto operator            =(iterator_facade &&) noexcept(std::is_nothrow_move_assignable_v< Core >)
+	constexpr auto operator=(const iterator_facade &) -> iterator_facade & = default;
+	constexpr auto operator  =(iterator_facade &&) noexcept(std::is_nothrow_move_assignable_v< Core >)
 		-> iterator_facade & = default;
 
 	// Inherit constructors from base class (default-constructor, if applicable)
 	using base_type::base_type;
 
-	auto operator++() -> iterator_facade & {
+	ITERATORS_ALWAYS_INLINE constexpr auto operator++() noexcept(noexcept(std::declval< Core & >().increment()))
+		-> iterator_facade & {
 		m_core.increment();
 
 		return *this;
 	}
 
-	auto operator++(int) -> iterator_facade {
+	ITERATORS_ALWAYS_INLINE constexpr auto operator++(int) -> iterator_facade {
 		self_type copy(*this);
 		operator++();
 		return copy;
@@ -88,7 +108,7 @@ public:
 		typename = std::enable_if_t<
 			is_iterator_facade_v< std::remove_reference_t<
 				IteratorFacade > > && !is_const_iterator_facade_v< std::remove_reference_t< IteratorFacade > > && is_const_iterator_facade_v< self_type > > >
-	iterator_facade(IteratorFacade &&other)
+	constexpr iterator_facade(IteratorFacade &&other)
 		: base_type(typename base_type::DefaultCtorTag{}),
 		  m_core(details::require_core_convertible_to< Core >(std::forward< IteratorFacade >(other).m_core)) {}
 
@@ -97,6 +117,7 @@ private:
 
 	template< typename, typename, typename > friend class details::iterator_facade_base;
 	template< typename > friend class iterator_facade;
+	friend struct details::core_access;
 };
 
 } // namespace iterators
@@ -0,0 +1,78 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_ITERATOR_OPERATIONS_HPP_
+#define ITERATORS_ITERATOR_OPERATIONS_HPP_
+
+#include "iterators/iterator_facade.hpp"
+#include "iterators/type_traits.hpp"
+
+#include <cassert>
+#include <iterator>
+#include <type_traits>
+
+// Counterparts of std::advance, std::distance, std::next and std::prev that make use of a core's 'advance' and
+// 'distance_to' functions even if the core's iterator category is weaker than random access. This allows e.g. cores
+// over skip lists or run-length encoded data to jump ahead in sublinear time without having to expose operator+
+// (which would promise constant-time random access).
+//
+// Overloading the functions in namespace std is not allowed. Instead, the overloads for iterator_facade live in
+// namespace iterators and are more specialized than their std counterparts. Thus, they are preferred by both
+// qualified calls (iterators::next(it, n)) and unqualified calls that use the customary
+// "using std::advance; advance(it, n);" idiom (the facade overloads are found via argument-dependent lookup).
+// There are deliberately no overloads for other iterator types: argument-dependent lookup also finds namespace
+// iterators for e.g. std::vector< iterators::... >::iterator, for which such overloads would be ambiguous with std.
+
+namespace iterators {
+
+template< typename Core, typename Distance >
+constexpr void advance(iterator_facade< Core > &iterator, Distance amount) {
+	using difference_type = typename iterator_facade< Core >::difference_type;
+
+	if constexpr (member_functions::has_advance_v< Core >) {
+		assert((static_cast< difference_type >(amount) >= 0
+				|| iterator_category::is_at_least_v< typename iterator_facade< Core >::iterator_category,
+													 std::bidirectional_iterator_tag >)
+			   && "Only bidirectional iterators can be advanced backwards");
+
+		details::core_access::core(iterator).advance(static_cast< difference_type >(amount));
+	} else {
+		std::advance(iterator, static_cast< difference_type >(amount));
+	}
+}
+
+
+template< typename Core >
+constexpr auto distance(const iterator_facade< Core > &first, const iterator_facade< Core > &last) ->
+	typename iterator_facade< Core >::difference_type {
+	if constexpr (member_functions::has_distance_to_v< Core >) {
+		return details::core_access::core(first).distance_to(details::core_access::core(last));
+	} else {
+		return std::distance(first, last);
+	}
+}
+
+
+template< typename Core >
+constexpr auto next(iterator_facade< Core > iterator, typename iterator_facade< Core >::difference_type amount = 1)
+	-> iterator_facade< Core > {
+	::iterators::advance(iterator, amount);
+	return iterator;
+}
+
+
+template< typename Core >
+constexpr auto prev(iterator_facade< Core > iterator, typename iterator_facade< Core >::difference_type amount = 1)
+	-> iterator_facade< Core > {
+	static_assert(iterator_category::is_at_least_v< typename iterator_facade< Core >::iterator_category,
+													std::bidirectional_iterator_tag >,
+				  "Only bidirectional iterators can be moved backwards");
+
+	::iterators::advance(iterator, -amount);
+	return iterator;
+}
+
+} // namespace iterators
+
+#endif // ITERATORS_ITERATOR_OPERATIONS_HPP_
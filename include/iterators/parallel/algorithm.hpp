@@ -0,0 +1,324 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_PARALLEL_ALGORITHM_HPP_
+#define ITERATORS_PARALLEL_ALGORITHM_HPP_
+
+#include "iterators/parallel/blocked_range.hpp"
+#include "iterators/parallel/thread_pool.hpp"
+#include "iterators/type_traits.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iterators::parallel {
+
+namespace details {
+
+	template< typename Iterator >
+	constexpr bool is_random_access_v =
+		iterator_category::is_at_least_v< typename std::iterator_traits< Iterator >::iterator_category,
+										  std::random_access_iterator_tag >;
+
+	template< typename Iterator > void require_random_access() {
+		static_assert(is_random_access_v< Iterator >,
+					  "Parallel algorithms on iterator pairs require random access iterators. Use a splittable range "
+					  "for other iterator categories.");
+	}
+
+	inline auto log2_ceil(std::size_t value) -> std::size_t {
+		std::size_t result = 0;
+		while ((std::size_t{ 1 } << result) < value) {
+			++result;
+		}
+		return result;
+	}
+
+	// Grain sizes are chosen adaptively: initially, the work is split into roughly eight chunks per worker. Whenever
+	// a chunk gets stolen (which indicates that the load is imbalanced), the thief is allowed to split its chunk
+	// further. Thus, the splitting only gets finer where it is actually needed.
+	inline auto initial_split_depth(const thread_pool &pool) -> std::size_t { return log2_ceil(pool.size()) + 3; }
+	inline auto steal_split_depth(const thread_pool &pool) -> std::size_t { return log2_ceil(pool.size()) + 1; }
+
+	// For algorithms that have to know the chunk boundaries upfront
+	inline auto default_block_size(const thread_pool &pool, std::size_t size) -> std::size_t {
+		const std::size_t blocks = pool.size() * 8;
+		return std::max< std::size_t >(1, (size + blocks - 1) / blocks);
+	}
+
+	template< typename Range, typename Body >
+	void for_each_chunk(task_group &group, Range range, const Body &body, std::size_t depth, std::thread::id owner) {
+		if (std::this_thread::get_id() != owner) {
+			depth += steal_split_depth(group.pool());
+		}
+
+		while (depth > 0 && range.is_divisible()) {
+			Range second_half(range, split{});
+			--depth;
+
+			group.run([&group, &body, second_half = std::move(second_half), depth,
+					   owner = std::this_thread::get_id()]() mutable {
+				for_each_chunk(group, std::move(second_half), body, depth, owner);
+			});
+		}
+
+		if (!range.empty()) {
+			body(range);
+		}
+	}
+
+	template< typename Range, typename Body > void for_each_chunk(thread_pool &pool, Range range, const Body &body) {
+		task_group group(pool);
+		for_each_chunk(group, std::move(range), body, initial_split_depth(pool), std::this_thread::get_id());
+		group.wait();
+	}
+
+	template< typename Result, typename Range, typename Leaf, typename Combine >
+	auto reduce_chunks(thread_pool &pool, Range range, const Leaf &leaf, const Combine &combine, std::size_t depth,
+					   std::thread::id owner) -> std::optional< Result > {
+		if (std::this_thread::get_id() != owner) {
+			depth += steal_split_depth(pool);
+		}
+
+		if (range.empty()) {
+			return std::nullopt;
+		}
+
+		if (depth == 0 || !range.is_divisible()) {
+			return leaf(range);
+		}
+
+		Range second_half(range, split{});
+		std::optional< Result > second_result;
+
+		task_group group(pool);
+		group.run([&, owner = std::this_thread::get_id()]() {
+			second_result = reduce_chunks< Result >(pool, std::move(second_half), leaf, combine, depth - 1, owner);
+		});
+
+		std::optional< Result > first_result =
+			reduce_chunks< Result >(pool, std::move(range), leaf, combine, depth - 1, std::this_thread::get_id());
+
+		group.wait();
+
+		if (!first_result) {
+			return second_result;
+		}
+		if (!second_result) {
+			return first_result;
+		}
+
+		return combine(std::move(*first_result), std::move(*second_result));
+	}
+
+	template< typename Iterator, typename Compare >
+	void merge_sort(thread_pool &pool, Iterator first, Iterator last, const Compare &compare, std::size_t depth) {
+		// Below this size, the overhead of spawning a task outweighs the gain
+		constexpr std::ptrdiff_t minimum_parallel_size = 2048;
+
+		const auto size = last - first;
+		if (depth == 0 || size < minimum_parallel_size) {
+			std::sort(first, last, compare);
+			return;
+		}
+
+		Iterator middle = first + size / 2;
+
+		task_group group(pool);
+		group.run([&]() { merge_sort(pool, first, middle, compare, depth - 1); });
+		merge_sort(pool, middle, last, compare, depth - 1);
+		group.wait();
+
+		std::inplace_merge(first, middle, last, compare);
+	}
+
+} // namespace details
+
+
+// for_each
+
+template< typename Range, typename Function, typename = std::enable_if_t< is_splittable_range_v< Range > > >
+void for_each(thread_pool &pool, Range range, Function function) {
+	details::for_each_chunk(pool, std::move(range), [&function](const Range &chunk) {
+		for (auto &&element : chunk) {
+			function(std::forward< decltype(element) >(element));
+		}
+	});
+}
+
+template< typename Range, typename Function, typename = std::enable_if_t< is_splittable_range_v< Range > > >
+void for_each(Range range, Function function) {
+	for_each(thread_pool::default_instance(), std::move(range), std::move(function));
+}
+
+template< typename Iterator, typename Function >
+void for_each(thread_pool &pool, Iterator first, Iterator last, Function function) {
+	details::require_random_access< Iterator >();
+
+	details::for_each_chunk(pool, blocked_range< Iterator >(first, last),
+							[&function](const blocked_range< Iterator > &chunk) {
+								for (Iterator current = chunk.begin(); current != chunk.end(); ++current) {
+									function(*current);
+								}
+							});
+}
+
+template< typename Iterator, typename Function > void for_each(Iterator first, Iterator last, Function function) {
+	for_each(thread_pool::default_instance(), std::move(first), std::move(last), std::move(function));
+}
+
+
+// transform_reduce
+
+template< typename Range, typename T, typename Reduce, typename Transform,
+		  typename = std::enable_if_t< is_splittable_range_v< Range > > >
+auto transform_reduce(thread_pool &pool, Range range, T init, Reduce reduce, Transform transform) -> T {
+	auto leaf = [&](const Range &chunk) -> std::optional< T > {
+		auto current = chunk.begin();
+		auto end     = chunk.end();
+		if (current == end) {
+			return std::nullopt;
+		}
+
+		T accumulator = transform(*current);
+		for (++current; current != end; ++current) {
+			accumulator = reduce(std::move(accumulator), transform(*current));
+		}
+
+		return accumulator;
+	};
+
+	std::optional< T > result = details::reduce_chunks< T >(pool, std::move(range), leaf, reduce,
+															details::initial_split_depth(pool),
+															std::this_thread::get_id());
+
+	return result ? reduce(std::move(init), std::move(*result)) : init;
+}
+
+template< typename Range, typename T, typename Reduce, typename Transform,
+		  typename = std::enable_if_t< is_splittable_range_v< Range > > >
+auto transform_reduce(Range range, T init, Reduce reduce, Transform transform) -> T {
+	return transform_reduce(thread_pool::default_instance(), std::move(range), std::move(init), std::move(reduce),
+							std::move(transform));
+}
+
+template< typename Iterator, typename T, typename Reduce, typename Transform >
+auto transform_reduce(thread_pool &pool, Iterator first, Iterator last, T init, Reduce reduce, Transform transform)
+	-> T {
+	details::require_random_access< Iterator >();
+
+	return transform_reduce(pool, blocked_range< Iterator >(first, last), std::move(init), std::move(reduce),
+							std::move(transform));
+}
+
+template< typename Iterator, typename T, typename Reduce, typename Transform >
+auto transform_reduce(Iterator first, Iterator last, T init, Reduce reduce, Transform transform) -> T {
+	return transform_reduce(thread_pool::default_instance(), std::move(first), std::move(last), std::move(init),
+							std::move(reduce), std::move(transform));
+}
+
+
+// copy_if
+
+// Copies all elements satisfying the predicate into the (random access) output range, preserving their relative
+// order. The predicate is evaluated exactly once per element.
+template< typename InputIterator, typename OutputIterator, typename Predicate >
+auto copy_if(thread_pool &pool, InputIterator first, InputIterator last, OutputIterator output, Predicate predicate)
+	-> OutputIterator {
+	details::require_random_access< InputIterator >();
+	details::require_random_access< OutputIterator >();
+
+	const auto size = static_cast< std::size_t >(last - first);
+	if (size == 0) {
+		return output;
+	}
+
+	const std::size_t block_size  = details::default_block_size(pool, size);
+	const std::size_t block_count = (size + block_size - 1) / block_size;
+
+	std::vector< unsigned char > selected(size);
+	std::vector< std::size_t > offsets(block_count + 1, 0);
+
+	auto block_bounds = [&](std::size_t block) {
+		return std::make_pair(block * block_size, std::min(size, (block + 1) * block_size));
+	};
+
+	auto for_each_block = [&](const auto &body) {
+		details::for_each_chunk(pool, blocked_range< std::size_t >(0, block_count),
+								[&body](const blocked_range< std::size_t > &chunk) {
+									for (std::size_t block = chunk.begin(); block < chunk.end(); ++block) {
+										body(block);
+									}
+								});
+	};
+
+	// Pass 1: evaluate the predicate and count the selected elements per block
+	for_each_block([&](std::size_t block) {
+		auto [begin, end]   = block_bounds(block);
+		std::size_t matches = 0;
+		for (std::size_t i = begin; i < end; ++i) {
+			selected[i] = predicate(first[static_cast< std::ptrdiff_t >(i)]) ? 1 : 0;
+			matches += selected[i];
+		}
+		offsets[block + 1] = matches;
+	});
+
+	// Pass 2: turn the counts into output offsets (there are only few blocks, so this is done serially)
+	std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+	// Pass 3: copy the selected elements to their final position
+	for_each_block([&](std::size_t block) {
+		auto [begin, end]      = block_bounds(block);
+		OutputIterator current = output + static_cast< std::ptrdiff_t >(offsets[block]);
+		for (std::size_t i = begin; i < end; ++i) {
+			if (selected[i]) {
+				*current = first[static_cast< std::ptrdiff_t >(i)];
+				++current;
+			}
+		}
+	});
+
+	return output + static_cast< std::ptrdiff_t >(offsets.back());
+}
+
+template< typename InputIterator, typename OutputIterator, typename Predicate >
+auto copy_if(InputIterator first, InputIterator last, OutputIterator output, Predicate predicate) -> OutputIterator {
+	return copy_if(thread_pool::default_instance(), std::move(first), std::move(last), std::move(output),
+				   std::move(predicate));
+}
+
+
+// sort
+
+// Sorts the given range via a parallel merge sort. Like std::sort, the sort is not stable.
+template< typename Iterator, typename Compare >
+void sort(thread_pool &pool, Iterator first, Iterator last, Compare compare) {
+	details::require_random_access< Iterator >();
+
+	details::merge_sort(pool, std::move(first), std::move(last), compare, details::initial_split_depth(pool));
+}
+
+template< typename Iterator > void sort(thread_pool &pool, Iterator first, Iterator last) {
+	sort(pool, std::move(first), std::move(last), std::less<>{});
+}
+
+template< typename Iterator, typename Compare > void sort(Iterator first, Iterator last, Compare compare) {
+	sort(thread_pool::default_instance(), std::move(first), std::move(last), std::move(compare));
+}
+
+template< typename Iterator > void sort(Iterator first, Iterator last) {
+	sort(thread_pool::default_instance(), std::move(first), std::move(last), std::less<>{});
+}
+
+} // namespace iterators::parallel
+
+#endif // ITERATORS_PARALLEL_ALGORITHM_HPP_
@@ -0,0 +1,80 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_PARALLEL_BLOCKED_RANGE_HPP_
+#define ITERATORS_PARALLEL_BLOCKED_RANGE_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace iterators::parallel {
+
+// Tag type used to select the splitting constructor of a splittable range
+struct split {};
+
+namespace details {
+
+	template< typename T > using empty_type        = decltype(std::declval< const T & >().empty());
+	template< typename T > using is_divisible_type = decltype(std::declval< const T & >().is_divisible());
+
+	template< typename Value > auto offset_by(Value value, std::size_t amount) -> Value {
+		if constexpr (std::is_integral_v< Value >) {
+			return static_cast< Value >(value + static_cast< Value >(amount));
+		} else {
+			return value + static_cast< typename std::iterator_traits< Value >::difference_type >(amount);
+		}
+	}
+
+} // namespace details
+
+// A range is splittable if it can report whether it is empty, whether it is worth splitting further and if it can
+// be split into two halves via a constructor of the form Range(Range &, split). The splitting constructor has to
+// leave the first half in the passed range and initialize the new object with the second half.
+template< typename Range, typename = void > struct is_splittable_range : std::false_type {};
+
+template< typename Range >
+struct is_splittable_range<
+	Range, std::enable_if_t< std::is_convertible_v< details::empty_type< Range >, bool >
+							 && std::is_convertible_v< details::is_divisible_type< Range >, bool >
+							 && std::is_constructible_v< Range, Range &, split > > > : std::true_type {};
+
+template< typename Range > constexpr bool is_splittable_range_v = is_splittable_range< Range >::value;
+
+
+// A splittable range over either integers or random access iterators. The range is divided in halves until its
+// size drops to the given grain size.
+template< typename Value > class blocked_range {
+public:
+	using value_type = Value;
+	using size_type  = std::size_t;
+
+	blocked_range(Value begin, Value end, size_type grain_size = 1)
+		: m_begin(std::move(begin)), m_end(std::move(end)), m_grain_size(grain_size > 0 ? grain_size : 1) {}
+
+	blocked_range(blocked_range &other, split)
+		: m_begin(details::offset_by(other.m_begin, other.size() / 2)), m_end(other.m_end),
+		  m_grain_size(other.m_grain_size) {
+		other.m_end = m_begin;
+	}
+
+	[[nodiscard]] auto begin() const -> Value { return m_begin; }
+	[[nodiscard]] auto end() const -> Value { return m_end; }
+
+	[[nodiscard]] auto size() const -> size_type { return static_cast< size_type >(m_end - m_begin); }
+	[[nodiscard]] auto grain_size() const -> size_type { return m_grain_size; }
+
+	[[nodiscard]] auto empty() const -> bool { return !(m_begin < m_end); }
+	[[nodiscard]] auto is_divisible() const -> bool { return size() > m_grain_size; }
+
+private:
+	Value m_begin;
+	Value m_end;
+	size_type m_grain_size;
+};
+
+} // namespace iterators::parallel
+
+#endif // ITERATORS_PARALLEL_BLOCKED_RANGE_HPP_
@@ -0,0 +1,236 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_PARALLEL_READAHEAD_HPP_
+#define ITERATORS_PARALLEL_READAHEAD_HPP_
+
+#include "iterators/core_traits.hpp"
+#include "iterators/iterator_facade.hpp"
+#include "iterators/range.hpp"
+#include "iterators/type_traits.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iterators::parallel {
+
+namespace details {
+
+	// The state shared between the consumer(s) of a readahead_core and its producer thread. The producer runs the
+	// underlying core and copies its elements into a ring of blocks. Block n is stored in slot n % block_count, so the
+	// producer may only (re)fill a slot once the consumer has released the block that previously occupied it.
+	template< typename Core > class readahead_state {
+	public:
+		using value_type = typename core_traits< Core >::value_type;
+		using block_type = std::vector< value_type >;
+
+		readahead_state(Core current, Core end, std::size_t block_size, std::size_t block_count)
+			: m_blocks(block_count), m_block_size(block_size) {
+			for (block_type &block : m_blocks) {
+				block.reserve(block_size);
+			}
+
+			m_thread = std::thread([this, current = std::move(current), end = std::move(end)]() mutable {
+				produce(current, end);
+			});
+		}
+
+		readahead_state(const readahead_state &) = delete;
+		auto operator=(const readahead_state &) -> readahead_state & = delete;
+
+		// Cancels the producer (which notices this after having produced at most one more element) and waits for it
+		~readahead_state() {
+			m_cancelled.store(true, std::memory_order_relaxed);
+			{
+				std::lock_guard< std::mutex > guard(m_mutex);
+			}
+			m_block_released.notify_one();
+			m_thread.join();
+		}
+
+		// Waits for the block with the given number (blocks have to be acquired in order) and releases all blocks
+		// preceding its predecessor. The predecessor is kept alive so that copies of an iterator that has just moved on
+		// to the next block (e.g. the result of a postfix increment) remain dereferenceable. Returns nullptr after
+		// the last block and rethrows the exception that stopped the producer, if any.
+		auto acquire(std::size_t number) -> const block_type * {
+			std::unique_lock< std::mutex > lock(m_mutex);
+
+			if (number > m_released + 1) {
+				m_released = number - 1;
+				m_block_released.notify_one();
+			}
+
+			m_block_produced.wait(lock, [&]() { return m_produced > number || m_finished; });
+
+			if (m_produced > number) {
+				return &m_blocks[number % m_blocks.size()];
+			}
+			if (m_error) {
+				std::rethrow_exception(std::exchange(m_error, nullptr));
+			}
+			return nullptr;
+		}
+
+	private:
+		std::vector< block_type > m_blocks;
+		std::size_t m_block_size;
+		std::thread m_thread;
+		std::mutex m_mutex;
+		std::condition_variable m_block_produced;
+		std::condition_variable m_block_released;
+		// Amount of blocks that have been produced / released so far
+		std::size_t m_produced = 0;
+		std::size_t m_released = 0;
+		bool m_finished        = false;
+		std::exception_ptr m_error;
+		std::atomic< bool > m_cancelled = false;
+
+		void produce(Core &current, const Core &end) {
+			std::exception_ptr error;
+			block_type *block = nullptr;
+
+			try {
+				while (!current.equals(end)) {
+					block = wait_for_free_block();
+					if (block == nullptr) {
+						return;
+					}
+
+					block->clear();
+					while (block->size() < m_block_size && !current.equals(end)) {
+						block->push_back(current.dereference());
+						current.increment();
+
+						if (m_cancelled.load(std::memory_order_relaxed)) {
+							return;
+						}
+					}
+
+					publish();
+					block = nullptr;
+				}
+			} catch (...) {
+				error = std::current_exception();
+			}
+
+			std::lock_guard< std::mutex > guard(m_mutex);
+			// The elements produced before the exception occurred are still delivered
+			if (block != nullptr && !block->empty()) {
+				++m_produced;
+			}
+			m_error    = std::move(error);
+			m_finished = true;
+			m_block_produced.notify_one();
+		}
+
+		auto wait_for_free_block() -> block_type * {
+			std::unique_lock< std::mutex > lock(m_mutex);
+			m_block_released.wait(lock, [&]() {
+				return m_produced - m_released < m_blocks.size() || m_cancelled.load(std::memory_order_relaxed);
+			});
+
+			if (m_cancelled.load(std::memory_order_relaxed)) {
+				return nullptr;
+			}
+			return &m_blocks[m_produced % m_blocks.size()];
+		}
+
+		void publish() {
+			{
+				std::lock_guard< std::mutex > guard(m_mutex);
+				++m_produced;
+			}
+			m_block_produced.notify_one();
+		}
+	};
+
+} // namespace details
+
+// An input core that runs another core on a background thread. The underlying core's elements are copied into a ring
+// of blocks ahead of time, so that a consumer iterating over a slow source (pipes, decompression, decoding, ...) only
+// has to wait if it is faster than the source. Elements are handed over a block at a time in order to keep the
+// synchronization overhead per element negligible.
+//
+// The background thread is started on construction and stopped once the last copy of the core has been destroyed (so
+// abandoning an iteration cancels the read-ahead). If the underlying core throws, all elements produced before are
+// still delivered and the exception is then rethrown from the increment that would have moved past them (or from the
+// constructor, if no element could be produced at all).
+//
+// Copies of the core share the read-ahead state and, as for any input iterator, only the most recently incremented
+// copy may be used for further iteration.
+template< typename Core > class readahead_core {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+	using value_type               = typename core_traits< Core >::value_type;
+
+	static constexpr std::size_t default_block_size  = 1024;
+	static constexpr std::size_t default_block_count = 4;
+
+	// Creates the past-the-end core
+	readahead_core() = default;
+
+	// Starts reading ahead over [begin, end). At least three blocks are used, as the consumer may hold on to two of
+	// them at a time.
+	readahead_core(Core begin, Core end, std::size_t block_size = default_block_size,
+				   std::size_t block_count = default_block_count)
+		: m_state(std::make_shared< details::readahead_state< Core > >(
+			std::move(begin), std::move(end), std::max< std::size_t >(block_size, 1),
+			std::max< std::size_t >(block_count, 3))) {
+		m_block = m_state->acquire(0);
+	}
+
+	[[nodiscard]] auto dereference() const -> const value_type & { return (*m_block)[m_index]; }
+
+	// All cores that have reached the end compare equal (including default-constructed ones)
+	[[nodiscard]] auto equals(const readahead_core &other) const -> bool {
+		return (m_block == nullptr) == (other.m_block == nullptr);
+	}
+
+	void increment() {
+		if (++m_index == m_block->size()) {
+			m_index = 0;
+			m_block = m_state->acquire(++m_block_number);
+		}
+	}
+
+private:
+	std::shared_ptr< details::readahead_state< Core > > m_state;
+	const std::vector< value_type > *m_block = nullptr;
+	std::size_t m_block_number               = 0;
+	std::size_t m_index                      = 0;
+};
+
+template< typename Core > using readahead_iterator = iterator_facade< readahead_core< Core > >;
+
+// Reads ahead over the elements between the given cores
+template< typename Core, typename = std::enable_if_t< !is_iterator_facade_v< Core > > >
+auto readahead(Core begin, Core end, std::size_t block_size = readahead_core< Core >::default_block_size,
+			   std::size_t block_count = readahead_core< Core >::default_block_count)
+	-> range< readahead_core< Core > > {
+	return { readahead_core< Core >(std::move(begin), std::move(end), block_size, block_count),
+			 readahead_core< Core >() };
+}
+
+// Reads ahead over the elements between the given iterators
+template< typename Core >
+auto readahead(const iterator_facade< Core > &begin, const iterator_facade< Core > &end,
+			   std::size_t block_size  = readahead_core< Core >::default_block_size,
+			   std::size_t block_count = readahead_core< Core >::default_block_count) -> range< readahead_core< Core > > {
+	return readahead(::iterators::details::core_access::core(begin), ::iterators::details::core_access::core(end),
+					 block_size, block_count);
+}
+
+} // namespace iterators::parallel
+
+#endif // ITERATORS_PARALLEL_READAHEAD_HPP_
@@ -0,0 +1,375 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_PARALLEL_SPSC_RING_HPP_
+#define ITERATORS_PARALLEL_SPSC_RING_HPP_
+
+#include "iterators/iterator_facade.hpp"
+#include "iterators/range.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#	include <intrin.h>
+#endif
+
+namespace iterators::parallel {
+
+// How the two ends of an spsc_ring wait for each other, i.e. the consumer for elements and the producer for space
+enum class wait_policy {
+	// Busy-wait, yielding the time slice every now and then. Lowest latency as long as both threads have a core of
+	// their own, but burns CPU time while waiting.
+	spin,
+	// Spin briefly, then sleep on a condition variable. Waking the other end costs a system call, but only if it is
+	// actually asleep.
+	block,
+};
+
+template< typename T, wait_policy Policy > class spsc_ring;
+
+namespace details {
+
+	// The size of the region that is transferred between caches as a whole. Data written by different threads is kept
+	// at least this far apart, so that the threads don't invalidate each other's cache lines (false sharing).
+	inline constexpr std::size_t cache_line_size = 64;
+
+	inline void cpu_relax() noexcept {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+		__builtin_ia32_pause();
+#elif defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+		_mm_pause();
+#endif
+	}
+
+	// What writing to (the dereferenced) output iterator of an spsc_ring does: push the element
+	template< typename T, wait_policy Policy > class spsc_slot_writer {
+	public:
+		explicit spsc_slot_writer(spsc_ring< T, Policy > &ring) noexcept : m_ring(&ring) {}
+
+		auto operator=(const T &element) const -> const spsc_slot_writer & {
+			m_ring->push(element);
+			return *this;
+		}
+
+		auto operator=(T &&element) const -> const spsc_slot_writer & {
+			m_ring->push(std::move(element));
+			return *this;
+		}
+
+	private:
+		spsc_ring< T, Policy > *m_ring;
+	};
+
+} // namespace details
+
+// The producer side of an spsc_ring, an output core that pushes everything assigned to it. As for
+// std::back_insert_iterator, incrementing does nothing, so that both *it = x; ++it; and *it++ = x; push exactly once.
+template< typename T, wait_policy Policy = wait_policy::block > class spsc_writer_core {
+public:
+	using target_iterator_category = std::output_iterator_tag;
+
+	explicit spsc_writer_core(spsc_ring< T, Policy > &ring) noexcept : m_ring(&ring) {}
+
+	[[nodiscard]] auto dereference() const noexcept -> details::spsc_slot_writer< T, Policy > {
+		return details::spsc_slot_writer< T, Policy >(*m_ring);
+	}
+
+	void increment() noexcept {}
+
+private:
+	spsc_ring< T, Policy > *m_ring;
+};
+
+// The consumer side of an spsc_ring, an input core yielding the pushed elements until the ring is closed. The core
+// keeps track of its position itself and acquires all elements that have been published at once, so it only touches
+// the shared indices whenever it runs out of acquired elements or has consumed another batch. Elements may be moved
+// out of the ring.
+//
+// Consumed elements are released to the producer in batches, except for the most recently consumed one, so that
+// copies of an iterator that has just moved on (e.g. the result of a postfix increment) remain dereferenceable. Only
+// the most recently incremented copy may be used for further iteration. A default-constructed core marks the end.
+template< typename T, wait_policy Policy = wait_policy::block > class spsc_reader_core {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+
+	spsc_reader_core() = default;
+	explicit spsc_reader_core(spsc_ring< T, Policy > &ring) noexcept : m_ring(&ring) {}
+
+	[[nodiscard]] auto dereference() const -> T & {
+		if (m_position >= m_limit) {
+			acquire();
+		}
+		return m_ring->slot(m_position);
+	}
+
+	// Waits until the next element has been pushed or the ring has been closed
+	[[nodiscard]] auto equals(const spsc_reader_core &other) const -> bool { return at_end() == other.at_end(); }
+
+	void increment() {
+		++m_position;
+		if (m_position - m_released > m_ring->batch_size()) {
+			release();
+		}
+	}
+
+private:
+	spsc_ring< T, Policy > *m_ring = nullptr;
+	std::size_t m_position         = 0;
+	// The end of the acquired (published) elements
+	mutable std::size_t m_limit = 0;
+	// The elements before this position have been handed back to the producer
+	mutable std::size_t m_released = 0;
+
+	// A copy of this core may have acquired elements in its stead (e.g. after a postfix increment), so the position can
+	// lie beyond the acquired elements
+	[[nodiscard]] auto at_end() const -> bool { return m_ring == nullptr || (m_position >= m_limit && !acquire()); }
+
+	// Returns false if the ring has been closed and all of its elements have been consumed
+	auto acquire() const -> bool {
+		release();
+		m_limit = m_ring->wait_for_elements(m_position);
+		return m_position != m_limit;
+	}
+
+	void release() const {
+		if (m_position > m_released + 1) {
+			m_released = m_position - 1;
+			m_ring->release(m_released);
+		}
+	}
+};
+
+template< typename T, wait_policy Policy = wait_policy::block >
+using spsc_writer_iterator = iterator_facade< spsc_writer_core< T, Policy > >;
+template< typename T, wait_policy Policy = wait_policy::block >
+using spsc_reader_iterator = iterator_facade< spsc_reader_core< T, Policy > >;
+
+// A bounded single-producer/single-consumer queue that hands elements from one thread to another without locks. The
+// producer pushes elements (e.g. via std::copy to writer()) and finally closes the ring, whereas the consumer iterates
+// over reader() (exactly once) until the ring has been closed and drained.
+//
+// Elements live in a ring of slots that the producer fills and the consumer empties. The only shared state are the
+// indices of the next slot to publish (tail) and the next slot to free up (head), each of which is written by a single
+// thread and resides on a cache line of its own. Both ends cache what they know about the other end's index and work
+// in batches: the producer claims all free slots at once and publishes its elements batch_size at a time (or when it
+// has to wait for space or is flushed), and the consumer symmetrically acquires all published elements at once and
+// releases the consumed slots batch_size at a time. Thus, pushing and consuming an element costs a few plain loads and
+// stores, and the indices bounce between the caches of the two threads once per batch rather than once per element.
+// Latency-sensitive producers flush() after every element they want to be seen right away.
+//
+// T must be default-constructible and move-assignable. The capacity is rounded up to a power of two.
+template< typename T, wait_policy Policy = wait_policy::block > class spsc_ring {
+public:
+	static constexpr std::size_t default_batch_size = 64;
+
+	explicit spsc_ring(std::size_t capacity, std::size_t batch_size = default_batch_size)
+		: m_capacity(round_up_to_power_of_two(std::max< std::size_t >(capacity, 2))),
+		  m_batch_size(std::clamp< std::size_t >(batch_size, 1, m_capacity)), m_slots(new T[m_capacity]),
+		  m_spins(std::thread::hardware_concurrency() > 1 ? max_spins : 0) {}
+
+	spsc_ring(const spsc_ring &) = delete;
+	auto operator=(const spsc_ring &) -> spsc_ring & = delete;
+
+	[[nodiscard]] auto capacity() const noexcept -> std::size_t { return m_capacity; }
+	[[nodiscard]] auto batch_size() const noexcept -> std::size_t { return m_batch_size; }
+
+	// Producer side
+
+	[[nodiscard]] auto writer() noexcept -> spsc_writer_iterator< T, Policy > {
+		return spsc_writer_iterator< T, Policy >(spsc_writer_core< T, Policy >(*this));
+	}
+
+	// Waits for a free slot, if necessary
+	void push(const T &element) {
+		next_slot() = element;
+		produced();
+	}
+
+	void push(T &&element) {
+		next_slot() = std::move(element);
+		produced();
+	}
+
+	// Makes all pushed elements visible to the consumer
+	void flush() {
+		if (m_producer.position != m_producer.published) {
+			publish();
+		}
+	}
+
+	// Flushes and signals the consumer that no more elements will follow
+	void close() {
+		flush();
+		m_closed.store(true, std::memory_order_release);
+		notify(m_consumer_waiting, m_elements_available);
+	}
+
+	// Consumer side
+
+	[[nodiscard]] auto reader() noexcept -> range< spsc_reader_core< T, Policy > > {
+		return { spsc_reader_core< T, Policy >(*this), spsc_reader_core< T, Policy >() };
+	}
+
+private:
+	friend class spsc_reader_core< T, Policy >;
+
+	// State that is only accessed by the producer
+	struct producer_state {
+		// The position of the next element to push
+		std::size_t position = 0;
+		// The end of the slots known to be free
+		std::size_t limit = 0;
+		// The end of the elements visible to the consumer
+		std::size_t published = 0;
+	};
+
+	const std::size_t m_capacity;
+	const std::size_t m_batch_size;
+	const std::unique_ptr< T[] > m_slots;
+	// Spinning is pointless without a second hardware thread, as the other end can't make progress meanwhile
+	const std::size_t m_spins;
+
+	alignas(details::cache_line_size) producer_state m_producer;
+	// Written by the producer only
+	alignas(details::cache_line_size) std::atomic< std::size_t > m_tail = 0;
+	// Written by the consumer only
+	alignas(details::cache_line_size) std::atomic< std::size_t > m_head = 0;
+
+	// Only used for waiting and waking up, rarely touched in the fast path
+	alignas(details::cache_line_size) std::atomic< bool > m_closed = false;
+	std::atomic< bool > m_producer_waiting = false;
+	std::atomic< bool > m_consumer_waiting = false;
+	std::mutex m_mutex;
+	std::condition_variable m_space_available;
+	std::condition_variable m_elements_available;
+
+	// How often a waiting end checks for progress before sleeping (or yielding, when spinning)
+	static constexpr std::size_t max_spins = 128;
+
+	[[nodiscard]] static auto round_up_to_power_of_two(std::size_t value) noexcept -> std::size_t {
+		std::size_t power = 1;
+		while (power < value) {
+			power *= 2;
+		}
+		return power;
+	}
+
+	[[nodiscard]] auto slot(std::size_t position) const noexcept -> T & {
+		return m_slots[position & (m_capacity - 1)];
+	}
+
+	[[nodiscard]] auto next_slot() -> T & {
+		if (m_producer.position == m_producer.limit) {
+			wait_for_space();
+		}
+		return slot(m_producer.position);
+	}
+
+	void produced() {
+		if (++m_producer.position - m_producer.published >= m_batch_size) {
+			publish();
+		}
+	}
+
+	void publish() {
+		m_producer.published = m_producer.position;
+		m_tail.store(m_producer.position, std::memory_order_release);
+		notify(m_consumer_waiting, m_elements_available);
+	}
+
+	void wait_for_space() {
+		m_producer.limit = m_head.load(std::memory_order_acquire) + m_capacity;
+		if (m_producer.position != m_producer.limit) {
+			return;
+		}
+
+		// The consumer might be waiting for the elements that have not been published yet
+		flush();
+		wait(m_producer_waiting, m_space_available, [&]() {
+			m_producer.limit = m_head.load(std::memory_order_acquire) + m_capacity;
+			return m_producer.position != m_producer.limit;
+		});
+	}
+
+	// Hands all slots before the given position back to the producer
+	void release(std::size_t position) {
+		m_head.store(position, std::memory_order_release);
+		notify(m_producer_waiting, m_space_available);
+	}
+
+	// Waits until there are elements at and after the given position or the ring has been closed. Returns the end of
+	// the published elements (which equals position if the ring has been closed and drained).
+	auto wait_for_elements(std::size_t position) -> std::size_t {
+		std::size_t tail = m_tail.load(std::memory_order_acquire);
+		if (tail != position) {
+			return tail;
+		}
+
+		wait(m_consumer_waiting, m_elements_available, [&]() {
+			// Closing publishes all elements before setting the flag, so checking the tail again afterwards is exact
+			const bool closed = m_closed.load(std::memory_order_acquire);
+			tail              = m_tail.load(std::memory_order_acquire);
+			return tail != position || closed;
+		});
+		return tail;
+	}
+
+	template< typename Predicate >
+	void wait(std::atomic< bool > &waiting, std::condition_variable &condition, const Predicate &ready) {
+		for (std::size_t spins = 0;; ++spins) {
+			if (ready()) {
+				return;
+			}
+
+			if constexpr (Policy == wait_policy::spin) {
+				if (spins >= m_spins) {
+					std::this_thread::yield();
+					spins = 0;
+				} else {
+					details::cpu_relax();
+				}
+			} else {
+				if (spins >= m_spins) {
+					break;
+				}
+				details::cpu_relax();
+			}
+		}
+
+		if constexpr (Policy == wait_policy::block) {
+			std::unique_lock< std::mutex > lock(m_mutex);
+			waiting.store(true, std::memory_order_relaxed);
+			// Pairs with the fence in notify: either the other end sees that this end is waiting, or this end sees
+			// what the other end has published
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			condition.wait(lock, ready);
+			waiting.store(false, std::memory_order_relaxed);
+		}
+	}
+
+	void notify(std::atomic< bool > &waiting, std::condition_variable &condition) {
+		if constexpr (Policy == wait_policy::block) {
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (waiting.load(std::memory_order_relaxed)) {
+				{
+					std::lock_guard< std::mutex > guard(m_mutex);
+				}
+				condition.notify_one();
+			}
+		}
+	}
+};
+
+} // namespace iterators::parallel
+
+#endif // ITERATORS_PARALLEL_SPSC_RING_HPP_
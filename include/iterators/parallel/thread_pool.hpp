@@ -0,0 +1,271 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_PARALLEL_THREAD_POOL_HPP_
+#define ITERATORS_PARALLEL_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace iterators::parallel {
+
+class thread_pool;
+
+namespace details {
+
+	using task = std::function< void() >;
+
+	// A double-ended task queue owned by a single worker. The owner pushes and pops at the back (LIFO, which keeps
+	// the working set hot in the owner's cache) whereas other threads steal from the front, where the largest
+	// (least recently split) chunks of work reside.
+	class work_queue {
+	public:
+		void push(task work) {
+			std::lock_guard< std::mutex > guard(m_mutex);
+			m_tasks.push_back(std::move(work));
+		}
+
+		auto pop() -> std::optional< task > {
+			std::lock_guard< std::mutex > guard(m_mutex);
+			if (m_tasks.empty()) {
+				return std::nullopt;
+			}
+
+			task work = std::move(m_tasks.back());
+			m_tasks.pop_back();
+			return work;
+		}
+
+		auto steal() -> std::optional< task > {
+			std::unique_lock< std::mutex > guard(m_mutex, std::try_to_lock);
+			if (!guard.owns_lock() || m_tasks.empty()) {
+				return std::nullopt;
+			}
+
+			task work = std::move(m_tasks.front());
+			m_tasks.pop_front();
+			return work;
+		}
+
+	private:
+		std::mutex m_mutex;
+		std::deque< task > m_tasks;
+	};
+
+	struct worker_context {
+		const thread_pool *pool = nullptr;
+		std::size_t index       = 0;
+	};
+
+	inline thread_local worker_context current_worker;
+
+} // namespace details
+
+// A fixed-size pool of worker threads that balance their load via work-stealing
+class thread_pool {
+public:
+	static auto default_thread_count() -> std::size_t {
+		return std::max< std::size_t >(1, std::thread::hardware_concurrency());
+	}
+
+	// The pool used by all algorithms that are not explicitly given a pool
+	static auto default_instance() -> thread_pool & {
+		static thread_pool pool;
+		return pool;
+	}
+
+	explicit thread_pool(std::size_t thread_count = default_thread_count()) {
+		thread_count = std::max< std::size_t >(1, thread_count);
+
+		m_queues.reserve(thread_count);
+		for (std::size_t i = 0; i < thread_count; ++i) {
+			m_queues.push_back(std::make_unique< details::work_queue >());
+		}
+
+		m_threads.reserve(thread_count);
+		for (std::size_t i = 0; i < thread_count; ++i) {
+			m_threads.emplace_back([this, i]() { worker_loop(i); });
+		}
+	}
+
+	thread_pool(const thread_pool &) = delete;
+	thread_pool(thread_pool &&)      = delete;
+	auto operator=(const thread_pool &) -> thread_pool & = delete;
+	auto operator=(thread_pool &&) -> thread_pool & = delete;
+
+	~thread_pool() {
+		{
+			std::lock_guard< std::mutex > guard(m_sleep_mutex);
+			m_stop = true;
+		}
+		m_wakeup.notify_all();
+
+		for (std::thread &current : m_threads) {
+			current.join();
+		}
+	}
+
+	[[nodiscard]] auto size() const -> std::size_t { return m_threads.size(); }
+
+	// Enqueues the given function for execution. If called from one of this pool's workers, the task is placed
+	// on that worker's own queue, otherwise the queues are filled in a round-robin fashion.
+	template< typename Function > void submit(Function &&function) {
+		std::size_t index = 0;
+		if (details::current_worker.pool == this) {
+			index = details::current_worker.index;
+		} else {
+			index = m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+		}
+
+		m_queues[index]->push(details::task(std::forward< Function >(function)));
+		m_pending.fetch_add(1, std::memory_order_release);
+
+		{
+			// Synchronize with sleeping workers in order to not lose the wake-up
+			std::lock_guard< std::mutex > guard(m_sleep_mutex);
+		}
+		m_wakeup.notify_one();
+	}
+
+	// Executes a single pending task (if any) on the calling thread. Own work is preferred over stolen work.
+	// Returns whether a task has been executed.
+	auto run_pending_task() -> bool {
+		std::optional< details::task > work = take_task();
+		if (!work) {
+			return false;
+		}
+
+		(*work)();
+		return true;
+	}
+
+private:
+	std::vector< std::unique_ptr< details::work_queue > > m_queues;
+	std::vector< std::thread > m_threads;
+	std::atomic< std::size_t > m_pending{ 0 };
+	std::atomic< std::size_t > m_next_queue{ 0 };
+	std::mutex m_sleep_mutex;
+	std::condition_variable m_wakeup;
+	bool m_stop = false;
+
+	auto take_task() -> std::optional< details::task > {
+		if (m_pending.load(std::memory_order_acquire) == 0) {
+			return std::nullopt;
+		}
+
+		const bool is_worker    = details::current_worker.pool == this;
+		const std::size_t start = is_worker ? details::current_worker.index : 0;
+
+		if (is_worker) {
+			if (std::optional< details::task > work = m_queues[start]->pop()) {
+				m_pending.fetch_sub(1, std::memory_order_relaxed);
+				return work;
+			}
+		}
+
+		for (std::size_t i = 0; i < m_queues.size(); ++i) {
+			const std::size_t victim = (start + i + 1) % m_queues.size();
+
+			if (std::optional< details::task > work = m_queues[victim]->steal()) {
+				m_pending.fetch_sub(1, std::memory_order_relaxed);
+				return work;
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	void worker_loop(std::size_t index) {
+		details::current_worker = { this, index };
+
+		while (true) {
+			if (run_pending_task()) {
+				continue;
+			}
+
+			std::unique_lock< std::mutex > guard(m_sleep_mutex);
+			m_wakeup.wait(guard, [this]() { return m_stop || m_pending.load(std::memory_order_acquire) > 0; });
+
+			if (m_stop) {
+				return;
+			}
+		}
+	}
+};
+
+// A set of tasks that can be waited upon as a whole. Waiting threads don't block but help executing pending tasks
+// instead, which makes it safe to wait for a task_group from within another task (fork-join parallelism).
+class task_group {
+public:
+	explicit task_group(thread_pool &pool = thread_pool::default_instance()) : m_pool(pool) {}
+
+	task_group(const task_group &) = delete;
+	task_group(task_group &&)      = delete;
+	auto operator=(const task_group &) -> task_group & = delete;
+	auto operator=(task_group &&) -> task_group & = delete;
+
+	~task_group() {
+		// The spawned tasks reference this object, so we must not go out of scope before they are done
+		help_until_done();
+	}
+
+	template< typename Function > void run(Function &&function) {
+		m_active.fetch_add(1, std::memory_order_relaxed);
+
+		m_pool.submit([this, work = std::forward< Function >(function)]() mutable {
+			try {
+				work();
+			} catch (...) {
+				std::lock_guard< std::mutex > guard(m_error_mutex);
+				if (!m_error) {
+					m_error = std::current_exception();
+				}
+			}
+
+			m_active.fetch_sub(1, std::memory_order_acq_rel);
+		});
+	}
+
+	// Waits for all tasks spawned via run() to finish. If any of them has thrown an exception, the first one is
+	// re-thrown from here.
+	void wait() {
+		help_until_done();
+
+		if (m_error) {
+			std::exception_ptr error = std::exchange(m_error, nullptr);
+			std::rethrow_exception(error);
+		}
+	}
+
+	[[nodiscard]] auto pool() const -> thread_pool & { return m_pool; }
+
+private:
+	thread_pool &m_pool;
+	std::atomic< std::size_t > m_active{ 0 };
+	std::mutex m_error_mutex;
+	std::exception_ptr m_error;
+
+	void help_until_done() {
+		while (m_active.load(std::memory_order_acquire) > 0) {
+			if (!m_pool.run_pending_task()) {
+				std::this_thread::yield();
+			}
+		}
+	}
+};
+
+} // namespace iterators::parallel
+
+#endif // ITERATORS_PARALLEL_THREAD_POOL_HPP_
@@ -0,0 +1,347 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_PIPELINE_HPP_
+#define ITERATORS_PIPELINE_HPP_
+
+#include "iterators/core_traits.hpp"
+#include "iterators/details/semiregular_box.hpp"
+#include "iterators/iterator_facade.hpp"
+#include "iterators/type_traits.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace iterators {
+
+// Pipeline stage applying a function to every element
+template< typename Function > struct transform_stage {
+	details::semiregular_box< Function > function;
+};
+
+// Pipeline stage dropping all elements for which a predicate returns false
+template< typename Predicate > struct filter_stage {
+	details::semiregular_box< Predicate > predicate;
+};
+
+// Pipeline stage passing on only the given amount of elements
+struct take_stage {
+	std::size_t remaining = 0;
+};
+
+template< typename Function > auto transform(Function function) -> transform_stage< Function > {
+	return { std::move(function) };
+}
+
+template< typename Predicate > auto filter(Predicate predicate) -> filter_stage< Predicate > {
+	return { std::move(predicate) };
+}
+
+inline auto take(std::size_t count) -> take_stage {
+	return { count };
+}
+
+namespace details {
+
+	template< typename T > struct is_pipeline_stage : std::false_type {};
+	template< typename F > struct is_pipeline_stage< transform_stage< F > > : std::true_type {};
+	template< typename P > struct is_pipeline_stage< filter_stage< P > > : std::true_type {};
+	template<> struct is_pipeline_stage< take_stage > : std::true_type {};
+
+	template< typename T > constexpr bool is_pipeline_stage_v = is_pipeline_stage< T >::value;
+
+	template< typename T > struct is_filter_stage : std::false_type {};
+	template< typename P > struct is_filter_stage< filter_stage< P > > : std::true_type {};
+
+	template< typename T > constexpr bool is_filter_stage_v = is_filter_stage< T >::value;
+
+	// The type of the elements that leave the given stages when being fed with elements of type Input
+	template< typename Input, typename... Stages > struct pipeline_result { using type = Input; };
+
+	template< typename Input, typename Stage, typename... Stages >
+	struct pipeline_result< Input, Stage, Stages... > : pipeline_result< Input, Stages... > {};
+
+	template< typename Input, typename Function, typename... Stages >
+	struct pipeline_result< Input, transform_stage< Function >, Stages... >
+		: pipeline_result< std::invoke_result_t< const Function &, Input >, Stages... > {};
+
+	template< typename Input, typename... Stages >
+	using pipeline_result_t = typename pipeline_result< Input, Stages... >::type;
+
+	// Whether all elements passed between the given stages are references, i.e. whether no stage produces a temporary
+	// that a later stage might return a reference into
+	template< typename Input, typename... Stages >
+	struct pipeline_passes_references : std::is_reference< Input > {};
+
+	template< typename Input, typename Stage, typename... Stages >
+	struct pipeline_passes_references< Input, Stage, Stages... > : pipeline_passes_references< Input, Stages... > {};
+
+	template< typename Input, typename Function, typename... Stages >
+	struct pipeline_passes_references< Input, transform_stage< Function >, Stages... >
+		: std::conjunction< std::is_reference< Input >,
+							pipeline_passes_references< std::invoke_result_t< const Function &, Input >, Stages... > > {
+	};
+
+	enum class stage_result {
+		// The element made it through all stages
+		accepted,
+		// The element has been dropped by a filter
+		rejected,
+		// A take stage has already passed on all of its elements
+		exhausted,
+	};
+
+	// Feeds the given element through the stages starting at Index and hands it to the consumer if it is accepted by
+	// all of them. The recursion is resolved at compile time, so that all stages are fused into a single function.
+	// last is set once a take stage has passed on its final element, i.e. once no further element can be accepted.
+	template< std::size_t Index, typename Stages, typename Value, typename Consumer >
+	auto run_stages(Stages &stages, bool &last, Value &&value, Consumer &consumer) -> stage_result {
+		if constexpr (Index == std::tuple_size_v< Stages >) {
+			consumer(std::forward< Value >(value));
+			return stage_result::accepted;
+		} else {
+			using stage_type  = std::tuple_element_t< Index, Stages >;
+			stage_type &stage = std::get< Index >(stages);
+
+			if constexpr (std::is_same_v< stage_type, take_stage >) {
+				if (stage.remaining == 0) {
+					return stage_result::exhausted;
+				}
+				if (--stage.remaining == 0) {
+					last = true;
+				}
+				return run_stages< Index + 1 >(stages, last, std::forward< Value >(value), consumer);
+			} else if constexpr (is_filter_stage_v< stage_type >) {
+				if (!stage.predicate(std::as_const(value))) {
+					return stage_result::rejected;
+				}
+				return run_stages< Index + 1 >(stages, last, std::forward< Value >(value), consumer);
+			} else {
+				return run_stages< Index + 1 >(stages, last, stage.function(std::forward< Value >(value)), consumer);
+			}
+		}
+	}
+
+	// The current element of a pipeline_core. References are stored as pointers if they refer to elements outside of
+	// the source core (ByPointer), everything else (values as well as references that only live as long as the source
+	// core) has to be stored as a copy. Otherwise the pointer would dangle once the pipeline core is copied or moved.
+	template< typename T, bool ByPointer = std::is_reference_v< T > > class pipeline_element {
+	public:
+		using reference = T;
+
+		void operator()(T value) { m_element = std::addressof(value); }
+
+		[[nodiscard]] auto get() const -> reference { return static_cast< reference >(*m_element); }
+
+	private:
+		std::remove_reference_t< T > *m_element = nullptr;
+	};
+
+	template< typename T > class pipeline_element< T, false > {
+	public:
+		using value_type = std::remove_cv_t< std::remove_reference_t< T > >;
+		using reference  = const value_type &;
+
+		void operator()(T value) { m_element.emplace(std::forward< T >(value)); }
+
+		[[nodiscard]] auto get() const -> reference { return *m_element; }
+
+	private:
+		std::optional< value_type > m_element;
+	};
+
+	// Makes an arbitrary iterator usable as the source of a pipeline
+	template< typename Iterator > class iterator_core {
+	public:
+		using target_iterator_category = std::conditional_t<
+			iterator_category::is_at_least_v< typename std::iterator_traits< Iterator >::iterator_category,
+											  std::forward_iterator_tag >,
+			std::forward_iterator_tag, std::input_iterator_tag >;
+
+		iterator_core() = default;
+		iterator_core(Iterator iterator) : m_iterator(std::move(iterator)) {}
+
+		[[nodiscard]] auto dereference() const -> typename std::iterator_traits< Iterator >::reference {
+			return *m_iterator;
+		}
+		[[nodiscard]] auto equals(const iterator_core &other) const -> bool { return m_iterator == other.m_iterator; }
+		void increment() { ++m_iterator; }
+
+	private:
+		Iterator m_iterator;
+	};
+
+	// Obtains the core of a range's iterator, which is the facade's core for ranges of facades
+	template< typename Iterator > struct source_core {
+		using type = iterator_core< Iterator >;
+
+		static auto get(Iterator iterator) -> type { return type(std::move(iterator)); }
+	};
+
+	template< typename Core > struct source_core< iterator_facade< Core > > {
+		using type = Core;
+
+		static auto get(const iterator_facade< Core > &iterator) -> const Core & {
+			return core_access::core(iterator);
+		}
+	};
+
+	template< typename Range >
+	using source_iterator_t = std::decay_t< decltype(std::begin(std::declval< Range & >())) >;
+
+	template< typename Range > using source_core_t = typename source_core< source_iterator_t< Range > >::type;
+
+} // namespace details
+
+// The core of a pipeline (see pipeline): a single flat core holding the position in the source, the state of all
+// stages and the current element. Incrementing is a single loop over the source that feeds each element through all
+// stages, instead of a stack of nested adaptor cores, each of which performs its own end checks.
+template< typename Core, typename... Stages > class pipeline_core {
+public:
+	using result_type = details::pipeline_result_t< typename core_traits< Core >::reference, Stages... >;
+
+	using target_iterator_category =
+		std::conditional_t< iterator_category::is_at_least_v< typename core_traits< Core >::iterator_category,
+															  std::forward_iterator_tag >,
+							std::forward_iterator_tag, std::input_iterator_tag >;
+
+	// References obtained from single-pass or stashing sources may refer into the source core, and those returned by a
+	// stage may refer into a temporary produced by an earlier stage (see pipeline_element)
+	static constexpr bool stores_pointer =
+		details::pipeline_passes_references< typename core_traits< Core >::reference, Stages... >::value
+		&& std::is_same_v< target_iterator_category, std::forward_iterator_tag >
+		&& !details::is_stashing_core< Core >::value;
+
+	static constexpr bool stashes_elements = !stores_pointer;
+
+	using element_type = details::pipeline_element< result_type, stores_pointer >;
+
+	// Creates the past-the-end core
+	pipeline_core() = default;
+
+	pipeline_core(Core begin, Core end, std::tuple< Stages... > stages)
+		: m_current(std::move(begin)), m_end(std::move(end)), m_stages(std::move(stages)), m_done(false) {
+		find_accepted();
+	}
+
+	[[nodiscard]] auto dereference() const -> typename element_type::reference {
+		return m_element.get();
+	}
+
+	// Two cores are equal if they are both done or if they are at the same position of the source
+	[[nodiscard]] auto equals(const pipeline_core &other) const -> bool {
+		if (m_done || other.m_done) {
+			return m_done == other.m_done;
+		}
+		return m_current.equals(other.m_current);
+	}
+
+	void increment() {
+		if (m_last) {
+			m_done = true;
+			return;
+		}
+
+		m_current.increment();
+		find_accepted();
+	}
+
+private:
+	Core m_current;
+	Core m_end;
+	std::tuple< Stages... > m_stages;
+	element_type m_element;
+	bool m_done = true;
+	bool m_last = false;
+
+	// Moves on to the first element (starting at the current one) that is accepted by all stages
+	void find_accepted() {
+		for (; !m_current.equals(m_end); m_current.increment()) {
+			const details::stage_result result =
+				details::run_stages< 0 >(m_stages, m_last, m_current.dereference(), m_element);
+
+			if (result == details::stage_result::accepted) {
+				return;
+			}
+			if (result == details::stage_result::exhausted || m_last) {
+				break;
+			}
+		}
+
+		m_done = true;
+	}
+};
+
+// A sequence of stages (transform, filter and take) applied to the elements of a source range, which must outlive the
+// pipeline. Pipelines are created with the pipe operator, e.g.
+//
+//     auto squares = numbers | filter(is_odd) | transform(square) | take(10);
+//
+// All stages are fused into a single pipeline_core, which iterates over the source in a single loop. Alternatively,
+// for_each drives the pipeline push-style: every element is handed to a sink right away without storing it in the
+// core, which allows the compiler to fuse the stages and the consumer into a single loop body.
+template< typename Core, typename... Stages > class pipeline {
+public:
+	using core_type      = pipeline_core< Core, Stages... >;
+	using iterator       = iterator_facade< core_type >;
+	using const_iterator = iterator;
+
+	pipeline(Core begin, Core end, std::tuple< Stages... > stages)
+		: m_begin(std::move(begin)), m_end(std::move(end)), m_stages(std::move(stages)) {}
+
+	[[nodiscard]] auto begin() const -> iterator { return core_type(m_begin, m_end, m_stages); }
+	[[nodiscard]] auto end() const -> iterator { return core_type(); }
+
+	// Hands all elements leaving the pipeline to the given sink
+	template< typename Sink > void for_each(Sink sink) const {
+		std::tuple< Stages... > stages = m_stages;
+		bool last                      = false;
+
+		for (Core current = m_begin; !current.equals(m_end); current.increment()) {
+			const details::stage_result result = details::run_stages< 0 >(stages, last, current.dereference(), sink);
+
+			if (result == details::stage_result::exhausted || last) {
+				break;
+			}
+		}
+	}
+
+	template< typename Stage, typename = std::enable_if_t< details::is_pipeline_stage_v< Stage > > >
+	friend auto operator|(pipeline source, Stage stage) -> pipeline< Core, Stages..., Stage > {
+		return { std::move(source.m_begin), std::move(source.m_end),
+				 std::tuple_cat(std::move(source.m_stages), std::make_tuple(std::move(stage))) };
+	}
+
+private:
+	Core m_begin;
+	Core m_end;
+	std::tuple< Stages... > m_stages;
+};
+
+template< typename T > struct is_pipeline : std::false_type {};
+template< typename Core, typename... Stages > struct is_pipeline< pipeline< Core, Stages... > > : std::true_type {};
+
+template< typename T > constexpr bool is_pipeline_v = is_pipeline< T >::value;
+
+// Starts a pipeline over the given range (e.g. a container or a range of iterator facades). The elements are accessed
+// through the range's iterators, so a range owning its elements must outlive the pipeline.
+template< typename Range, typename Stage,
+		  typename =
+			  std::enable_if_t< details::is_pipeline_stage_v< Stage > && !is_pipeline_v< std::decay_t< Range > > > >
+auto operator|(Range &&source, Stage stage) -> pipeline< details::source_core_t< Range >, Stage > {
+	using source_core = details::source_core< details::source_iterator_t< Range > >;
+
+	return { source_core::get(std::begin(source)), source_core::get(std::end(source)),
+			 std::make_tuple(std::move(stage)) };
+}
+
+} // namespace iterators
+
+#endif // ITERATORS_PIPELINE_HPP_
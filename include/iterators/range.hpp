@@ -0,0 +1,161 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#ifndef ITERATORS_RANGE_HPP_
+#define ITERATORS_RANGE_HPP_
+
+#include "iterators/iterator_facade.hpp"
+#include "iterators/type_traits.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<version>)
+#	include <version>
+#endif
+
+#ifdef __cpp_lib_ranges
+#	include <ranges>
+#endif
+
+namespace iterators {
+
+// Whether a subrange knows its size (in constant time)
+enum class subrange_kind : bool { unsized, sized };
+
+namespace details {
+
+	template< typename Iterator, typename Sentinel >
+	using sentinel_subtraction_type = decltype(std::declval< const Sentinel & >() - std::declval< const Iterator & >());
+
+	template< typename Iterator, typename Sentinel, typename = void >
+	struct supports_sentinel_subtraction : std::false_type {};
+	template< typename Iterator, typename Sentinel >
+	struct supports_sentinel_subtraction< Iterator, Sentinel,
+										  std::void_t< sentinel_subtraction_type< Iterator, Sentinel > > >
+		: std::true_type {};
+
+	// Facades don't expose 'operator-' below the random access category, but their core might still be able to
+	// compute distances cheaply
+	template< typename Iterator, typename Sentinel > struct has_core_distance : std::false_type {};
+	template< typename Core >
+	struct has_core_distance< iterator_facade< Core >, iterator_facade< Core > >
+		: member_functions::has_distance_to< Core > {};
+
+	template< typename Iterator, typename Sentinel >
+	constexpr bool is_sized_sentinel_v = std::disjunction_v< supports_sentinel_subtraction< Iterator, Sentinel >,
+															 has_core_distance< Iterator, Sentinel > >;
+
+	template< typename Iterator, typename Sentinel >
+	constexpr auto sentinel_distance(const Iterator &first, const Sentinel &last) {
+		if constexpr (supports_sentinel_subtraction< Iterator, Sentinel >::value) {
+			return last - first;
+		} else {
+			return core_access::core(first).distance_to(core_access::core(last));
+		}
+	}
+
+	template< bool Store, typename Size > class subrange_size_storage {
+	protected:
+		constexpr subrange_size_storage() = default;
+		constexpr subrange_size_storage(Size) {}
+	};
+
+	template< typename Size > class subrange_size_storage< true, Size > {
+	protected:
+		constexpr subrange_size_storage() = default;
+		constexpr subrange_size_storage(Size size) : m_size(size) {}
+
+		Size m_size = 0;
+	};
+
+} // namespace details
+
+// A range delimited by an iterator and a sentinel (which may or may not be of the same type as the iterator).
+//
+// A subrange of the sized kind provides a constant-time size(): either because the size can be computed from the
+// iterator and the sentinel (random access iterators or cores implementing 'distance_to') or because it has been
+// passed to the constructor, in which case it is cached. Unsized subranges only provide empty(), which never needs
+// to compute any distance.
+template< typename Iterator, typename Sentinel = Iterator,
+		  subrange_kind Kind =
+			  details::is_sized_sentinel_v< Iterator, Sentinel > ? subrange_kind::sized : subrange_kind::unsized >
+class subrange
+	: private details::subrange_size_storage<
+		  Kind == subrange_kind::sized && !details::is_sized_sentinel_v< Iterator, Sentinel >,
+		  std::make_unsigned_t< typename std::iterator_traits< Iterator >::difference_type > > {
+	static constexpr bool stores_size =
+		Kind == subrange_kind::sized && !details::is_sized_sentinel_v< Iterator, Sentinel >;
+
+	using storage_type = details::subrange_size_storage<
+		stores_size, std::make_unsigned_t< typename std::iterator_traits< Iterator >::difference_type > >;
+
+public:
+	using iterator        = Iterator;
+	using sentinel        = Sentinel;
+	using difference_type = typename std::iterator_traits< Iterator >::difference_type;
+	using size_type       = std::make_unsigned_t< difference_type >;
+
+	constexpr subrange() = default;
+
+	template< bool Enable = !stores_size, typename = std::enable_if_t< Enable > >
+	constexpr subrange(Iterator begin, Sentinel end) : m_begin(std::move(begin)), m_end(std::move(end)) {}
+
+	template< bool Enable = Kind == subrange_kind::sized, typename = std::enable_if_t< Enable > >
+	constexpr subrange(Iterator begin, Sentinel end, size_type size)
+		: storage_type(size), m_begin(std::move(begin)), m_end(std::move(end)) {
+		if constexpr (!stores_size) {
+			assert(static_cast< size_type >(details::sentinel_distance(m_begin, m_end)) == size);
+		}
+	}
+
+	[[nodiscard]] constexpr auto begin() const -> Iterator { return m_begin; }
+	[[nodiscard]] constexpr auto end() const -> Sentinel { return m_end; }
+
+	[[nodiscard]] constexpr auto empty() const -> bool {
+		if constexpr (stores_size) {
+			return this->m_size == 0;
+		} else {
+			return m_begin == m_end;
+		}
+	}
+
+	template< bool Enable = Kind == subrange_kind::sized, typename = std::enable_if_t< Enable > >
+	[[nodiscard]] constexpr auto size() const -> size_type {
+		if constexpr (stores_size) {
+			return this->m_size;
+		} else {
+			return static_cast< size_type >(details::sentinel_distance(m_begin, m_end));
+		}
+	}
+
+private:
+	Iterator m_begin;
+	Sentinel m_end;
+};
+
+template< typename Iterator, typename Sentinel > subrange(Iterator, Sentinel) -> subrange< Iterator, Sentinel >;
+
+template< typename Iterator, typename Sentinel, typename Size >
+subrange(Iterator, Sentinel, Size) -> subrange< Iterator, Sentinel, subrange_kind::sized >;
+
+
+// The range type of the iterator_facade for the given core
+template< typename Core, typename Sentinel = iterator_facade< Core >,
+		  subrange_kind Kind = details::is_sized_sentinel_v< iterator_facade< Core >, Sentinel > ? subrange_kind::sized
+																								 : subrange_kind::unsized >
+using range = subrange< iterator_facade< Core >, Sentinel, Kind >;
+
+} // namespace iterators
+
+#ifdef __cpp_lib_ranges
+// A subrange only refers to elements it doesn't own, so iterators obtained from it stay valid beyond its lifetime
+template< typename Iterator, typename Sentinel, iterators::subrange_kind Kind >
+inline constexpr bool std::ranges::enable_borrowed_range< iterators::subrange< Iterator, Sentinel, Kind > > = true;
+#endif
+
+#endif // ITERATORS_RANGE_HPP_
@@ -7,6 +7,7 @@
 
 #include "is_semantically_const.hpp"
 
+#include <cstddef>
 #include <iterator>
 #include <type_traits>
 #include <utility>
@@ -38,8 +39,16 @@ namespace member_functions {
 	template< typename T >
 	using distance_to_type = decltype(
 		std::declval< details::as_const_t< T > >().distance_to(std::declval< details::as_const_ref_t< T > >()));
+
+	// The type of the distance passed to 'advance'. Cores are not required to implement 'distance_to' in order to
+	// provide 'advance' (e.g. skip lists can jump ahead cheaply but can't compute distances cheaply).
+	template< typename T, typename = void > struct advance_distance { using type = std::ptrdiff_t; };
+	template< typename T > struct advance_distance< T, std::void_t< distance_to_type< T > > > {
+		using type = distance_to_type< T >;
+	};
+
 	template< typename T >
-	using advance_type = decltype(std::declval< T >().advance(std::declval< distance_to_type< T > >()));
+	using advance_type = decltype(std::declval< T >().advance(std::declval< typename advance_distance< T >::type >()));
 
 	template< typename T, typename = void > struct has_dereference : std::false_type {};
 	template< typename T, typename = void > struct has_equals : std::false_type {};
@@ -55,6 +64,23 @@ namespace member_functions {
 	template< typename T > struct has_advance< T, std::void_t< advance_type< T > > > : std::true_type {};
 	template< typename T > struct has_distance_to< T, std::void_t< distance_to_type< T > > > : std::true_type {};
 
+	// Cores may also be able to compare themselves with (or measure the distance to) cores of a different type, e.g. an
+	// iterator's core with the core of the corresponding const_iterator
+	template< typename T, typename Other >
+	using equals_with_type =
+		decltype(std::declval< details::as_const_t< T > >().equals(std::declval< details::as_const_ref_t< Other > >()));
+	template< typename T, typename Other >
+	using distance_to_with_type = decltype(
+		std::declval< details::as_const_t< T > >().distance_to(std::declval< details::as_const_ref_t< Other > >()));
+
+	template< typename T, typename Other, typename = void > struct has_equals_with : std::false_type {};
+	template< typename T, typename Other, typename = void > struct has_distance_to_with : std::false_type {};
+
+	template< typename T, typename Other >
+	struct has_equals_with< T, Other, std::void_t< equals_with_type< T, Other > > > : std::true_type {};
+	template< typename T, typename Other >
+	struct has_distance_to_with< T, Other, std::void_t< distance_to_with_type< T, Other > > > : std::true_type {};
+
 	template< typename T > constexpr bool has_dereference_v = has_dereference< T >::value;
 	template< typename T > constexpr bool has_equals_v      = has_equals< T >::value;
 	template< typename T > constexpr bool has_increment_v   = has_increment< T >::value;
@@ -62,6 +88,10 @@ namespace member_functions {
 	template< typename T > constexpr bool has_advance_v     = has_advance< T >::value;
 	template< typename T > constexpr bool has_distance_to_v = has_distance_to< T >::value;
 
+	template< typename T, typename Other > constexpr bool has_equals_with_v = has_equals_with< T, Other >::value;
+	template< typename T, typename Other >
+	constexpr bool has_distance_to_with_v = has_distance_to_with< T, Other >::value;
+
 } // namespace member_functions
 
 namespace iterator_category {
@@ -6,6 +6,9 @@
 #define ITERATORS_TESTS_TESTCORE_HPP_
 
 #include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
 
 template< typename Category > struct TestCore {
 	using target_iterator_category = Category;
@@ -21,5 +24,34 @@ private:
 	int val = 0;
 };
 
+// A fully functional core iterating over an array
+template< typename T, typename Category = std::random_access_iterator_tag > struct PointerCore {
+	using target_iterator_category = Category;
+
+	constexpr PointerCore() = default;
+	constexpr PointerCore(T *ptr) : m_ptr(ptr) {}
+
+	[[nodiscard]] constexpr auto dereference() const -> T & { return *m_ptr; }
+	[[nodiscard]] constexpr auto equals(const PointerCore &other) const -> bool { return m_ptr == other.m_ptr; }
+	constexpr void increment() { ++m_ptr; }
+	constexpr void decrement() { --m_ptr; }
+	[[nodiscard]] constexpr auto distance_to(const PointerCore &other) const -> std::ptrdiff_t {
+		return other.m_ptr - m_ptr;
+	}
+	constexpr void advance(std::ptrdiff_t amount) { m_ptr += amount; }
+
+private:
+	T *m_ptr = nullptr;
+};
+
+// Runtime check for tests that get executed. Failures are reported on stdout and make the test exit with an error.
+#define TEST_CHECK(condition)                                                                 \
+	do {                                                                                      \
+		if (!(condition)) {                                                                   \
+			std::printf("%s:%d: check '%s' failed\n", __FILE__, __LINE__, #condition); \
+			std::exit(EXIT_FAILURE);                                                          \
+		}                                                                                     \
+	} while (false)
+
 
 #endif // ITERATORS_TESTS_TESTCORE_HPP_
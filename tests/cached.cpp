@@ -0,0 +1,256 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/cached.hpp>
+#include <iterators/cores/iota.hpp>
+#include <iterators/cores/transform.hpp>
+#include <iterators/iterator_facade.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A random access core computing its elements on every dereference and counting how often it does so. On its own, it
+// could only back an input iterator.
+struct ComputingCore {
+	using target_iterator_category = std::random_access_iterator_tag;
+
+	static inline int computations = 0;
+
+	ComputingCore() = default;
+	ComputingCore(int position) : m_position(position) {}
+
+	[[nodiscard]] auto dereference() const -> std::string {
+		++computations;
+		return std::to_string(m_position * m_position);
+	}
+	[[nodiscard]] auto equals(const ComputingCore &other) const -> bool { return m_position == other.m_position; }
+	void increment() { ++m_position; }
+	void decrement() { --m_position; }
+	[[nodiscard]] auto distance_to(const ComputingCore &other) const -> std::ptrdiff_t {
+		return other.m_position - m_position;
+	}
+	void advance(std::ptrdiff_t amount) { m_position += static_cast< int >(amount); }
+
+private:
+	int m_position = 0;
+};
+
+// An input core computing its elements on every dereference
+struct InputCore {
+	using target_iterator_category = std::input_iterator_tag;
+
+	InputCore() = default;
+	InputCore(int position) : m_position(position) {}
+
+	[[nodiscard]] auto dereference() const -> int {
+		++ComputingCore::computations;
+		return m_position;
+	}
+	[[nodiscard]] auto equals(const InputCore &other) const -> bool { return m_position == other.m_position; }
+	void increment() { ++m_position; }
+
+private:
+	int m_position = 0;
+};
+
+// An input core parsing aggregates without default member initializers ("x y z", one point per string)
+class ParsingCore {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+
+	struct Point {
+		double x;
+		double y;
+		double z;
+	};
+
+	ParsingCore() = default;
+	ParsingCore(const std::string *line) : m_line(line) {}
+
+	[[nodiscard]] auto dereference() const -> Point {
+		char *end = nullptr;
+		Point point{};
+		point.x = std::strtod(m_line->c_str(), &end);
+		point.y = std::strtod(end, &end);
+		point.z = std::strtod(end, &end);
+		return point;
+	}
+	[[nodiscard]] auto equals(const ParsingCore &other) const -> bool { return m_line == other.m_line; }
+	void increment() { ++m_line; }
+
+private:
+	const std::string *m_line = nullptr;
+};
+
+// Reads the cached elements through operator->. GCC used to report them as maybe uninitialized when the iterators were
+// copied from a range and the result escaped (as in a benchmark loop), which is checked by compiling this test with
+// warnings as errors (see CMakeLists.txt).
+template< typename Iterator > auto sum_norms(Iterator first, Iterator last) -> double {
+	double sum = 0;
+	for (; first != last; ++first) {
+		sum += first->x * first->x + first->y * first->y + first->z * first->z;
+	}
+	return sum;
+}
+
+template< typename T > void escape(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void *sink = nullptr;
+	sink                             = &value;
+#endif
+}
+
+using Iterator = iterators::cached_iterator< ComputingCore >;
+
+static_assert(std::is_same_v< Iterator::reference, const std::string & >);
+static_assert(std::is_same_v< Iterator::pointer, const std::string * >);
+static_assert(std::is_same_v< Iterator::iterator_category, std::random_access_iterator_tag >);
+static_assert(std::is_same_v< decltype(std::declval< const Iterator & >()[0]), std::string >,
+			  "Random access to cached elements must return copies");
+static_assert(std::is_same_v< iterators::cached_iterator< InputCore >::iterator_category, std::input_iterator_tag >);
+
+// No storage overhead (and no loss of random access) for cores yielding references
+static_assert(sizeof(iterators::cached_core< PointerCore< int > >) == sizeof(PointerCore< int >));
+static_assert(std::is_same_v< iterators::cached_iterator< PointerCore< int > >::reference, int & >);
+static_assert(std::is_same_v< iterators::cached_iterator< PointerCore< int > >::iterator_category,
+							  std::random_access_iterator_tag >);
+
+int main() {
+	// Every position is computed at most once
+	{
+		ComputingCore::computations = 0;
+		Iterator it(ComputingCore(3));
+
+		TEST_CHECK(*it == "9");
+		TEST_CHECK(it->size() == 1);
+		TEST_CHECK((*it)[0] == '9');
+		TEST_CHECK(ComputingCore::computations == 1);
+
+		++it;
+		TEST_CHECK(ComputingCore::computations == 1);
+		TEST_CHECK(*it == "16" && it->size() == 2);
+		TEST_CHECK(ComputingCore::computations == 2);
+
+		--it;
+		TEST_CHECK(*it == "9" && *it == "9");
+		TEST_CHECK(ComputingCore::computations == 3);
+
+		std::advance(it, 0);
+		TEST_CHECK(*it == "9");
+		TEST_CHECK(ComputingCore::computations == 3);
+
+		std::advance(it, 7);
+		TEST_CHECK(*it == "100" && *it == "100");
+		TEST_CHECK(ComputingCore::computations == 4);
+	}
+
+	// Copies are independent of each other
+	{
+		ComputingCore::computations = 0;
+		Iterator it(ComputingCore(2));
+		TEST_CHECK(*it == "4");
+
+		Iterator copy = it++;
+		TEST_CHECK(*copy == "4");
+		TEST_CHECK(ComputingCore::computations == 1);
+		TEST_CHECK(*it == "9");
+
+		copy = it;
+		++it;
+		TEST_CHECK(*copy == "9" && *it == "16");
+		TEST_CHECK(ComputingCore::computations == 3);
+		TEST_CHECK(std::distance(copy, it) == 1);
+	}
+
+	// Random access
+	{
+		ComputingCore::computations = 0;
+		const Iterator begin(ComputingCore(0));
+		const Iterator end(ComputingCore(10));
+
+		TEST_CHECK(begin[4] == "16" && begin[9] == "81");
+		TEST_CHECK(end - begin == 10);
+		TEST_CHECK(*(begin + 3) == "9" && *(end - 1) == "81");
+		TEST_CHECK(begin < end);
+		TEST_CHECK(ComputingCore::computations == 4);
+	}
+
+	// Ranges
+	{
+		ComputingCore::computations = 0;
+		std::vector< std::string > squares;
+		for (const std::string &square : iterators::cached(ComputingCore(0), ComputingCore(4))) {
+			if (!square.empty()) {
+				squares.push_back(square);
+			}
+		}
+		TEST_CHECK(squares == (std::vector< std::string >{ "0", "1", "4", "9" }));
+		TEST_CHECK(ComputingCore::computations == 4);
+	}
+
+	// Ranges of aggregates read through operator->
+	{
+		const std::vector< std::string > lines = { "1 2 3", "4 5 6" };
+		const auto points = iterators::cached(ParsingCore(lines.data()), ParsingCore(lines.data() + lines.size()));
+
+		double sum   = 0;
+		auto measure = [&]() {
+			sum = sum_norms(points.begin(), points.end());
+			escape(sum);
+		};
+		for (int i = 0; i < 2; ++i) {
+			measure();
+		}
+		TEST_CHECK(sum == 1 + 4 + 9 + 16 + 25 + 36);
+	}
+
+	// Input cores
+	{
+		ComputingCore::computations = 0;
+		iterators::cached_iterator< InputCore > it(InputCore(5));
+		const iterators::cached_iterator< InputCore > end(InputCore(8));
+
+		int sum = 0;
+		for (; it != end; ++it) {
+			sum += *it + *it;
+		}
+		TEST_CHECK(sum == 2 * (5 + 6 + 7));
+		TEST_CHECK(ComputingCore::computations == 3);
+	}
+
+	// Cores yielding references are forwarded to
+	{
+		std::vector< int > numbers = { 1, 2, 3 };
+		const iterators::iterator_facade< PointerCore< int > > begin(numbers.data());
+		const iterators::iterator_facade< PointerCore< int > > end(numbers.data() + numbers.size());
+
+		auto range = iterators::cached(begin, end);
+		for (int &number : range) {
+			number *= 2;
+		}
+		TEST_CHECK(numbers == (std::vector< int >{ 2, 4, 6 }));
+		TEST_CHECK(&range.begin()[2] == &numbers[2]);
+	}
+
+	// Forwarded references may refer into the underlying core, in which case operator[] has to return copies
+	{
+		auto range = iterators::cached(
+			iterators::transformed(iterators::iota(0, 10), [](int number) { return std::to_string(number); }));
+		static_assert(std::is_same_v< decltype(range.begin()[3]), std::string >);
+
+		TEST_CHECK(range.begin()[3] == "3");
+		TEST_CHECK(std::string(range.begin()[7]) == "7");
+	}
+
+	return 0;
+}
@@ -2,8 +2,13 @@
 // be found in the LICENSE file at the root of the source tree or at
 // <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
 
+#include "TestCore.hpp"
+
 #include <iterators/iterator_facade.hpp>
 
+#include <cstddef>
+#include <iterator>
+
 template< typename Category > struct MutableCore1 {
 	using target_iterator_category = Category;
 
@@ -130,6 +135,131 @@ template< template< typename > class MutableCore, template< typename > class Con
 	}
 };
 
+// Cores over an array that count how often they are copied (or converted). The const core implements equals and
+// distance_to for the mutable core as well, so mixed comparisons and subtractions don't need to convert.
+static std::size_t core_copies = 0;
+
+template< typename Category > struct CountingConstCore;
+
+template< typename Category > struct CountingCore {
+	using target_iterator_category = Category;
+
+	CountingCore() = default;
+	CountingCore(int *ptr) : m_ptr(ptr) {}
+	CountingCore(const CountingCore &other) : m_ptr(other.m_ptr) { ++core_copies; }
+	CountingCore(CountingCore &&) noexcept = default;
+
+	auto operator=(const CountingCore &other) -> CountingCore & {
+		++core_copies;
+		m_ptr = other.m_ptr;
+		return *this;
+	}
+	auto operator=(CountingCore &&) noexcept -> CountingCore & = default;
+	~CountingCore()                                              = default;
+
+	[[nodiscard]] auto dereference() const -> int & { return *m_ptr; }
+	[[nodiscard]] auto equals(const CountingCore &other) const -> bool { return m_ptr == other.m_ptr; }
+	void increment() { ++m_ptr; }
+	void decrement() { --m_ptr; }
+	[[nodiscard]] auto distance_to(const CountingCore &other) const -> std::ptrdiff_t { return other.m_ptr - m_ptr; }
+	void advance(std::ptrdiff_t offset) { m_ptr += offset; }
+
+private:
+	int *m_ptr = nullptr;
+
+	friend struct CountingConstCore< Category >;
+};
+
+template< typename Category > struct CountingConstCore {
+	using target_iterator_category = Category;
+
+	CountingConstCore() = default;
+	CountingConstCore(const int *ptr) : m_ptr(ptr) {}
+	CountingConstCore(const CountingCore< Category > &other) : m_ptr(other.m_ptr) { ++core_copies; }
+	CountingConstCore(const CountingConstCore &other) : m_ptr(other.m_ptr) { ++core_copies; }
+	CountingConstCore(CountingConstCore &&) noexcept = default;
+
+	auto operator=(const CountingConstCore &other) -> CountingConstCore & {
+		++core_copies;
+		m_ptr = other.m_ptr;
+		return *this;
+	}
+	auto operator=(CountingConstCore &&) noexcept -> CountingConstCore & = default;
+	~CountingConstCore()                                                   = default;
+
+	[[nodiscard]] auto dereference() const -> const int & { return *m_ptr; }
+	[[nodiscard]] auto equals(const CountingConstCore &other) const -> bool { return m_ptr == other.m_ptr; }
+	[[nodiscard]] auto equals(const CountingCore< Category > &other) const -> bool { return m_ptr == other.m_ptr; }
+	void increment() { ++m_ptr; }
+	void decrement() { --m_ptr; }
+	[[nodiscard]] auto distance_to(const CountingConstCore &other) const -> std::ptrdiff_t {
+		return other.m_ptr - m_ptr;
+	}
+	[[nodiscard]] auto distance_to(const CountingCore< Category > &other) const -> std::ptrdiff_t {
+		return other.m_ptr - m_ptr;
+	}
+	void advance(std::ptrdiff_t offset) { m_ptr += offset; }
+
+private:
+	const int *m_ptr = nullptr;
+};
+
+// Mixed comparisons need equals (in either direction), mixed subtraction and ordering need distance_to
+template< typename Category > void test_mixed_equality() {
+	using Iterator      = iterators::iterator_facade< CountingCore< Category > >;
+	using ConstIterator = iterators::iterator_facade< CountingConstCore< Category > >;
+
+	int values[] = { 1, 2, 3 };
+
+	Iterator it(&values[0]);
+	ConstIterator cit(&values[0]);
+	ConstIterator cend(&values[3]);
+
+	core_copies = 0;
+
+	TEST_CHECK(it == cit);
+	TEST_CHECK(cit == it);
+	TEST_CHECK(!(it != cit));
+	TEST_CHECK(!(cit != it));
+	TEST_CHECK(it != cend);
+	TEST_CHECK(cend != it);
+
+	TEST_CHECK(core_copies == 0);
+}
+
+void test_mixed_arithmetic() {
+	using Category      = std::random_access_iterator_tag;
+	using Iterator      = iterators::iterator_facade< CountingCore< Category > >;
+	using ConstIterator = iterators::iterator_facade< CountingConstCore< Category > >;
+
+	int values[] = { 1, 2, 3, 4 };
+
+	Iterator first(&values[1]);
+	ConstIterator cfirst(&values[1]);
+	ConstIterator clast(&values[3]);
+
+	core_copies = 0;
+
+	TEST_CHECK(clast - first == 2);
+	TEST_CHECK(first - clast == -2);
+	TEST_CHECK(cfirst - first == 0);
+
+	TEST_CHECK(first < clast);
+	TEST_CHECK(!(clast < first));
+	TEST_CHECK(first <= cfirst);
+	TEST_CHECK(cfirst <= first);
+	TEST_CHECK(clast > first);
+	TEST_CHECK(!(first > cfirst));
+	TEST_CHECK(clast >= first);
+	TEST_CHECK(first >= cfirst);
+
+	TEST_CHECK(core_copies == 0);
+
+	// Conversions still work (and copy, of course)
+	ConstIterator converted(first);
+	TEST_CHECK(converted == cfirst);
+	TEST_CHECK(core_copies == 1);
+}
 
 int main() {
 	ConstConversionTester< MutableCore1, ConstCore1 > tester1;
@@ -137,4 +267,13 @@ int main() {
 
 	tester1.test_conversions();
 	tester2.test_conversions();
+
+	test_mixed_equality< std::input_iterator_tag >();
+	test_mixed_equality< std::forward_iterator_tag >();
+	test_mixed_equality< std::bidirectional_iterator_tag >();
+	test_mixed_equality< std::random_access_iterator_tag >();
+
+	test_mixed_arithmetic();
+
+	return 0;
 }
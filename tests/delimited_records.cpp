@@ -0,0 +1,97 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/delimited_records.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+static_assert(std::is_same_v< iterators::delimited_record_iterator::iterator_category, std::input_iterator_tag >);
+static_assert(std::is_same_v< iterators::delimited_record_iterator::reference, std::string_view >);
+
+auto read_records(const std::string &content, char delimiter, std::size_t buffer_size) -> std::vector< std::string > {
+	const std::string path = (std::filesystem::temp_directory_path() / "iterators_delimited_records_test.txt").string();
+	{
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		stream << content;
+	}
+
+	std::vector< std::string > records;
+	const int descriptor = ::open(path.c_str(), O_RDONLY);
+	TEST_CHECK(descriptor >= 0);
+	{
+		iterators::delimited_reader reader(descriptor, delimiter, buffer_size);
+		for (std::string_view record : reader) {
+			records.emplace_back(record);
+		}
+		TEST_CHECK(reader.exhausted());
+		TEST_CHECK(reader.begin() == reader.end());
+	}
+	::close(descriptor);
+	std::filesystem::remove(path);
+
+	return records;
+}
+
+auto split(const std::string &content, char delimiter) -> std::vector< std::string > {
+	std::vector< std::string > records;
+	std::size_t start = 0;
+	while (start < content.size()) {
+		std::size_t end = content.find(delimiter, start);
+		if (end == std::string::npos) {
+			end = content.size();
+		}
+		records.push_back(content.substr(start, end - start));
+		start = end + 1;
+	}
+	return records;
+}
+
+int main() {
+	std::string log;
+	for (std::size_t i = 0; i < 200; ++i) {
+		log += "line " + std::to_string(i) + ' ' + std::string(i % 37, 'x') + '\n';
+	}
+	log += "\n\nlast line without delimiter";
+
+	// Tiny buffers make records straddle refills and force the buffer to grow
+	for (std::size_t buffer_size : { 1, 2, 7, 16, 100, 4096 }) {
+		TEST_CHECK(read_records(log, '\n', buffer_size) == split(log, '\n'));
+	}
+
+	TEST_CHECK(read_records("a,b,,c,", ',', 3) == (std::vector< std::string >{ "a", "b", "", "c" }));
+	TEST_CHECK(read_records("", '\n', 16).empty());
+	TEST_CHECK(read_records("\n", '\n', 16) == std::vector< std::string >{ "" });
+
+	// Records are views into the internal buffer
+	{
+		int pipe_ends[2];
+		TEST_CHECK(::pipe(pipe_ends) == 0);
+		const std::string_view data = "first\nsecond\n";
+		TEST_CHECK(::write(pipe_ends[1], data.data(), data.size()) == static_cast< ::ssize_t >(data.size()));
+		::close(pipe_ends[1]);
+
+		iterators::delimited_reader reader(pipe_ends[0]);
+		auto iter = reader.begin();
+		TEST_CHECK(*iter == "first");
+		TEST_CHECK(iter->size() == 5);
+		++iter;
+		TEST_CHECK(*iter == "second");
+		TEST_CHECK(iter != reader.end());
+		++iter;
+		TEST_CHECK(iter == reader.end());
+		::close(pipe_ends[0]);
+	}
+}
@@ -0,0 +1,111 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/delta_vbyte.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+auto decode(const iterators::delta_vbyte_sequence &sequence) -> std::vector< std::uint32_t > {
+	return std::vector< std::uint32_t >(sequence.begin(), sequence.end());
+}
+
+auto sorted_values(std::size_t count, std::uint32_t max_gap, std::mt19937 &engine) -> std::vector< std::uint32_t > {
+	std::uniform_int_distribution< std::uint32_t > gap(1, max_gap);
+	std::vector< std::uint32_t > values(count);
+	std::uint32_t current = 0;
+	for (std::uint32_t &value : values) {
+		current += gap(engine);
+		value = current;
+	}
+	return values;
+}
+
+int main() {
+	std::mt19937 engine(42);
+
+	// Round trips, including partial groups and blocks
+	for (std::size_t count : { 0, 1, 3, 4, 5, 127, 128, 129, 1000 }) {
+		for (std::uint32_t max_gap : { 1U, 200U, 70000U, 4000000U }) {
+			const std::vector< std::uint32_t > values = sorted_values(count, max_gap, engine);
+			const iterators::delta_vbyte_sequence sequence(values.begin(), values.end());
+
+			TEST_CHECK(sequence.size() == count);
+			TEST_CHECK(decode(sequence) == values);
+		}
+	}
+
+	// Values needing all four byte lengths, unsorted values (the differences wrap around) and the extremes
+	{
+		const std::vector< std::uint32_t > values = { 0xFFFFFFFFU, 0, 1, 0x100, 0x10000, 0x1000000, 5, 0xFFFFFFFFU, 7 };
+		const iterators::delta_vbyte_sequence sequence(values.begin(), values.end());
+		TEST_CHECK(decode(sequence) == values);
+	}
+
+	// Small differences are stored in a single byte
+	{
+		const std::vector< std::uint32_t > values = sorted_values(1024, 255, engine);
+		const iterators::delta_vbyte_sequence sequence(values.begin(), values.end());
+		TEST_CHECK(sequence.compressed_size() == 1024 + 1024 / 4);
+	}
+
+	// skip_to agrees with std::lower_bound
+	{
+		const std::vector< std::uint32_t > values = sorted_values(5000, 1000, engine);
+		const iterators::delta_vbyte_sequence sequence(values.begin(), values.end());
+
+		std::uniform_int_distribution< std::uint32_t > target_distribution(0, values.back() + 10);
+		for (int i = 0; i < 200; ++i) {
+			const std::uint32_t target = target_distribution(engine);
+
+			iterators::delta_vbyte_iterator iter = sequence.begin();
+			iterators::skip_to(iter, target);
+
+			auto expected = std::lower_bound(values.begin(), values.end(), target);
+			if (expected == values.end()) {
+				TEST_CHECK(iter == sequence.end());
+			} else {
+				TEST_CHECK(iter != sequence.end() && *iter == *expected);
+				// Iteration continues normally after skipping
+				if (std::next(expected) != values.end()) {
+					++iter;
+					TEST_CHECK(*iter == *std::next(expected));
+				}
+			}
+		}
+
+		// Repeated skips with increasing targets (as in an intersection) only move forward
+		iterators::delta_vbyte_iterator iter = sequence.begin();
+		std::size_t visited                  = 0;
+		for (std::uint32_t target = 0; iter != sequence.end(); target += 3000) {
+			iterators::skip_to(iter, target);
+			if (iter != sequence.end()) {
+				TEST_CHECK(*iter == *std::lower_bound(values.begin(), values.end(), target));
+				++visited;
+			}
+		}
+		TEST_CHECK(visited > 0);
+
+		// Skipping to a value that has already been passed stays put
+		iter = sequence.begin();
+		iterators::skip_to(iter, values[300]);
+		iterators::skip_to(iter, values[10]);
+		TEST_CHECK(*iter == values[300]);
+	}
+
+	// Empty sequences
+	{
+		const iterators::delta_vbyte_sequence sequence;
+		TEST_CHECK(sequence.begin() == sequence.end());
+		iterators::delta_vbyte_iterator iter = sequence.begin();
+		iterators::skip_to(iter, 5);
+		TEST_CHECK(iter == sequence.end());
+	}
+}
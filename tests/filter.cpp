@@ -0,0 +1,122 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/filter.hpp>
+#include <iterators/iterator_facade.hpp>
+#include <iterators/range.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+// A single-pass core counting upwards
+class CountingCore {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+
+	CountingCore() = default;
+	CountingCore(int current) : m_current(current) {}
+
+	[[nodiscard]] auto dereference() const -> int { return m_current; }
+	[[nodiscard]] auto equals(const CountingCore &other) const -> bool { return m_current == other.m_current; }
+	void increment() { ++m_current; }
+
+private:
+	int m_current = 0;
+};
+
+template< typename Range > auto collect(const Range &range) -> std::vector< std::decay_t< decltype(*range.begin()) > > {
+	return { range.begin(), range.end() };
+}
+
+// Filters the given values via the general (element-wise) and the block-wise code path and checks that both yield the
+// expected elements
+template< typename Predicate > void check_filters(std::vector< int > &values, Predicate predicate) {
+	std::vector< int > expected;
+	for (int value : values) {
+		if (predicate(value)) {
+			expected.push_back(value);
+		}
+	}
+
+	const iterators::range< PointerCore< int > > source(PointerCore< int >(values.data()),
+														 PointerCore< int >(values.data() + values.size()));
+
+	TEST_CHECK(collect(iterators::filtered(source, predicate)) == expected);
+	TEST_CHECK(collect(iterators::filtered(values, predicate)) == expected);
+	TEST_CHECK(collect(iterators::filtered(values, iterators::vectorizable(predicate))) == expected);
+}
+
+int main() {
+	auto is_odd = [](int value) { return value % 2 != 0; };
+
+	using Vectorized = iterators::vectorizable_predicate< decltype(is_odd) >;
+
+	static_assert(iterators::filter_core< int *, Vectorized >::uses_blocks);
+	static_assert(!iterators::filter_core< int *, decltype(is_odd) >::uses_blocks);
+	static_assert(std::is_same_v< iterators::filter_iterator< int *, Vectorized >::iterator_category,
+								  std::forward_iterator_tag >);
+	static_assert(std::is_same_v< iterators::filter_iterator< const int *, Vectorized >::reference, const int & >);
+	static_assert(std::is_same_v< iterators::filter_iterator< CountingCore, decltype(is_odd) >::iterator_category,
+								  std::input_iterator_tag >);
+
+	// Sizes around the block size, so that full blocks as well as partial ones are covered
+	for (std::size_t size : { 0, 1, 5, 63, 64, 65, 127, 128, 129, 200, 1000 }) {
+		std::vector< int > values(size);
+		for (std::size_t i = 0; i < size; ++i) {
+			values[i] = static_cast< int >((i * 7919) % 1000);
+		}
+
+		check_filters(values, is_odd);
+		check_filters(values, [](int) { return true; });
+		check_filters(values, [](int) { return false; });
+		// Only a few elements, in blocks far apart
+		check_filters(values, [](int value) { return value % 500 == 0; });
+		check_filters(values, [](int value) { return value < 990; });
+	}
+
+	// Elements are yielded as references into the source, even when evaluated in blocks
+	{
+		std::vector< int > values = { 1, 2, 3, 4, 5, 6 };
+		for (int &value : iterators::filtered(values, iterators::vectorizable(is_odd))) {
+			value = 0;
+		}
+		TEST_CHECK(values == (std::vector< int >{ 0, 2, 0, 4, 0, 6 }));
+
+		const std::vector< int > &constant = values;
+		auto is_positive                   = [](int value) { return value > 0; };
+		auto evens                         = iterators::filtered(constant, iterators::vectorizable(is_positive));
+		TEST_CHECK(&*evens.begin() == &values[1]);
+		TEST_CHECK(std::distance(evens.begin(), evens.end()) == 3);
+	}
+
+	// Multiple passes over a forward filter
+	{
+		std::vector< double > values = { 0.5, -1.0, 2.5, -3.0, 4.5 };
+		auto is_positive             = [](double value) { return value > 0; };
+
+		auto positive =
+			iterators::filtered(values.data(), values.data() + values.size(), iterators::vectorizable(is_positive));
+
+		auto it   = positive.begin();
+		auto copy = it;
+		++it;
+		TEST_CHECK(*copy == 0.5 && *it == 2.5);
+		TEST_CHECK(std::next(copy) == it);
+		TEST_CHECK(std::distance(positive.begin(), positive.end()) == 3);
+	}
+
+	// Single-pass sources are only read up to the next accepted element
+	{
+		const iterators::iterator_facade< CountingCore > begin(CountingCore(0));
+		const iterators::iterator_facade< CountingCore > end(CountingCore(10));
+
+		TEST_CHECK(collect(iterators::filtered(begin, end, is_odd)) == (std::vector< int >{ 1, 3, 5, 7, 9 }));
+	}
+
+	return 0;
+}
@@ -0,0 +1,78 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+// The facade's operators with ITERATORS_FORCE_INLINE, which has to be defined before including any of the headers
+#define ITERATORS_FORCE_INLINE
+
+#include "TestCore.hpp"
+
+#include <iterators/iterator_facade.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+using Iterator = iterators::iterator_facade< PointerCore< int > >;
+
+// The forced inlining mustn't interfere with constant evaluation
+constexpr auto constexpr_sum() -> int {
+	int values[] = { 1, 2, 3, 4 };
+
+	iterators::iterator_facade< PointerCore< int > > first(values);
+	iterators::iterator_facade< PointerCore< int > > last(values + 4);
+
+	int sum = 0;
+	for (auto it = first; it != last; ++it) {
+		sum += *it;
+	}
+	return sum + first[3] + static_cast< int >(last - first);
+}
+
+static_assert(constexpr_sum() == 18);
+
+// Elements are returned by value, so operator-> uses a proxy
+struct PairCore {
+	using target_iterator_category = std::input_iterator_tag;
+
+	int value = 0;
+
+	[[nodiscard]] auto dereference() const -> std::pair< int, int > { return { value, 2 * value }; }
+	[[nodiscard]] auto equals(const PairCore &other) const -> bool { return value == other.value; }
+	void increment() { ++value; }
+};
+
+int main() {
+	int values[] = { 5, 6, 7, 8, 9 };
+
+	Iterator first(values);
+	Iterator last(values + 5);
+
+	TEST_CHECK(*first == 5);
+	TEST_CHECK(first != last);
+	TEST_CHECK(!(first == last));
+
+	Iterator it = first;
+	TEST_CHECK(*it++ == 5);
+	TEST_CHECK(*++it == 7);
+	TEST_CHECK(*it-- == 7);
+	TEST_CHECK(*--it == 5);
+
+	it += 3;
+	TEST_CHECK(*it == 8);
+	it -= 2;
+	TEST_CHECK(*it == 6);
+	TEST_CHECK(*(it + 2) == 8);
+	TEST_CHECK(*(2 + it) == 8);
+	TEST_CHECK(*(it - 1) == 5);
+	TEST_CHECK(last - it == 4);
+	TEST_CHECK(it[3] == 9);
+	TEST_CHECK(first < it && first <= it && it > first && it >= first);
+
+	iterators::iterator_facade< PairCore > pairs(PairCore{ 3 });
+	TEST_CHECK(pairs->second == 6);
+	++pairs;
+	TEST_CHECK(pairs->first == 4);
+
+	return 0;
+}
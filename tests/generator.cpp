@@ -0,0 +1,171 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/generator.hpp>
+
+// Generators are only available when compiling as C++20 (see tests/CMakeLists.txt)
+#ifdef __cpp_impl_coroutine
+
+#	include <iterators/iterator_facade.hpp>
+
+#	include <iterator>
+#	include <memory>
+#	include <stdexcept>
+#	include <string>
+#	include <type_traits>
+#	include <vector>
+
+using Iterator = iterators::generator_iterator< int >;
+
+static_assert(std::is_same_v< Iterator::iterator_category, std::input_iterator_tag >);
+static_assert(std::is_same_v< Iterator::reference, const int & >);
+static_assert(std::is_same_v< Iterator::value_type, int >);
+static_assert(std::is_same_v< iterators::generator_iterator< std::string & >::reference, std::string & >);
+static_assert(!std::is_copy_constructible_v< iterators::generator< int > >);
+
+struct Node {
+	int value;
+	std::unique_ptr< Node > left;
+	std::unique_ptr< Node > right;
+};
+
+auto insert(std::unique_ptr< Node > &node, int value) -> void {
+	if (!node) {
+		node = std::make_unique< Node >(Node{ value, nullptr, nullptr });
+	} else {
+		insert(value < node->value ? node->left : node->right, value);
+	}
+}
+
+auto walk(const Node *node) -> iterators::generator< int > {
+	if (node != nullptr) {
+		co_yield iterators::elements_of(walk(node->left.get()));
+		co_yield node->value;
+		co_yield iterators::elements_of(walk(node->right.get()));
+	}
+}
+
+auto count_up(int first, int last) -> iterators::generator< int > {
+	for (int i = first; i < last; ++i) {
+		co_yield i;
+	}
+}
+
+auto words(std::vector< std::string > &storage) -> iterators::generator< std::string & > {
+	for (std::string &word : storage) {
+		co_yield word;
+	}
+}
+
+auto throwing(int after) -> iterators::generator< int > {
+	co_yield iterators::elements_of(count_up(0, after));
+	throw std::runtime_error("generator failed");
+}
+
+auto nested_throwing() -> iterators::generator< int > {
+	co_yield -1;
+	co_yield iterators::elements_of(throwing(2));
+	co_yield -2;
+}
+
+template< typename Generator > auto collect(Generator &&generator) -> std::vector< int > {
+	std::vector< int > elements;
+	for (int element : generator) {
+		elements.push_back(element);
+	}
+	return elements;
+}
+
+int main() {
+	// Plain generators, including empty ones and temporaries
+	{
+		TEST_CHECK(collect(count_up(0, 5)) == (std::vector< int >{ 0, 1, 2, 3, 4 }));
+		TEST_CHECK(collect(count_up(3, 3)).empty());
+
+		iterators::generator< int > empty;
+		TEST_CHECK(empty.begin() == empty.end());
+	}
+
+	// Manual iteration: all copies of an iterator share the position of the generator
+	{
+		iterators::generator< int > generator = count_up(10, 13);
+
+		Iterator it   = generator.begin();
+		Iterator copy = it;
+		TEST_CHECK(*it == 10);
+		++it;
+		TEST_CHECK(*copy == 11);
+		TEST_CHECK(it != generator.end());
+		it++;
+		TEST_CHECK(*it == 12);
+		++it;
+		TEST_CHECK(it == generator.end());
+		TEST_CHECK(copy == generator.end());
+	}
+
+	// Nested generators walking a binary search tree in order
+	{
+		std::unique_ptr< Node > root;
+		for (int value : { 50, 30, 70, 20, 40, 60, 80, 35, 45, 65, 10 }) {
+			insert(root, value);
+		}
+
+		TEST_CHECK(collect(walk(root.get()))
+				   == (std::vector< int >{ 10, 20, 30, 35, 40, 45, 50, 60, 65, 70, 80 }));
+		TEST_CHECK(collect(walk(nullptr)).empty());
+
+		// A degenerate tree that is as deep as it is large
+		std::unique_ptr< Node > list;
+		std::vector< int > expected;
+		for (int value = 0; value < 1000; ++value) {
+			insert(list, value);
+			expected.push_back(value);
+		}
+		TEST_CHECK(collect(walk(list.get())) == expected);
+
+		// Stopping in the middle of a nested walk destroys all nested generators
+		iterators::generator< int > generator = walk(list.get());
+		auto it                               = generator.begin();
+		for (int i = 0; i < 500; ++i) {
+			++it;
+		}
+		TEST_CHECK(*it == 500);
+	}
+
+	// Generators of references yield the referenced objects themselves
+	{
+		std::vector< std::string > storage = { "a", "b", "c" };
+		for (std::string &word : words(storage)) {
+			word += "!";
+		}
+		TEST_CHECK(storage == (std::vector< std::string >{ "a!", "b!", "c!" }));
+	}
+
+	// Exceptions propagate through nested generators to the caller of increment
+	{
+		std::vector< int > elements;
+		bool caught = false;
+		try {
+			for (int element : nested_throwing()) {
+				elements.push_back(element);
+			}
+		} catch (const std::runtime_error &) {
+			caught = true;
+		}
+		TEST_CHECK(caught);
+		TEST_CHECK(elements == (std::vector< int >{ -1, 0, 1 }));
+	}
+
+	return 0;
+}
+
+#else
+
+int main() {
+	return 0;
+}
+
+#endif
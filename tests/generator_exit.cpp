@@ -0,0 +1,103 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/generator.hpp>
+
+// Generators are only available when compiling as C++20 (see tests/CMakeLists.txt)
+#ifdef __cpp_impl_coroutine
+
+#	include <cstddef>
+#	include <cstdio>
+#	include <cstdlib>
+#	include <new>
+
+// Generators destroyed after the thread-local objects of the main thread (here: one with static storage duration and
+// one living in an atexit handler) must neither use the frame pool's storage afterwards nor leak their frames. The
+// allocations are counted by replacing the global allocation functions and checked by the last atexit handler to run.
+
+namespace {
+std::size_t live_allocations     = 0;
+std::size_t baseline_allocations = 0;
+} // namespace
+
+auto operator new(std::size_t size) -> void * {
+	if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+		++live_allocations;
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept {
+	if (memory != nullptr) {
+		--live_allocations;
+		std::free(memory);
+	}
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+	::operator delete(memory);
+}
+
+auto count_up(int first, int last) -> iterators::generator< int > {
+	for (int i = first; i < last; ++i) {
+		co_yield i;
+	}
+}
+
+auto sum(int first, int last) -> int {
+	int total = 0;
+	for (int value : count_up(first, last)) {
+		total += value;
+	}
+	return total;
+}
+
+void check_allocations() {
+	if (live_allocations != baseline_allocations) {
+		std::printf("%zu allocation(s) leaked at exit\n", live_allocations - baseline_allocations);
+		std::_Exit(EXIT_FAILURE);
+	}
+}
+
+void use_generator_at_exit() {
+	if (sum(0, 4) != 6) {
+		std::printf("generator created at exit yielded wrong elements\n");
+		std::_Exit(EXIT_FAILURE);
+	}
+}
+
+auto static_generator() -> iterators::generator< int > & {
+	static iterators::generator< int > generator = count_up(0, 10);
+	return generator;
+}
+
+int main() {
+	baseline_allocations = live_allocations;
+
+	// atexit handlers and the destructors of objects with static storage duration run in the reverse order of their
+	// registration (construction), i.e. the check runs last
+	std::atexit(check_allocations);
+	std::atexit(use_generator_at_exit);
+
+	// Fill the frame pool of the main thread
+	TEST_CHECK(sum(0, 5) == 10);
+
+	auto it = static_generator().begin();
+	TEST_CHECK(*it == 0);
+	++it;
+	TEST_CHECK(*it == 1);
+
+	return 0;
+}
+
+#else
+
+int main() {
+	return 0;
+}
+
+#endif
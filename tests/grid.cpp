@@ -0,0 +1,162 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/grid.hpp>
+#include <iterators/iterator_facade.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+static_assert(std::is_same_v< iterators::tiled_grid_iterator< int >::iterator_category,
+							  std::random_access_iterator_tag >);
+static_assert(std::is_same_v< iterators::morton_grid_iterator< int >::iterator_category,
+							  std::random_access_iterator_tag >);
+static_assert(std::is_same_v< iterators::morton_grid_iterator< const int >::reference, const int & >);
+
+// Checks that the given range visits every cell of the grid exactly once, that the reported coordinates match the
+// visited cells and that random access agrees with incremental traversal
+template< typename Range > void check_traversal(const Range &cells, const iterators::grid< int > &grid) {
+	TEST_CHECK(static_cast< std::size_t >(std::distance(cells.begin(), cells.end())) == grid.size());
+
+	std::vector< bool > visited(grid.size(), false);
+	std::size_t index = 0;
+	for (auto it = cells.begin(); it != cells.end(); ++it, ++index) {
+		const iterators::grid_point point = iterators::coordinates(it);
+		TEST_CHECK(point.x < grid.width() && point.y < grid.height());
+		TEST_CHECK(&*it == &grid[point]);
+		TEST_CHECK(!visited[point.y * grid.width() + point.x]);
+		visited[point.y * grid.width() + point.x] = true;
+
+		// Random access
+		TEST_CHECK(&cells.begin()[static_cast< std::ptrdiff_t >(index)] == &*it);
+		TEST_CHECK(iterators::coordinates(cells.begin() + static_cast< std::ptrdiff_t >(index)) == point);
+		TEST_CHECK(it - cells.begin() == static_cast< std::ptrdiff_t >(index));
+		TEST_CHECK(cells.end() - it == static_cast< std::ptrdiff_t >(grid.size() - index));
+	}
+	TEST_CHECK(std::all_of(visited.begin(), visited.end(), [](bool cell) { return cell; }));
+
+	// Backwards traversal
+	if (grid.size() > 0) {
+		auto it = cells.end();
+		--it;
+		TEST_CHECK(&*it == &*(cells.begin() + static_cast< std::ptrdiff_t >(grid.size() - 1)));
+		it -= static_cast< std::ptrdiff_t >(grid.size() - 1);
+		TEST_CHECK(it == cells.begin());
+	}
+}
+
+// Whether the given function throws std::invalid_argument
+template< typename Function > auto throws_invalid_argument(Function function) -> bool {
+	try {
+		function();
+	} catch (const std::invalid_argument &) {
+		return true;
+	}
+	return false;
+}
+
+int main() {
+	std::vector< int > storage(16 * 16);
+	std::iota(storage.begin(), storage.end(), 0);
+
+	// Tile order
+	{
+		const iterators::grid< int > grid(storage.data(), 4, 4);
+		auto cells = iterators::tiled(grid, 2, 2);
+
+		TEST_CHECK(std::vector< int >(cells.begin(), cells.end())
+				   == (std::vector< int >{ 0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15 }));
+		check_traversal(cells, grid);
+	}
+
+	// Partial tiles at the edges
+	{
+		const iterators::grid< int > grid(storage.data(), 5, 3);
+		auto cells = iterators::tiled(grid, 2, 2);
+
+		TEST_CHECK(std::vector< int >(cells.begin(), cells.end())
+				   == (std::vector< int >{ 0, 1, 5, 6, 2, 3, 7, 8, 4, 9, 10, 11, 12, 13, 14 }));
+		check_traversal(cells, grid);
+
+		for (std::size_t width = 1; width <= 7; ++width) {
+			for (std::size_t height = 1; height <= 7; ++height) {
+				check_traversal(iterators::tiled(grid, width, height), grid);
+			}
+		}
+	}
+
+	// Sub-grid with a stride and tiles larger than the grid
+	{
+		const iterators::grid< int > grid(storage.data() + 17, 3, 2, 16);
+		auto cells = iterators::tiled(grid, 8, 8);
+
+		TEST_CHECK(std::vector< int >(cells.begin(), cells.end()) == (std::vector< int >{ 17, 18, 19, 33, 34, 35 }));
+		check_traversal(cells, grid);
+	}
+
+	// Empty grid
+	{
+		const iterators::grid< int > grid(storage.data(), 0, 3);
+		auto cells = iterators::tiled(grid, 2, 2);
+
+		TEST_CHECK(cells.begin() == cells.end());
+	}
+
+	TEST_CHECK(throws_invalid_argument([&]() {
+		iterators::tiled(iterators::grid< int >(storage.data(), 4, 4), 0, 2);
+	}));
+
+	// Morton order
+	{
+		const iterators::grid< int > grid(storage.data(), 4, 4);
+		auto cells = iterators::morton(grid);
+
+		TEST_CHECK(std::vector< int >(cells.begin(), cells.end())
+				   == (std::vector< int >{ 0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15 }));
+		check_traversal(cells, grid);
+		check_traversal(iterators::morton(iterators::grid< int >(storage.data(), 16, 16)),
+						iterators::grid< int >(storage.data(), 16, 16));
+	}
+
+	// Non-square Morton order
+	{
+		const iterators::grid< int > wide(storage.data(), 4, 2);
+		auto cells = iterators::morton(wide);
+
+		TEST_CHECK(std::vector< int >(cells.begin(), cells.end()) == (std::vector< int >{ 0, 1, 4, 5, 2, 3, 6, 7 }));
+		check_traversal(cells, wide);
+
+		const iterators::grid< int > tall(storage.data(), 2, 8);
+		check_traversal(iterators::morton(tall), tall);
+
+		const iterators::grid< int > line(storage.data(), 1, 16);
+		check_traversal(iterators::morton(line), line);
+	}
+
+	TEST_CHECK(throws_invalid_argument([&]() { iterators::morton(iterators::grid< int >(storage.data(), 6, 4)); }));
+	TEST_CHECK(throws_invalid_argument([&]() { iterators::morton(iterators::grid< int >(storage.data(), 0, 4)); }));
+
+	// Writing through the iterators
+	{
+		std::vector< int > values(8 * 8, 0);
+		const iterators::grid< int > grid(values.data(), 8, 8);
+
+		for (int &cell : iterators::tiled(grid, 3, 3)) {
+			cell += 1;
+		}
+		for (int &cell : iterators::morton(grid)) {
+			cell += 1;
+		}
+		TEST_CHECK(std::all_of(values.begin(), values.end(), [](int value) { return value == 2; }));
+	}
+
+	return 0;
+}
@@ -0,0 +1,135 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/iota.hpp>
+#include <iterators/iterator_facade.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template< typename Range > auto collect(const Range &range) -> std::vector< std::decay_t< decltype(*range.begin()) > > {
+	return { range.begin(), range.end() };
+}
+
+static_assert(std::is_same_v< iterators::iota_iterator< int >::iterator_category, std::random_access_iterator_tag >);
+static_assert(std::is_same_v< iterators::iota_iterator< int >::reference, const int & >);
+static_assert(std::is_same_v< decltype(std::declval< iterators::iota_iterator< int > >()[1]), int >);
+static_assert(std::is_same_v< iterators::iota_step_iterator< std::uint64_t >::value_type, std::uint64_t >);
+
+static_assert(noexcept(++std::declval< iterators::iota_iterator< long > & >()));
+static_assert(noexcept(*std::declval< iterators::iota_iterator< long > & >()));
+static_assert(noexcept(std::declval< iterators::iota_core< long > & >().distance_to({})));
+static_assert(noexcept(iterators::iota(0, 10, 2)));
+
+// Iota ranges can be used in constant expressions
+constexpr auto sum(int first, int last) -> int {
+	int sum = 0;
+	for (int value : iterators::iota(first, last)) {
+		sum += value;
+	}
+	return sum;
+}
+
+constexpr auto sum_stepped(int first, int last, std::ptrdiff_t step) -> int {
+	int sum = 0;
+	for (int value : iterators::iota(first, last, step)) {
+		sum += value;
+	}
+	return sum;
+}
+
+static_assert(sum(0, 10) == 45);
+static_assert(sum(-5, 5) == -5);
+static_assert(sum_stepped(0, 10, 3) == 0 + 3 + 6 + 9);
+static_assert(sum_stepped(10, 0, -4) == 10 + 6 + 2);
+static_assert(iterators::iota(3, 10).size() == 7);
+static_assert(iterators::iota(3, 10).begin()[4] == 7);
+static_assert(iterators::iota(0, 10, 3).size() == 4);
+static_assert(iterators::iota(0, 9, 3).size() == 3);
+static_assert(iterators::iota(0, 10, -1).empty());
+
+int main() {
+	// Plain counting
+	{
+		TEST_CHECK(collect(iterators::iota(2, 6)) == (std::vector< int >{ 2, 3, 4, 5 }));
+		TEST_CHECK(collect(iterators::iota(-2, 1)) == (std::vector< int >{ -2, -1, 0 }));
+		TEST_CHECK(iterators::iota(7, 7).empty());
+
+		auto range = iterators::iota< std::size_t >(10, 20);
+		auto it    = std::lower_bound(range.begin(), range.end(), std::size_t(15));
+		TEST_CHECK(*it == 15 && it - range.begin() == 5);
+		TEST_CHECK(*(it - 3) == 12 && *(it + 4) == 19);
+		TEST_CHECK(range.end() - it == 5);
+		TEST_CHECK(std::count_if(range.begin(), range.end(), [](std::size_t value) { return value % 2 == 0; }) == 5);
+	}
+
+	// Steps
+	{
+		TEST_CHECK(collect(iterators::iota(0, 10, 3)) == (std::vector< int >{ 0, 3, 6, 9 }));
+		TEST_CHECK(collect(iterators::iota(0, 9, 3)) == (std::vector< int >{ 0, 3, 6 }));
+		TEST_CHECK(collect(iterators::iota(5, -5, -4)) == (std::vector< int >{ 5, 1, -3 }));
+		TEST_CHECK(iterators::iota(0, 10, -2).empty());
+		TEST_CHECK(iterators::iota(10, 0, 2).empty());
+
+		auto range = iterators::iota< std::int64_t >(-100, 100, 7);
+		TEST_CHECK(static_cast< std::ptrdiff_t >(range.size()) == std::distance(range.begin(), range.end()));
+		TEST_CHECK(range.begin()[3] == -79);
+		auto last = std::prev(range.end());
+		TEST_CHECK(*last == 96 && last - range.begin() == 28);
+		--last;
+		last -= 2;
+		TEST_CHECK(*last == 75);
+	}
+
+	// Unsigned ranges beyond the range of difference_type
+	{
+		constexpr std::uint64_t high = std::numeric_limits< std::uint64_t >::max() - 10;
+
+		auto range = iterators::iota(high, high + 5);
+		TEST_CHECK(range.size() == 5);
+		TEST_CHECK(range.begin() - range.end() == -5);
+		TEST_CHECK(*std::prev(range.end()) == high + 4);
+		TEST_CHECK(range.begin() < range.end());
+
+		// Counting up to the largest value is possible as long as it is excluded
+		auto top = iterators::iota(high, std::numeric_limits< std::uint64_t >::max());
+		TEST_CHECK(collect(top).back() == std::numeric_limits< std::uint64_t >::max() - 1);
+		TEST_CHECK(top.size() == 10);
+
+		auto stepped = iterators::iota< std::uint64_t >(high, high - 9, -3);
+		TEST_CHECK(collect(stepped) == (std::vector< std::uint64_t >{ high, high - 3, high - 6 }));
+	}
+
+	// Signed ranges spanning large parts of their domain
+	{
+		constexpr std::int32_t min = std::numeric_limits< std::int32_t >::min();
+		constexpr std::int32_t max = std::numeric_limits< std::int32_t >::max();
+
+		auto range = iterators::iota(min, max);
+		TEST_CHECK(range.size() == std::size_t(max) * 2 + 1);
+		TEST_CHECK(range.begin()[std::ptrdiff_t(max) + 1] == 0);
+
+		constexpr std::int32_t quarter = std::int32_t(1) << 30;
+
+		auto down = iterators::iota(0, min, -quarter);
+		TEST_CHECK(collect(down) == (std::vector< std::int32_t >{ 0, -quarter }));
+		auto up = iterators::iota(min, quarter, quarter);
+		TEST_CHECK(collect(up) == (std::vector< std::int32_t >{ min, -quarter, 0 }));
+		TEST_CHECK(up.end() - up.begin() == 3);
+
+		auto narrow = iterators::iota< std::int8_t >(-128, 100, 50);
+		TEST_CHECK(collect(narrow) == (std::vector< std::int8_t >{ -128, -78, -28, 22, 72 }));
+		TEST_CHECK(narrow.size() == 5);
+	}
+
+	return 0;
+}
@@ -0,0 +1,115 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/iterator_facade.hpp>
+#include <iterators/iterator_operations.hpp>
+#include <iterators/range.hpp>
+#include <iterators/type_traits.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+// A core that can jump ahead cheaply but that only models a forward (or bidirectional) iterator. All steps taken
+// via increment() and decrement() are counted.
+template< typename Category > struct SkippingCore {
+	using target_iterator_category = Category;
+
+	SkippingCore() = default;
+	SkippingCore(const int *ptr, std::size_t *steps) : m_ptr(ptr), m_steps(steps) {}
+
+	[[nodiscard]] auto dereference() const -> const int & { return *m_ptr; }
+	[[nodiscard]] auto equals(const SkippingCore &other) const -> bool { return m_ptr == other.m_ptr; }
+	void increment() {
+		++m_ptr;
+		++*m_steps;
+	}
+	void decrement() {
+		--m_ptr;
+		++*m_steps;
+	}
+	void advance(std::ptrdiff_t amount) { m_ptr += amount; }
+
+private:
+	const int *m_ptr      = nullptr;
+	std::size_t *m_steps = nullptr;
+};
+
+using ForwardIterator       = iterators::iterator_facade< SkippingCore< std::forward_iterator_tag > >;
+using BidirectionalIterator = iterators::iterator_facade< SkippingCore< std::bidirectional_iterator_tag > >;
+using DistanceIterator = iterators::iterator_facade< PointerCore< const int, std::forward_iterator_tag > >;
+
+static_assert(iterators::member_functions::has_advance_v< SkippingCore< std::forward_iterator_tag > >,
+			  "'advance' must be detected even without 'distance_to'");
+static_assert(!iterators::operators::supports_addition_with_arithmetic_v< ForwardIterator >,
+			  "Implementing 'advance' must not expose operator+ for forward iterators");
+static_assert(!iterators::operators::supports_add_assign_v< BidirectionalIterator >,
+			  "Implementing 'advance' must not expose operator+= for bidirectional iterators");
+static_assert(!iterators::operators::supports_subtraction_with_iterator_v< DistanceIterator >,
+			  "Implementing 'distance_to' must not expose operator- for forward iterators");
+static_assert(std::is_same_v< std::iterator_traits< ForwardIterator >::difference_type, std::ptrdiff_t >,
+			  "Cores without 'distance_to' still need a difference type");
+
+int main() {
+	std::vector< int > numbers(100);
+	for (std::size_t i = 0; i < numbers.size(); ++i) {
+		numbers[i] = static_cast< int >(i);
+	}
+
+	std::size_t steps = 0;
+
+	// Forward iterators
+	{
+		ForwardIterator iter({ numbers.data(), &steps });
+
+		TEST_CHECK(*iterators::next(iter, 42) == 42);
+		TEST_CHECK(*iterators::next(iter) == 1);
+
+		iterators::advance(iter, 10);
+		TEST_CHECK(*iter == 10);
+
+		// Unqualified calls pick up the facade overloads via ADL
+		using std::advance;
+		using std::next;
+		advance(iter, 5);
+		TEST_CHECK(*iter == 15);
+		TEST_CHECK(*next(iter, 5) == 20);
+
+		TEST_CHECK(steps == 0);
+
+		// Incrementing still takes a single step
+		++iter;
+		TEST_CHECK(steps == 1);
+	}
+
+	// Bidirectional iterators
+	{
+		steps = 0;
+		BidirectionalIterator iter({ numbers.data() + 50, &steps });
+
+		TEST_CHECK(*iterators::prev(iter, 20) == 30);
+		TEST_CHECK(*iterators::next(iter, -20) == 30);
+		TEST_CHECK(steps == 0);
+	}
+
+	// Distances
+	{
+		DistanceIterator first(numbers.data());
+		DistanceIterator last(numbers.data() + numbers.size());
+
+		TEST_CHECK(iterators::distance(first, last) == 100);
+		TEST_CHECK(iterators::distance(last, first) == -100);
+
+		using std::distance;
+		TEST_CHECK(distance(first, last) == 100);
+
+		// Unqualified calls for other iterators whose associated namespaces include iterators resolve to std
+		const std::vector< iterators::subrange_kind > kinds(3, iterators::subrange_kind::sized);
+		TEST_CHECK(distance(kinds.begin(), kinds.end()) == 3);
+		using std::next;
+		TEST_CHECK(next(kinds.begin(), 3) == kinds.end());
+	}
+}
@@ -0,0 +1,116 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/iterator_facade.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+// A compact core addressing elements of a global table via a narrow index
+template< typename Index, typename Category = std::random_access_iterator_tag > struct IndexCore {
+	using target_iterator_category = Category;
+
+	static inline int table[100] = {};
+
+	IndexCore() = default;
+	IndexCore(Index index) : m_index(index) {}
+
+	[[nodiscard]] auto dereference() const -> int & { return table[m_index]; }
+	[[nodiscard]] auto equals(const IndexCore &other) const -> bool { return m_index == other.m_index; }
+	void increment() { ++m_index; }
+	void decrement() { --m_index; }
+	[[nodiscard]] auto distance_to(const IndexCore &other) const -> Index {
+		return static_cast< Index >(other.m_index - m_index);
+	}
+	void advance(Index amount) { m_index = static_cast< Index >(m_index + amount); }
+
+private:
+	Index m_index = 0;
+};
+
+// A core consisting of a single byte
+struct ByteCore {
+	using target_iterator_category = std::random_access_iterator_tag;
+
+	[[nodiscard]] auto dereference() const -> const char & { return value; }
+	[[nodiscard]] auto equals(const ByteCore &other) const -> bool { return value == other.value; }
+	void increment() {}
+	void decrement() {}
+	[[nodiscard]] auto distance_to(const ByteCore &) const -> std::int8_t { return 0; }
+	void advance(std::int8_t) {}
+
+	char value = 0;
+};
+
+template< typename Core > constexpr bool has_zero_overhead() {
+	using Iterator = iterators::iterator_facade< Core >;
+	return sizeof(Iterator) == sizeof(Core) && alignof(Iterator) == alignof(Core);
+}
+
+template< template< typename > class Core > constexpr bool has_zero_overhead_in_all_categories() {
+	return has_zero_overhead< Core< std::output_iterator_tag > >()
+		   && has_zero_overhead< Core< std::input_iterator_tag > >()
+		   && has_zero_overhead< Core< std::forward_iterator_tag > >()
+		   && has_zero_overhead< Core< std::bidirectional_iterator_tag > >()
+		   && has_zero_overhead< Core< std::random_access_iterator_tag > >();
+}
+
+template< typename Category > using Int32IndexCore = IndexCore< std::int32_t, Category >;
+template< typename Category > using Int16IndexCore = IndexCore< std::int16_t, Category >;
+template< typename Category > using IntPointerCore = PointerCore< int, Category >;
+
+static_assert(has_zero_overhead_in_all_categories< TestCore >(), "Facades must not add any overhead");
+static_assert(has_zero_overhead_in_all_categories< IntPointerCore >(), "Facades must not add any overhead");
+static_assert(has_zero_overhead_in_all_categories< Int32IndexCore >(), "Facades must not add any overhead");
+static_assert(has_zero_overhead_in_all_categories< Int16IndexCore >(), "Facades must not add any overhead");
+static_assert(has_zero_overhead< ByteCore >(), "Facades must not add any overhead");
+
+static_assert(sizeof(iterators::iterator_facade< Int32IndexCore< std::random_access_iterator_tag > >)
+				  == sizeof(std::int32_t),
+			  "Iterators over 32-bit indices must be 32 bits wide");
+
+static_assert(std::is_same_v< std::iterator_traits< iterators::iterator_facade<
+								  Int32IndexCore< std::random_access_iterator_tag > > >::difference_type,
+							  std::int32_t >,
+			  "Narrow difference types must be preserved");
+
+static_assert(
+	std::is_trivially_copyable_v< iterators::iterator_facade< IntPointerCore< std::random_access_iterator_tag > > >,
+	"Facades over trivially copyable cores must be trivially copyable");
+
+template< typename Iterator > void check_arithmetic() {
+	using difference_type = typename Iterator::difference_type;
+
+	for (int i = 0; i < 100; ++i) {
+		IndexCore< difference_type >::table[i] = i;
+	}
+
+	Iterator begin(difference_type{ 0 });
+	Iterator end(difference_type{ 100 });
+
+	TEST_CHECK(end - begin == 100);
+	TEST_CHECK(begin - end == -100);
+	TEST_CHECK(*(begin + 10) == 10);
+	TEST_CHECK(*(10 + begin) == 10);
+	TEST_CHECK(*(end - 1) == 99);
+	TEST_CHECK(begin[42] == 42);
+	TEST_CHECK(begin < end && begin <= end && end > begin && end >= begin);
+	TEST_CHECK(begin <= begin && begin >= begin && !(begin < begin) && !(begin > begin));
+
+	Iterator iter = begin;
+	iter += 50;
+	iter -= 20;
+	TEST_CHECK(*iter == 30);
+	TEST_CHECK(*--iter == 29);
+	TEST_CHECK(*iter++ == 29);
+	TEST_CHECK(*iter == 30);
+}
+
+int main() {
+	check_arithmetic< iterators::iterator_facade< Int32IndexCore< std::random_access_iterator_tag > > >();
+	check_arithmetic< iterators::iterator_facade< Int16IndexCore< std::random_access_iterator_tag > > >();
+}
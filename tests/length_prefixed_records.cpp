@@ -0,0 +1,128 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/length_prefixed_records.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using Records = iterators::length_prefixed_records<>;
+
+static_assert(std::is_same_v< Records::iterator::iterator_category, std::forward_iterator_tag >);
+static_assert(std::is_same_v< Records::random_access_range::iterator::iterator_category,
+							  std::random_access_iterator_tag >);
+
+template< typename Length > void append(std::vector< std::byte > &buffer, const std::string &record) {
+	for (std::size_t byte = 0; byte < sizeof(Length); ++byte) {
+		buffer.push_back(static_cast< std::byte >((record.size() >> (8 * byte)) & 0xFF));
+	}
+	for (char c : record) {
+		buffer.push_back(static_cast< std::byte >(c));
+	}
+}
+
+auto to_string(const iterators::byte_view &view) -> std::string {
+	return std::string(reinterpret_cast< const char * >(view.data()), view.size());
+}
+
+template< typename Range > auto to_strings(const Range &range) -> std::vector< std::string > {
+	std::vector< std::string > strings;
+	for (const iterators::byte_view &view : range) {
+		strings.push_back(to_string(view));
+	}
+	return strings;
+}
+
+auto throws_out_of_range(const std::vector< std::byte > &buffer) -> bool {
+	try {
+		to_strings(Records(buffer.data(), buffer.size()));
+	} catch (const std::out_of_range &) {
+		return true;
+	}
+	return false;
+}
+
+int main() {
+	const std::vector< std::string > strings = { "first", "", "third record", std::string(300, 'x'), "last" };
+
+	std::vector< std::byte > buffer;
+	for (const std::string &string : strings) {
+		append< std::uint32_t >(buffer, string);
+	}
+
+	// Forward iteration yields views into the buffer
+	{
+		const Records records(buffer.data(), buffer.size());
+		TEST_CHECK(to_strings(records) == strings);
+		TEST_CHECK(records.begin()->data() == buffer.data() + 4);
+		TEST_CHECK(std::distance(records.begin(), records.end()) == 5);
+	}
+
+	// Random access via the lazily built index
+	{
+		const Records records(buffer.data(), buffer.size());
+		TEST_CHECK(to_string(records[2]) == "third record");
+		TEST_CHECK(to_string(records[0]) == "first");
+		TEST_CHECK(records.size() == 5);
+
+		auto random_access = records.random_access();
+		TEST_CHECK(random_access.size() == 5);
+		TEST_CHECK(to_string(random_access.begin()[3]) == strings[3]);
+		TEST_CHECK(to_strings(random_access) == strings);
+
+		auto longest = std::max_element(random_access.begin(), random_access.end(),
+										[](const iterators::byte_view &lhs, const iterators::byte_view &rhs) {
+											return lhs.size() < rhs.size();
+										});
+		TEST_CHECK(longest - random_access.begin() == 3);
+
+		bool caught = false;
+		try {
+			(void) records[5];
+		} catch (const std::out_of_range &) {
+			caught = true;
+		}
+		TEST_CHECK(caught);
+	}
+
+	// Other length types
+	{
+		std::vector< std::byte > short_buffer;
+		for (const std::string &string : strings) {
+			append< std::uint16_t >(short_buffer, string);
+		}
+		TEST_CHECK(to_strings(iterators::length_prefixed_records< std::uint16_t >(short_buffer.data(),
+																				   short_buffer.size()))
+				   == strings);
+	}
+
+	// Empty buffers contain no records
+	{
+		const Records records(nullptr, 0);
+		TEST_CHECK(records.begin() == records.end());
+		TEST_CHECK(records.size() == 0 && records.empty());
+	}
+
+	// Malformed buffers
+	{
+		std::vector< std::byte > truncated_record(buffer.begin(), buffer.end() - 1);
+		TEST_CHECK(throws_out_of_range(truncated_record));
+
+		std::vector< std::byte > truncated_prefix = buffer;
+		truncated_prefix.push_back(std::byte{ 1 });
+		TEST_CHECK(throws_out_of_range(truncated_prefix));
+
+		// Records preceding the malformed one remain accessible
+		const Records records(truncated_record.data(), truncated_record.size());
+		TEST_CHECK(to_string(records[3]) == strings[3]);
+	}
+}
@@ -0,0 +1,169 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/lookahead.hpp>
+#include <iterators/iterator_facade.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// A single-pass core over the characters of a string that counts how often characters have been read
+class CharacterCore {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+
+	static inline int reads = 0;
+
+	CharacterCore() = default;
+	CharacterCore(const char *current) : m_current(current) {}
+
+	[[nodiscard]] auto dereference() const -> char {
+		++reads;
+		return *m_current;
+	}
+	[[nodiscard]] auto equals(const CharacterCore &other) const -> bool { return m_current == other.m_current; }
+	void increment() { ++m_current; }
+
+private:
+	const char *m_current = nullptr;
+};
+
+using Iterator = iterators::lookahead_iterator< CharacterCore, 4 >;
+
+static_assert(std::is_same_v< Iterator::iterator_category, std::input_iterator_tag >);
+static_assert(std::is_same_v< Iterator::reference, const char & >);
+
+auto make_range(const std::string &text) -> decltype(iterators::lookahead< 4 >(CharacterCore(), CharacterCore())) {
+	return iterators::lookahead< 4 >(CharacterCore(text.data()), CharacterCore(text.data() + text.size()));
+}
+
+// Reads up to count characters with the given iterator (which is advanced accordingly)
+auto consume(Iterator &it, const Iterator &end, std::size_t count = static_cast< std::size_t >(-1)) -> std::string {
+	std::string consumed;
+	for (; it != end && consumed.size() < count; ++it) {
+		consumed += *it;
+	}
+	return consumed;
+}
+
+template< typename Function > auto throws_length_error(Function function) -> bool {
+	try {
+		function();
+	} catch (const std::length_error &) {
+		return true;
+	}
+	return false;
+}
+
+int main() {
+	// Plain iteration
+	{
+		const std::string text = "abcdefghij";
+		auto range             = make_range(text);
+
+		TEST_CHECK(std::string(range.begin(), range.end()) == text);
+	}
+
+	// Peeking reads every element only once
+	{
+		const std::string text = "a<=b<c";
+		CharacterCore::reads   = 0;
+		auto range             = make_range(text);
+		Iterator it            = range.begin();
+
+		std::vector< std::string > tokens;
+		while (it != range.end()) {
+			const char *next = iterators::peek(it, 1);
+			if (next != nullptr && *next == '=') {
+				tokens.push_back(std::string(1, *it) + *next);
+				++it;
+			} else {
+				tokens.push_back(std::string(1, *it));
+			}
+			++it;
+		}
+
+		TEST_CHECK(tokens == (std::vector< std::string >{ "a", "<=", "b", "<", "c" }));
+		TEST_CHECK(CharacterCore::reads == static_cast< int >(text.size()));
+	}
+
+	// Peeking at the end
+	{
+		const std::string text = "xy";
+		auto range             = make_range(text);
+		Iterator it            = range.begin();
+
+		TEST_CHECK(*iterators::peek(it, 0) == 'x');
+		TEST_CHECK(*iterators::peek(it, 1) == 'y');
+		TEST_CHECK(iterators::peek(it, 2) == nullptr);
+		TEST_CHECK(iterators::peek(it, 3) == nullptr);
+		TEST_CHECK(throws_length_error([&]() { static_cast< void >(iterators::peek(it, 4)); }));
+
+		++it;
+		++it;
+		TEST_CHECK(it == range.end());
+		TEST_CHECK(iterators::peek(it, 0) == nullptr);
+	}
+
+	// Marking and rewinding
+	{
+		const std::string text = "0123456789";
+		CharacterCore::reads   = 0;
+		auto range             = make_range(text);
+		Iterator it            = range.begin();
+
+		++it;
+		iterators::mark(it);
+		++it;
+		++it;
+		++it;
+		TEST_CHECK(*it == '4');
+		TEST_CHECK(*iterators::peek(it, 0) == '4');
+		TEST_CHECK(throws_length_error([&]() { static_cast< void >(iterators::peek(it, 1)); }));
+
+		iterators::rewind(it);
+		TEST_CHECK(*it == '1');
+		TEST_CHECK(consume(it, range.end(), 3) == "123");
+
+		// The window would have to hold the marked element as well as the next one
+		TEST_CHECK(*it == '4');
+		TEST_CHECK(throws_length_error([&]() { ++it; }));
+		TEST_CHECK(*it == '4');
+
+		iterators::reset_mark(it);
+		TEST_CHECK(consume(it, range.end()) == "456789");
+		TEST_CHECK(CharacterCore::reads == static_cast< int >(text.size()));
+	}
+
+	// Rewinding from the end
+	{
+		const std::string text = "abc";
+		auto range             = make_range(text);
+		Iterator it            = range.begin();
+
+		iterators::mark(it);
+		TEST_CHECK(consume(it, range.end()) == "abc");
+
+		TEST_CHECK(it == range.end());
+		iterators::rewind(it);
+		TEST_CHECK(it != range.end());
+		TEST_CHECK(consume(it, range.end()) == "abc");
+	}
+
+	// Empty input
+	{
+		const std::string text;
+		auto range = make_range(text);
+
+		TEST_CHECK(range.begin() == range.end());
+	}
+
+	return 0;
+}
@@ -0,0 +1,108 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/mapped_records.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+struct Record {
+	std::uint64_t key;
+	double value;
+	std::uint32_t flags;
+};
+
+using Iterator = iterators::mapped_records< Record >::iterator;
+
+static_assert(std::is_same_v< Iterator::iterator_category, std::random_access_iterator_tag >);
+static_assert(std::is_same_v< Iterator::reference, const Record & >, "Records must not be copied on dereference");
+
+auto write_file(const std::string &name, const void *data, std::size_t size) -> std::string {
+	const std::string path = (std::filesystem::temp_directory_path() / name).string();
+	std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+	stream.write(static_cast< const char * >(data), static_cast< std::streamsize >(size));
+	return path;
+}
+
+int main() {
+	std::vector< Record > records(1000);
+	for (std::size_t i = 0; i < records.size(); ++i) {
+		records[i] = { 1000 - i, static_cast< double >(i) / 2, static_cast< std::uint32_t >(i % 3) };
+	}
+
+	// Regular file
+	{
+		const std::string path = write_file("iterators_mapped_records_test.bin", records.data(),
+											records.size() * sizeof(Record));
+		{
+			iterators::mapped_records< Record > mapped(path, iterators::access_pattern::sequential);
+
+			TEST_CHECK(mapped.size() == records.size());
+			TEST_CHECK(mapped.end() - mapped.begin() == static_cast< std::ptrdiff_t >(records.size()));
+			TEST_CHECK(mapped[10].key == 990);
+			TEST_CHECK(mapped.begin()[999].value == 999.0 / 2);
+			TEST_CHECK(&*mapped.begin() == mapped.data());
+
+			mapped.advise(iterators::access_pattern::random);
+
+			// Keys are sorted in descending order
+			auto found = std::lower_bound(mapped.begin(), mapped.end(), 500,
+										  [](const Record &record, std::uint64_t key) { return record.key > key; });
+			TEST_CHECK(found->key == 500 && found - mapped.begin() == 500);
+
+			TEST_CHECK(std::count_if(mapped.begin(), mapped.end(), [](const Record &r) { return r.flags == 1; })
+					   == 333);
+
+			// Moving the mapping keeps the data alive
+			iterators::mapped_records< Record > moved = std::move(mapped);
+			TEST_CHECK(moved.size() == records.size() && moved[0].key == 1000);
+		}
+		std::filesystem::remove(path);
+	}
+
+	// Empty file
+	{
+		const std::string path = write_file("iterators_mapped_records_empty.bin", nullptr, 0);
+		{
+			iterators::mapped_records< Record > mapped(path);
+			TEST_CHECK(mapped.empty());
+			TEST_CHECK(mapped.begin() == mapped.end());
+		}
+		std::filesystem::remove(path);
+	}
+
+	// Truncated record
+	{
+		const std::string path = write_file("iterators_mapped_records_truncated.bin", records.data(), sizeof(Record) + 1);
+		bool caught            = false;
+		try {
+			iterators::mapped_records< Record > mapped(path);
+		} catch (const std::runtime_error &) {
+			caught = true;
+		}
+		TEST_CHECK(caught);
+		std::filesystem::remove(path);
+	}
+
+	// Missing file, reported with the operating system's error code
+	{
+		bool caught = false;
+		try {
+			iterators::mapped_records< Record > mapped(
+				(std::filesystem::temp_directory_path() / "iterators_does_not_exist.bin").string());
+		} catch (const std::system_error &error) {
+			caught = error.code() == std::errc::no_such_file_or_directory;
+		}
+		TEST_CHECK(caught);
+	}
+}
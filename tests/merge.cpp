@@ -0,0 +1,177 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/merge.hpp>
+#include <iterators/cores/set_bits.hpp>
+#include <iterators/iterator_facade.hpp>
+#include <iterators/range.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using Core  = PointerCore< const int >;
+using Range = iterators::range< Core >;
+
+static_assert(std::is_same_v< iterators::merge_iterator< Core >::iterator_category, std::forward_iterator_tag >);
+static_assert(std::is_same_v< iterators::merge_iterator< Core >::reference, const int & >);
+
+// An input core yielding multiples of a step (by value) below a limit
+class MultiplesCore {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+
+	MultiplesCore() = default;
+	MultiplesCore(int current, int step) : m_current(current), m_step(step) {}
+
+	[[nodiscard]] auto dereference() const -> int { return m_current; }
+	[[nodiscard]] auto equals(const MultiplesCore &other) const -> bool { return m_current >= other.m_current; }
+	void increment() { m_current += m_step; }
+
+private:
+	int m_current = 0;
+	int m_step    = 1;
+};
+
+static_assert(std::is_same_v< iterators::merge_iterator< MultiplesCore >::iterator_category,
+							  std::input_iterator_tag >);
+
+auto make_ranges(const std::vector< std::vector< int > > &runs) -> std::vector< Range > {
+	std::vector< Range > ranges;
+	for (const std::vector< int > &run : runs) {
+		ranges.emplace_back(Core(run.data()), Core(run.data() + run.size()));
+	}
+	return ranges;
+}
+
+auto expected_merge(const std::vector< std::vector< int > > &runs) -> std::vector< int > {
+	std::vector< int > all;
+	for (const std::vector< int > &run : runs) {
+		all.insert(all.end(), run.begin(), run.end());
+	}
+	std::sort(all.begin(), all.end());
+	return all;
+}
+
+int main() {
+	std::mt19937 engine(42);
+
+	// Various amounts of inputs, including ones that are no power of two and empty inputs
+	for (std::size_t k : { 0, 1, 2, 3, 5, 8, 13, 64, 100 }) {
+		std::vector< std::vector< int > > runs(k);
+		for (std::vector< int > &run : runs) {
+			run.resize(engine() % 50);
+			for (int &value : run) {
+				value = static_cast< int >(engine() % 100);
+			}
+			std::sort(run.begin(), run.end());
+		}
+
+		const std::vector< Range > ranges = make_ranges(runs);
+		auto merged                       = iterators::merge(ranges);
+		TEST_CHECK(std::vector< int >(merged.begin(), merged.end()) == expected_merge(runs));
+
+		auto unique                   = iterators::merge< iterators::merge_mode::unique >(ranges);
+		std::vector< int > deduplicated = expected_merge(runs);
+		deduplicated.erase(std::unique(deduplicated.begin(), deduplicated.end()), deduplicated.end());
+		TEST_CHECK(std::vector< int >(unique.begin(), unique.end()) == deduplicated);
+	}
+
+	// Custom comparison
+	{
+		const std::vector< std::vector< int > > runs = { { 9, 4, 1 }, { 8, 7, 2 }, { 3 } };
+		auto merged = iterators::merge(make_ranges(runs), std::greater<>());
+		TEST_CHECK(std::vector< int >(merged.begin(), merged.end()) == (std::vector< int >{ 9, 8, 7, 4, 3, 2, 1 }));
+	}
+
+	// The merge is stable: equivalent elements are taken from the inputs in order
+	{
+		const std::vector< std::vector< std::pair< int, int > > > runs = {
+			{ { 1, 0 }, { 2, 0 } }, { { 1, 1 }, { 2, 1 } }, { { 0, 2 }, { 1, 2 } }
+		};
+
+		using PairCore = PointerCore< const std::pair< int, int > >;
+		std::vector< std::pair< PairCore, PairCore > > cores;
+		for (const auto &run : runs) {
+			cores.emplace_back(PairCore(run.data()), PairCore(run.data() + run.size()));
+		}
+
+		auto by_key = [](const std::pair< int, int > &lhs, const std::pair< int, int > &rhs) {
+			return lhs.first < rhs.first;
+		};
+		using MergeCore = iterators::merge_core< PairCore, decltype(by_key) >;
+
+		std::vector< std::pair< int, int > > merged;
+		iterators::iterator_facade< MergeCore > end{ MergeCore() };
+		for (iterators::iterator_facade< MergeCore > iter{ MergeCore(cores, by_key) }; iter != end; ++iter) {
+			merged.push_back(*iter);
+		}
+		TEST_CHECK(merged
+				   == (std::vector< std::pair< int, int > >{
+					   { 0, 2 }, { 1, 0 }, { 1, 1 }, { 1, 2 }, { 2, 0 }, { 2, 1 } }));
+	}
+
+	// Inputs yielding values rather than references
+	{
+		using MergeCore = iterators::merge_core< MultiplesCore, std::less<>, iterators::merge_mode::unique >;
+		std::vector< std::pair< MultiplesCore, MultiplesCore > > inputs = {
+			{ MultiplesCore(0, 2), MultiplesCore(20, 2) },
+			{ MultiplesCore(0, 3), MultiplesCore(20, 3) },
+		};
+
+		std::vector< int > merged;
+		iterators::iterator_facade< MergeCore > end{ MergeCore() };
+		for (iterators::iterator_facade< MergeCore > iter{ MergeCore(inputs) }; iter != end; ++iter) {
+			merged.push_back(*iter);
+		}
+		TEST_CHECK(merged == (std::vector< int >{ 0, 2, 3, 4, 6, 8, 9, 10, 12, 14, 15, 16, 18 }));
+	}
+
+	// Copies are independent (multi-pass)
+	{
+		const std::vector< std::vector< int > > runs = { { 1, 3, 5 }, { 2, 4, 6 } };
+		auto merged                                  = iterators::merge(make_ranges(runs));
+		auto first                                   = merged.begin();
+		auto second                                  = std::next(first, 2);
+		TEST_CHECK(*first == 1 && *second == 3);
+		TEST_CHECK(first != second && std::next(first, 2) == second);
+		TEST_CHECK(std::distance(merged.begin(), merged.end()) == 6);
+	}
+
+	// Inputs whose elements live inside their cores are stored as copies, so that copies of the merge_core don't
+	// refer to the elements of the original
+	{
+		static_assert(iterators::merge_core< iterators::set_bits_core >::stashes_elements);
+		static_assert(!iterators::merge_core< Core >::stashes_elements);
+
+		const std::uint64_t evens[] = { 0b0101 };
+		const std::uint64_t odds[]  = { 0b1010 };
+		const std::vector< iterators::range< iterators::set_bits_core > > inputs = { iterators::set_bits(evens, 1),
+																					 iterators::set_bits(odds, 1) };
+		auto merged = iterators::merge(inputs);
+
+		std::vector< std::size_t > postfix;
+		for (auto iter = merged.begin(); iter != merged.end();) {
+			postfix.push_back(*iter++);
+		}
+		TEST_CHECK(postfix == (std::vector< std::size_t >{ 0, 1, 2, 3 }));
+
+		auto first        = merged.begin();
+		const auto copy   = first;
+		const auto second = std::next(first);
+		++first;
+		TEST_CHECK(*copy == 0 && *first == 1 && *second == 1);
+
+		std::vector< std::size_t > collected(merged.begin(), merged.end());
+		TEST_CHECK(collected == (std::vector< std::size_t >{ 0, 1, 2, 3 }));
+	}
+}
@@ -0,0 +1,71 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/occupied_slots.hpp>
+
+#include <cstddef>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+constexpr std::int8_t empty   = -128;
+constexpr std::int8_t deleted = -2;
+
+void check(const std::vector< std::int8_t > &control) {
+	std::vector< int > slots(control.size());
+	std::vector< int > expected;
+	for (std::size_t i = 0; i < control.size(); ++i) {
+		slots[i] = static_cast< int >(i) * 3;
+		if (control[i] >= 0) {
+			expected.push_back(slots[i]);
+		}
+	}
+
+	std::vector< int > visited;
+	for (int &slot : iterators::occupied_slots(control.data(), slots.data(), control.size())) {
+		visited.push_back(slot);
+	}
+
+	TEST_CHECK(visited == expected);
+}
+
+int main() {
+	check({});
+	check({ empty });
+	check({ 0 });
+	check({ 127 });
+
+	// Sizes around all possible group widths with varying patterns
+	for (std::size_t size : { 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000 }) {
+		std::vector< std::int8_t > control(size, empty);
+		check(control);
+
+		for (std::size_t i = 0; i < size; ++i) {
+			control[i] = static_cast< std::int8_t >(i % 128);
+		}
+		check(control);
+
+		for (std::size_t i = 0; i < size; ++i) {
+			control[i] = (i * 7919) % 5 < 2 ? static_cast< std::int8_t >(i % 100) : (i % 2 == 0 ? empty : deleted);
+		}
+		check(control);
+
+		std::fill(control.begin(), control.end(), empty);
+		control.back() = 42;
+		check(control);
+	}
+
+	// The index of the current slot is available via the iterator
+	std::vector< std::int8_t > control = { empty, 1, deleted, 2 };
+	int slots[4]                       = {};
+	auto range                         = iterators::occupied_slots(control.data(), slots, control.size());
+	auto iter                          = range.begin();
+	TEST_CHECK(&*iter == &slots[1] && iterators::index(iter) == 1);
+	++iter;
+	TEST_CHECK(&*iter == &slots[3] && iterators::index(iter) == 3);
+	++iter;
+	TEST_CHECK(iter == range.end() && iterators::index(iter) == 4);
+}
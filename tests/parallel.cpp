@@ -0,0 +1,144 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/iterator_facade.hpp>
+#include <iterators/parallel/algorithm.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using Iterator        = iterators::iterator_facade< PointerCore< int > >;
+using ForwardIterator = iterators::iterator_facade< PointerCore< int, std::forward_iterator_tag > >;
+
+// A splittable range over forward iterators that knows its size
+class CountedRange {
+public:
+	CountedRange(ForwardIterator begin, std::size_t size) : m_begin(begin), m_size(size) {}
+
+	CountedRange(CountedRange &other, iterators::parallel::split)
+		: m_begin(std::next(other.m_begin, static_cast< std::ptrdiff_t >(other.m_size / 2))),
+		  m_size(other.m_size - other.m_size / 2) {
+		other.m_size /= 2;
+	}
+
+	[[nodiscard]] auto begin() const -> ForwardIterator { return m_begin; }
+	[[nodiscard]] auto end() const -> ForwardIterator {
+		return std::next(m_begin, static_cast< std::ptrdiff_t >(m_size));
+	}
+	[[nodiscard]] auto empty() const -> bool { return m_size == 0; }
+	[[nodiscard]] auto is_divisible() const -> bool { return m_size > 16; }
+
+private:
+	ForwardIterator m_begin;
+	std::size_t m_size;
+};
+
+static_assert(iterators::parallel::is_splittable_range_v< CountedRange >);
+static_assert(iterators::parallel::is_splittable_range_v< iterators::parallel::blocked_range< Iterator > >);
+static_assert(!iterators::parallel::is_splittable_range_v< std::vector< int > >);
+
+int main() {
+	iterators::parallel::thread_pool pool(4);
+
+	std::vector< int > data(100000);
+	std::iota(data.begin(), data.end(), 0);
+
+	Iterator begin(data.data());
+	Iterator end(data.data() + data.size());
+
+	// for_each
+	{
+		std::atomic< long long > sum{ 0 };
+		iterators::parallel::for_each(pool, begin, end, [&sum](int value) { sum += value; });
+		TEST_CHECK(sum == std::accumulate(data.begin(), data.end(), 0LL));
+
+		std::vector< int > copy = data;
+		iterators::parallel::for_each(Iterator(copy.data()), Iterator(copy.data() + copy.size()),
+									  [](int &value) { value *= 2; });
+		for (std::size_t i = 0; i < copy.size(); ++i) {
+			TEST_CHECK(copy[i] == 2 * data[i]);
+		}
+
+		std::atomic< std::size_t > count{ 0 };
+		iterators::parallel::for_each(pool, Iterator(data.data()), Iterator(data.data()), [&count](int) { ++count; });
+		TEST_CHECK(count == 0);
+	}
+
+	// for_each on a splittable range
+	{
+		std::atomic< long long > sum{ 0 };
+		iterators::parallel::for_each(pool, CountedRange(ForwardIterator(data.data()), data.size()),
+									  [&sum](int value) { sum += value; });
+		TEST_CHECK(sum == std::accumulate(data.begin(), data.end(), 0LL));
+	}
+
+	// transform_reduce
+	{
+		const long long expected =
+			std::accumulate(data.begin(), data.end(), 5LL, [](long long acc, int value) { return acc + 3LL * value; });
+
+		TEST_CHECK(iterators::parallel::transform_reduce(pool, begin, end, 5LL, std::plus<>{},
+														 [](int value) { return 3LL * value; })
+				   == expected);
+		TEST_CHECK(iterators::parallel::transform_reduce(CountedRange(ForwardIterator(data.data()), data.size()), 5LL,
+														 std::plus<>{}, [](int value) { return 3LL * value; })
+				   == expected);
+		TEST_CHECK(iterators::parallel::transform_reduce(pool, begin, begin, 7LL, std::plus<>{},
+														 [](int value) { return 3LL * value; })
+				   == 7);
+	}
+
+	// copy_if
+	{
+		auto is_interesting = [](int value) { return value % 7 == 3; };
+
+		std::vector< int > expected;
+		std::copy_if(data.begin(), data.end(), std::back_inserter(expected), is_interesting);
+
+		std::vector< int > result(data.size(), -1);
+		Iterator result_end = iterators::parallel::copy_if(pool, begin, end, Iterator(result.data()), is_interesting);
+
+		TEST_CHECK(result_end - Iterator(result.data()) == static_cast< std::ptrdiff_t >(expected.size()));
+		TEST_CHECK(std::equal(expected.begin(), expected.end(), result.begin()));
+		TEST_CHECK(result[expected.size()] == -1);
+	}
+
+	// sort
+	{
+		std::vector< int > shuffled(data.rbegin(), data.rend());
+		for (std::size_t i = 0; i < shuffled.size(); i += 3) {
+			std::swap(shuffled[i], shuffled[(i * 7919) % shuffled.size()]);
+		}
+
+		iterators::parallel::sort(pool, Iterator(shuffled.data()), Iterator(shuffled.data() + shuffled.size()));
+		TEST_CHECK(shuffled == data);
+
+		iterators::parallel::sort(Iterator(shuffled.data()), Iterator(shuffled.data() + shuffled.size()),
+								  std::greater<>{});
+		TEST_CHECK(std::is_sorted(shuffled.begin(), shuffled.end(), std::greater<>{}));
+	}
+
+	// Exceptions thrown by the user-provided function are propagated to the caller
+	{
+		bool caught = false;
+		try {
+			iterators::parallel::for_each(pool, begin, end, [](int value) {
+				if (value == 4242) {
+					throw std::runtime_error("error");
+				}
+			});
+		} catch (const std::runtime_error &) {
+			caught = true;
+		}
+		TEST_CHECK(caught);
+	}
+}
@@ -0,0 +1,176 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/permutation.hpp>
+#include <iterators/iterator_facade.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Single-pass indices, whose copies all read from the same position in the underlying stream of indices
+class InputIndexCore {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+
+	InputIndexCore() = default;
+	InputIndexCore(const std::vector< std::size_t > &indices)
+		: m_indices(&indices), m_position(std::make_shared< std::size_t >(0)) {}
+
+	[[nodiscard]] auto dereference() const -> std::size_t { return (*m_indices)[*m_position]; }
+	[[nodiscard]] auto equals(const InputIndexCore &other) const -> bool { return at_end() == other.at_end(); }
+	void increment() { ++*m_position; }
+
+private:
+	const std::vector< std::size_t > *m_indices = nullptr;
+	std::shared_ptr< std::size_t > m_position;
+
+	[[nodiscard]] auto at_end() const -> bool { return !m_position || *m_position == m_indices->size(); }
+};
+
+template< typename Range > auto collect(const Range &range) -> std::vector< std::decay_t< decltype(*range.begin()) > > {
+	return { range.begin(), range.end() };
+}
+
+// Gathers the given values through the indices via the bulk interface as well as via a permutation range
+template< std::size_t Distance, typename T >
+void check_gather(const std::vector< T > &values, const std::vector< std::int32_t > &indices) {
+	std::vector< T > expected;
+	for (std::int32_t index : indices) {
+		expected.push_back(values[static_cast< std::size_t >(index)]);
+	}
+
+	std::vector< T > gathered(indices.size());
+	T *end = iterators::gather(values.data(), indices.data(), indices.data() + indices.size(), gathered.data());
+	TEST_CHECK(end == gathered.data() + gathered.size());
+	TEST_CHECK(gathered == expected);
+
+	// Reserving the memory up front keeps GCC 12 (-O3 with AVX) from reporting the vector's reallocations as freeing a
+	// pointer that doesn't point to the start of an allocation (-Wfree-nonheap-object)
+	std::vector< T > inserted;
+	inserted.reserve(indices.size());
+	iterators::gather(values.data(), indices.data(), indices.data() + indices.size(), std::back_inserter(inserted));
+	TEST_CHECK(inserted == expected);
+
+	auto permutation = iterators::permuted< Distance >(
+		PointerCore< const T >(values.data()), PointerCore< const std::int32_t >(indices.data()),
+		PointerCore< const std::int32_t >(indices.data() + indices.size()));
+	TEST_CHECK(collect(permutation) == expected);
+}
+
+int main() {
+	using Values  = PointerCore< int >;
+	using Indices = PointerCore< const std::size_t >;
+
+	static_assert(std::is_same_v< iterators::permutation_iterator< Values, Indices >::iterator_category,
+								  std::random_access_iterator_tag >);
+	static_assert(std::is_same_v< iterators::permutation_iterator< Values, Indices >::reference, int & >);
+
+	// The category is the one of the indices
+	using ForwardIndices = PointerCore< const std::size_t, std::forward_iterator_tag >;
+	static_assert(std::is_same_v< iterators::permutation_iterator< Values, ForwardIndices >::iterator_category,
+								  std::forward_iterator_tag >);
+
+	std::vector< int > values                = { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 };
+	const std::vector< std::size_t > indices = { 9, 0, 4, 4, 2, 7 };
+
+	// Iteration in index order, writing through the permutation
+	{
+		auto permutation = iterators::permuted(Values(values.data()), Indices(indices.data()),
+											   Indices(indices.data() + indices.size()));
+		TEST_CHECK(collect(permutation) == (std::vector< int >{ 19, 10, 14, 14, 12, 17 }));
+		TEST_CHECK(&*permutation.begin() == &values[9]);
+
+		for (int &value : permutation) {
+			value += 100;
+		}
+		TEST_CHECK(values == (std::vector< int >{ 110, 11, 112, 13, 214, 15, 16, 117, 18, 119 }));
+	}
+
+	// Random access and moving backwards (which resets the look-ahead)
+	{
+		auto permutation = iterators::permuted< 2 >(Values(values.data()), Indices(indices.data()),
+													Indices(indices.data() + indices.size()));
+		auto it          = permutation.begin();
+
+		TEST_CHECK(it[4] == 112);
+		TEST_CHECK(permutation.end() - it == 6);
+
+		it += 5;
+		TEST_CHECK(*it == 117);
+		--it;
+		--it;
+		TEST_CHECK(*it == 214);
+		++it;
+		++it;
+		TEST_CHECK(*it == 117);
+		++it;
+		TEST_CHECK(it == permutation.end());
+
+		std::vector< int > reversed;
+		std::reverse_copy(permutation.begin(), permutation.end(), std::back_inserter(reversed));
+		TEST_CHECK(reversed == (std::vector< int >{ 117, 112, 214, 214, 110, 119 }));
+	}
+
+	// Sources of iterator facades
+	{
+		const iterators::iterator_facade< Values > first_value(Values(values.data()));
+		const iterators::iterator_facade< Indices > first(Indices(indices.data()));
+		const iterators::iterator_facade< Indices > last(Indices(indices.data() + 2));
+
+		TEST_CHECK(collect(iterators::permuted(first_value, first, last)) == (std::vector< int >{ 119, 110 }));
+	}
+
+	// Single-pass indices are consumed exactly once, so nothing is prefetched through them
+	{
+		static_assert(iterators::permutation_core< Values, InputIndexCore >::prefetch_distance == 0);
+		static_assert(iterators::permutation_core< Values, Indices >::prefetch_distance == 8);
+
+		const std::vector< double > halves      = { 0.5, 1.5, 2.5, 3.5, 4.5 };
+		const std::vector< std::size_t > stream = { 4, 3, 2, 1, 0 };
+
+		auto permutation = iterators::permuted(PointerCore< const double >(halves.data()), InputIndexCore(stream),
+											   InputIndexCore());
+		TEST_CHECK(collect(permutation) == (std::vector< double >{ 4.5, 3.5, 2.5, 1.5, 0.5 }));
+	}
+
+	// Bulk gathers of all supported value types, with sizes that don't fill the vector registers
+	{
+		std::vector< std::int32_t > positions;
+		for (std::int32_t i = 0; i < 203; ++i) {
+			positions.push_back((i * 7919) % 1000);
+		}
+
+		std::vector< float > floats;
+		std::vector< double > doubles;
+		std::vector< std::int32_t > ints;
+		std::vector< std::uint64_t > longs;
+		std::vector< char > chars;
+		for (int i = 0; i < 1000; ++i) {
+			floats.push_back(static_cast< float >(i) / 2);
+			doubles.push_back(static_cast< double >(i) * 3);
+			ints.push_back(-i);
+			longs.push_back(static_cast< std::uint64_t >(i) << 40U);
+			chars.push_back(static_cast< char >(i));
+		}
+
+		for (std::size_t size : { 0, 1, 3, 4, 7, 8, 9, 16, 17, 203 }) {
+			const std::vector< std::int32_t > subset(positions.begin(), positions.begin() + size);
+
+			check_gather< 0 >(floats, subset);
+			check_gather< 4 >(doubles, subset);
+			check_gather< 8 >(ints, subset);
+			check_gather< 16 >(longs, subset);
+			check_gather< 8 >(chars, subset);
+		}
+	}
+
+	return 0;
+}
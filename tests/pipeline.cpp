@@ -0,0 +1,200 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/delta_vbyte.hpp>
+#include <iterators/cores/iota.hpp>
+#include <iterators/cores/set_bits.hpp>
+#include <iterators/iterator_facade.hpp>
+#include <iterators/pipeline.hpp>
+#include <iterators/range.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using iterators::filter;
+using iterators::take;
+using iterators::transform;
+
+// An unbounded input core counting upwards and recording how many numbers have been read
+class CountingCore {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+
+	static inline int reads = 0;
+
+	CountingCore() = default;
+	CountingCore(int current) : m_current(current) {}
+
+	[[nodiscard]] auto dereference() const -> int {
+		++reads;
+		return m_current;
+	}
+	[[nodiscard]] auto equals(const CountingCore &other) const -> bool { return m_current == other.m_current; }
+	void increment() { ++m_current; }
+
+private:
+	int m_current = 0;
+};
+
+// A range of all non-negative integers
+struct Naturals {
+	[[nodiscard]] auto begin() const -> iterators::iterator_facade< CountingCore > { return CountingCore(0); }
+	[[nodiscard]] auto end() const -> iterators::iterator_facade< CountingCore > { return CountingCore(-1); }
+};
+
+template< typename Range > auto collect(const Range &range) -> std::vector< std::decay_t< decltype(*range.begin()) > > {
+	return { range.begin(), range.end() };
+}
+
+int main() {
+	const std::vector< int > numbers = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+	auto is_odd = [](int value) { return value % 2 != 0; };
+	auto square = [](int value) { return value * value; };
+
+	// Single stages
+	{
+		TEST_CHECK(collect(numbers | filter(is_odd)) == (std::vector< int >{ 1, 3, 5, 7, 9 }));
+		TEST_CHECK(collect(numbers | transform(square))
+				   == (std::vector< int >{ 1, 4, 9, 16, 25, 36, 49, 64, 81, 100 }));
+		TEST_CHECK(collect(numbers | take(3)) == (std::vector< int >{ 1, 2, 3 }));
+		TEST_CHECK(collect(numbers | take(20)) == numbers);
+		TEST_CHECK(collect(numbers | take(0)).empty());
+	}
+
+	// Combined stages are applied in order
+	{
+		auto pipeline = numbers | filter(is_odd) | transform(square) | take(3);
+		TEST_CHECK(collect(pipeline) == (std::vector< int >{ 1, 9, 25 }));
+
+		auto reordered = numbers | transform(square) | take(3) | filter(is_odd);
+		TEST_CHECK(collect(reordered) == (std::vector< int >{ 1, 9 }));
+
+		auto converted = numbers | filter([](int value) { return value > 8; })
+						 | transform([](int value) { return std::to_string(value); })
+						 | transform([](const std::string &text) { return text + "!"; });
+		TEST_CHECK(collect(converted) == (std::vector< std::string >{ "9!", "10!" }));
+
+		TEST_CHECK(collect(numbers | filter([](int) { return false; }) | transform(square)).empty());
+	}
+
+	// The iterator category is at most forward and stages without transforms yield references into the source
+	{
+		auto filtered = numbers | filter(is_odd);
+		static_assert(std::is_same_v< decltype(filtered)::iterator::iterator_category, std::forward_iterator_tag >);
+		static_assert(std::is_same_v< decltype(filtered)::iterator::reference, const int & >);
+		TEST_CHECK(&*filtered.begin() == &numbers[0]);
+
+		auto transformed = numbers | transform(square);
+		static_assert(std::is_same_v< decltype(transformed)::iterator::reference, const int & >);
+
+		// Multiple passes
+		auto it   = filtered.begin();
+		auto copy = it;
+		++it;
+		TEST_CHECK(*copy == 1 && *it == 3);
+		TEST_CHECK(copy != it && std::next(copy) == it);
+		TEST_CHECK(std::distance(filtered.begin(), filtered.end()) == 5);
+	}
+
+	// Unbounded input sources are only read as far as necessary
+	{
+		CountingCore::reads = 0;
+		auto pipeline       = Naturals() | filter(is_odd) | transform(square) | take(4);
+		static_assert(std::is_same_v< decltype(pipeline)::iterator::iterator_category, std::input_iterator_tag >);
+
+		TEST_CHECK(collect(pipeline) == (std::vector< int >{ 1, 9, 25, 49 }));
+		TEST_CHECK(CountingCore::reads == 8);
+
+		// A take stage followed by a filter
+		CountingCore::reads = 0;
+		TEST_CHECK(collect(Naturals() | take(5) | filter(is_odd)) == (std::vector< int >{ 1, 3 }));
+		TEST_CHECK(CountingCore::reads == 5);
+	}
+
+	// Push-style iteration
+	{
+		std::vector< int > pushed;
+		(numbers | filter(is_odd) | transform(square)).for_each([&](int value) { pushed.push_back(value); });
+		TEST_CHECK(pushed == (std::vector< int >{ 1, 9, 25, 49, 81 }));
+
+		CountingCore::reads = 0;
+		pushed.clear();
+		(Naturals() | transform(square) | take(3)).for_each([&](int value) { pushed.push_back(value); });
+		TEST_CHECK(pushed == (std::vector< int >{ 0, 1, 4 }));
+		TEST_CHECK(CountingCore::reads == 3);
+
+		// Elements without transforms are passed on as references
+		int sum = 0;
+		(numbers | take(2)).for_each([&](const int &value) {
+			TEST_CHECK(&value == &numbers[0] || &value == &numbers[1]);
+			sum += value;
+		});
+		TEST_CHECK(sum == 3);
+	}
+
+	// Writing through the pipeline
+	{
+		std::vector< int > values = { 1, 2, 3, 4 };
+		for (int &value : values | filter(is_odd)) {
+			value = 0;
+		}
+		TEST_CHECK(values == (std::vector< int >{ 0, 2, 0, 4 }));
+	}
+
+	// Sources of iterator facades
+	{
+		std::vector< int > values = { 5, 6, 7 };
+		const iterators::range< PointerCore< int > > source(PointerCore< int >(values.data()),
+															PointerCore< int >(values.data() + values.size()));
+		TEST_CHECK(collect(source | transform(square) | filter(is_odd)) == (std::vector< int >{ 25, 49 }));
+	}
+
+	// Sources whose elements live inside their cores: the pipeline stores copies of the elements instead of pointers,
+	// which would dangle once the pipeline core is copied or moved (e.g. into the iterator returned by begin())
+	{
+		auto is_even = [](int value) { return value % 2 == 0; };
+
+		const std::vector< std::uint32_t > encoded = { 10, 20, 30, 40, 50 };
+		const iterators::delta_vbyte_sequence sequence(encoded.begin(), encoded.end());
+		std::vector< std::uint32_t > decoded;
+		for (std::uint32_t value : sequence | filter([](std::uint32_t value) { return value > 15; })) {
+			decoded.push_back(value);
+		}
+		TEST_CHECK(decoded == (std::vector< std::uint32_t >{ 20, 30, 40, 50 }));
+
+		auto evens = iterators::iota(0, 10) | filter(is_even);
+		static_assert(decltype(evens)::core_type::stashes_elements);
+		std::vector< int > collected;
+		for (int value : evens) {
+			collected.push_back(value);
+		}
+		TEST_CHECK(collected == (std::vector< int >{ 0, 2, 4, 6, 8 }));
+
+		// Copies of a (forward) pipeline iterator refer to their own elements
+		auto it   = evens.begin();
+		auto copy = it;
+		++it;
+		const auto moved = std::move(copy);
+		TEST_CHECK(*moved == 0 && *it == 2);
+		TEST_CHECK(*std::next(moved, 2) == 4);
+
+		const std::uint64_t words[] = { 0b1011, 0b1 };
+		std::vector< std::size_t > positions;
+		for (std::size_t position : iterators::set_bits(words, 2) | filter([](std::size_t bit) { return bit != 1; })) {
+			positions.push_back(position);
+		}
+		TEST_CHECK(positions == (std::vector< std::size_t >{ 0, 3, 64 }));
+
+		// Pointers are only stored for references into the source range
+		static_assert(!decltype(numbers | filter(is_odd))::core_type::stashes_elements);
+	}
+
+	return 0;
+}
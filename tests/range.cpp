@@ -0,0 +1,100 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/iterator_facade.hpp>
+#include <iterators/range.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// A forward core that can't compute distances
+struct ForwardCore {
+	using target_iterator_category = std::forward_iterator_tag;
+
+	constexpr ForwardCore() = default;
+	constexpr ForwardCore(const int *ptr) : m_ptr(ptr) {}
+
+	[[nodiscard]] constexpr auto dereference() const -> const int & { return *m_ptr; }
+	[[nodiscard]] constexpr auto equals(const ForwardCore &other) const -> bool { return m_ptr == other.m_ptr; }
+	constexpr void increment() { ++m_ptr; }
+
+private:
+	const int *m_ptr = nullptr;
+};
+
+// A sentinel marking the first zero in a sequence
+struct ZeroSentinel {
+	friend auto operator==(const iterators::iterator_facade< ForwardCore > &iter, ZeroSentinel) -> bool {
+		return *iter == 0;
+	}
+	friend auto operator!=(const iterators::iterator_facade< ForwardCore > &iter, ZeroSentinel) -> bool {
+		return *iter != 0;
+	}
+};
+
+template< typename T, typename = void > struct has_size : std::false_type {};
+template< typename T > struct has_size< T, std::void_t< decltype(std::declval< T >().size()) > > : std::true_type {};
+
+using RandomAccessRange = iterators::range< PointerCore< const int > >;
+using DistanceRange     = iterators::range< PointerCore< const int, std::forward_iterator_tag > >;
+using ForwardRange      = iterators::range< ForwardCore >;
+using CachedSizeRange =
+	iterators::range< ForwardCore, iterators::iterator_facade< ForwardCore >, iterators::subrange_kind::sized >;
+using SentinelRange     = iterators::range< ForwardCore, ZeroSentinel >;
+
+static_assert(has_size< RandomAccessRange >::value, "Random access ranges know their size");
+static_assert(has_size< DistanceRange >::value, "Ranges over cores implementing distance_to know their size");
+static_assert(!has_size< ForwardRange >::value, "Forward ranges don't know their size");
+static_assert(has_size< CachedSizeRange >::value, "Ranges constructed with a size know their size");
+static_assert(!has_size< SentinelRange >::value, "Sentinel-delimited ranges don't know their size");
+
+static_assert(sizeof(RandomAccessRange) == 2 * sizeof(const int *), "Computed sizes must not be stored");
+static_assert(sizeof(ForwardRange) == 2 * sizeof(const int *), "Unsized ranges must not store a size");
+static_assert(sizeof(CachedSizeRange) > 2 * sizeof(const int *), "Cached sizes must be stored");
+
+static_assert(std::is_same_v< decltype(iterators::subrange(std::declval< iterators::iterator_facade< ForwardCore > >(),
+														   std::declval< iterators::iterator_facade< ForwardCore > >(),
+														   std::size_t{})),
+							  CachedSizeRange >,
+			  "Passing a size must deduce a sized subrange");
+
+#ifdef __cpp_lib_ranges
+static_assert(std::ranges::sized_range< RandomAccessRange >);
+static_assert(std::ranges::sized_range< DistanceRange >);
+static_assert(std::ranges::sized_range< CachedSizeRange >);
+static_assert(std::ranges::forward_range< ForwardRange > && !std::ranges::sized_range< ForwardRange >);
+static_assert(std::ranges::borrowed_range< ForwardRange >);
+#endif
+
+auto count_elements(const SentinelRange &range) -> std::size_t {
+	std::size_t count = 0;
+	for (auto iter = range.begin(); iter != range.end(); ++iter) {
+		++count;
+	}
+	return count;
+}
+
+int main() {
+	const int numbers[] = { 1, 2, 3, 4, 0, 5 };
+
+	TEST_CHECK(RandomAccessRange(PointerCore< const int >(numbers), PointerCore< const int >(numbers + 6)).size() == 6);
+	TEST_CHECK(DistanceRange(PointerCore< const int, std::forward_iterator_tag >(numbers),
+							 PointerCore< const int, std::forward_iterator_tag >(numbers + 4))
+				   .size()
+			   == 4);
+	TEST_CHECK(CachedSizeRange(ForwardCore(numbers), ForwardCore(numbers + 3), 3).size() == 3);
+	TEST_CHECK(!ForwardRange(ForwardCore(numbers), ForwardCore(numbers + 3)).empty());
+	TEST_CHECK(ForwardRange(ForwardCore(numbers), ForwardCore(numbers)).empty());
+	TEST_CHECK(CachedSizeRange(ForwardCore(numbers), ForwardCore(numbers), 0).empty());
+	TEST_CHECK(count_elements(SentinelRange(ForwardCore(numbers), ZeroSentinel{})) == 4);
+
+	int sum = 0;
+	for (int value : ForwardRange(ForwardCore(numbers), ForwardCore(numbers + 6))) {
+		sum += value;
+	}
+	TEST_CHECK(sum == 15);
+}
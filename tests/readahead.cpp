@@ -0,0 +1,125 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/iterator_facade.hpp>
+#include <iterators/parallel/readahead.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// An input core generating the numbers [0, limit) that fails at a given position and counts how many numbers have
+// been generated
+class CountingCore {
+public:
+	using target_iterator_category = std::input_iterator_tag;
+
+	CountingCore() = default;
+	CountingCore(int current, int fail_at, std::atomic< int > *generated)
+		: m_current(current), m_fail_at(fail_at), m_generated(generated) {}
+
+	[[nodiscard]] auto dereference() const -> int {
+		if (m_current == m_fail_at) {
+			throw std::runtime_error("Source failed");
+		}
+		++*m_generated;
+		return m_current;
+	}
+	[[nodiscard]] auto equals(const CountingCore &other) const -> bool { return m_current == other.m_current; }
+	void increment() { ++m_current; }
+
+private:
+	int m_current                   = 0;
+	int m_fail_at                   = -1;
+	std::atomic< int > *m_generated = nullptr;
+};
+
+using ReadaheadIterator = iterators::parallel::readahead_iterator< CountingCore >;
+
+static_assert(std::is_same_v< ReadaheadIterator::iterator_category, std::input_iterator_tag >);
+static_assert(std::is_same_v< ReadaheadIterator::reference, const int & >);
+
+int main() {
+	std::atomic< int > generated = 0;
+
+	// Complete iteration with various block configurations
+	for (std::size_t block_size : { 1, 3, 64, 5000 }) {
+		for (std::size_t block_count : { 0, 3, 8 }) {
+			std::vector< int > values;
+			for (int value : iterators::parallel::readahead(CountingCore(0, -1, &generated),
+															CountingCore(1000, -1, &generated), block_size,
+															block_count)) {
+				values.push_back(value);
+			}
+
+			std::vector< int > expected(1000);
+			std::iota(expected.begin(), expected.end(), 0);
+			TEST_CHECK(values == expected);
+		}
+	}
+
+	// Empty input
+	{
+		auto range = iterators::parallel::readahead(CountingCore(5, -1, &generated), CountingCore(5, -1, &generated));
+		TEST_CHECK(range.begin() == range.end());
+	}
+
+	// Iterators over regular containers
+	{
+		std::vector< std::string > words = { "read", "ahead" };
+		std::string joined;
+		for (const std::string &word : iterators::parallel::readahead(
+				 iterators::iterator_facade< PointerCore< std::string > >(words.data()),
+				 iterators::iterator_facade< PointerCore< std::string > >(words.data() + words.size()))) {
+			joined += word;
+		}
+		TEST_CHECK(joined == "readahead");
+	}
+
+	// Postfix increments across block boundaries
+	{
+		auto range = iterators::parallel::readahead(CountingCore(0, -1, &generated), CountingCore(100, -1, &generated), 2);
+		int sum    = 0;
+		for (auto iter = range.begin(); iter != range.end();) {
+			sum += *iter++;
+		}
+		TEST_CHECK(sum == 4950);
+	}
+
+	// Exceptions are rethrown after all previously produced elements have been delivered
+	{
+		std::vector< int > values;
+		bool caught = false;
+		try {
+			for (int value : iterators::parallel::readahead(CountingCore(0, 150, &generated),
+															CountingCore(1000, -1, &generated), 64)) {
+				values.push_back(value);
+			}
+		} catch (const std::runtime_error &) {
+			caught = true;
+		}
+		TEST_CHECK(caught);
+		TEST_CHECK(values.size() == 150 && values.back() == 149);
+	}
+
+	// Abandoning an iteration cancels the producer
+	{
+		generated = 0;
+		{
+			auto range = iterators::parallel::readahead(CountingCore(0, -1, &generated),
+														CountingCore(1 << 30, -1, &generated), 16, 4);
+			auto iter = range.begin();
+			TEST_CHECK(*iter == 0);
+		}
+		// At most all blocks plus the element that was in flight when the cancellation happened
+		TEST_CHECK(generated <= 16 * 4 + 1);
+	}
+}
@@ -0,0 +1,143 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/iota.hpp>
+#include <iterators/cores/reverse.hpp>
+#include <iterators/cores/transform.hpp>
+#include <iterators/iterator_facade.hpp>
+#include <iterators/range.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using Iterator              = iterators::iterator_facade< PointerCore< int > >;
+using BidirectionalIterator = iterators::iterator_facade< PointerCore< int, std::bidirectional_iterator_tag > >;
+
+static_assert(std::is_same_v< iterators::reverse_iterator< PointerCore< int > >::iterator_category,
+							  std::random_access_iterator_tag >,
+			  "Random access is retained");
+static_assert(std::is_same_v< iterators::reverse_iterator< PointerCore< int > >::reference, int & >);
+static_assert(std::is_same_v<
+				  iterators::reverse_iterator< PointerCore< int, std::bidirectional_iterator_tag > >::iterator_category,
+				  std::bidirectional_iterator_tag >);
+
+// A bidirectional core that counts how often it is copied
+struct CopyCountingCore {
+	using target_iterator_category = std::bidirectional_iterator_tag;
+
+	static inline int copies = 0;
+
+	CopyCountingCore() = default;
+	CopyCountingCore(const int *ptr) : m_ptr(ptr) {}
+	CopyCountingCore(const CopyCountingCore &other) : m_ptr(other.m_ptr) { ++copies; }
+	auto operator=(const CopyCountingCore &other) -> CopyCountingCore & {
+		m_ptr = other.m_ptr;
+		++copies;
+		return *this;
+	}
+
+	[[nodiscard]] auto dereference() const -> const int & { return *m_ptr; }
+	[[nodiscard]] auto equals(const CopyCountingCore &other) const -> bool { return m_ptr == other.m_ptr; }
+	void increment() { ++m_ptr; }
+	void decrement() { --m_ptr; }
+
+private:
+	const int *m_ptr = nullptr;
+};
+
+int main() {
+	std::vector< int > numbers = { 1, 2, 3, 4, 5, 6, 7 };
+	const Iterator begin(numbers.data());
+	const Iterator end(numbers.data() + numbers.size());
+
+	// Iteration
+	{
+		auto reversed = iterators::reversed(begin, end);
+		TEST_CHECK(std::vector< int >(reversed.begin(), reversed.end()) == (std::vector< int >{ 7, 6, 5, 4, 3, 2, 1 }));
+		TEST_CHECK(reversed.size() == numbers.size());
+
+		// Writing through the reversed iterators
+		*reversed.begin() = 70;
+		TEST_CHECK(numbers.back() == 70);
+		numbers.back() = 7;
+
+		// Reversing twice yields the original order
+		auto twice = iterators::reversed(reversed);
+		TEST_CHECK(std::vector< int >(twice.begin(), twice.end()) == numbers);
+	}
+
+	// Random access
+	{
+		auto reversed = iterators::reversed(iterators::range< PointerCore< int > >(begin, end));
+		auto rbegin   = reversed.begin();
+		auto rend     = reversed.end();
+
+		TEST_CHECK(rend - rbegin == 7);
+		TEST_CHECK(rbegin[2] == 5);
+		TEST_CHECK(*(rend - 1) == 1);
+		TEST_CHECK(rend - 7 == rbegin);
+		TEST_CHECK(rbegin + 7 == rend);
+		TEST_CHECK(*(rbegin + 6) == 1 && rbegin + 6 < rend);
+		TEST_CHECK(std::prev(rend, 3) - rbegin == 4);
+
+		// Searching in descending data
+		auto found = std::lower_bound(rbegin, rend, 3, std::greater<>());
+		TEST_CHECK(*found == 3 && found - rbegin == 4);
+
+		std::vector< int > copy(numbers.size());
+		std::reverse_copy(numbers.begin(), numbers.end(), copy.begin());
+		TEST_CHECK(std::equal(rbegin, rend, copy.begin()));
+	}
+
+	// Bidirectional cores
+	{
+		auto reversed = iterators::reversed(BidirectionalIterator(numbers.data()),
+											BidirectionalIterator(numbers.data() + numbers.size()));
+		auto iter     = reversed.end();
+		--iter;
+		TEST_CHECK(*iter == 1);
+		--iter;
+		TEST_CHECK(*iter == 2);
+		++iter;
+		++iter;
+		TEST_CHECK(iter == reversed.end());
+	}
+
+	// Empty ranges
+	{
+		auto reversed = iterators::reversed(begin, begin);
+		TEST_CHECK(reversed.begin() == reversed.end());
+		TEST_CHECK(reversed.empty());
+	}
+
+	// Dereferencing does not copy the underlying core
+	{
+		using ReverseIterator = iterators::reverse_iterator< CopyCountingCore >;
+		const ReverseIterator rbegin(iterators::reverse_core< CopyCountingCore >(
+			CopyCountingCore(numbers.data()), CopyCountingCore(numbers.data() + numbers.size())));
+
+		CopyCountingCore::copies = 0;
+		int sum                  = 0;
+		for (int i = 0; i < 10; ++i) {
+			sum += *rbegin;
+		}
+		TEST_CHECK(sum == 70 && CopyCountingCore::copies == 0);
+	}
+
+	// Elements stashed inside the underlying core are copied by operator[], as they die with the temporary iterator
+	{
+		auto reversed = iterators::reversed(
+			iterators::transformed(iterators::iota(0, 10), [](int number) { return std::to_string(number); }));
+		static_assert(std::is_same_v< decltype(reversed.begin()[3]), std::string >);
+
+		TEST_CHECK(reversed.begin()[3] == "6");
+		TEST_CHECK(std::string(reversed.begin()[9]) == "0");
+	}
+}
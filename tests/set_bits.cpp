@@ -0,0 +1,66 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/set_bits.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+static_assert(std::is_same_v< iterators::set_bits_iterator::iterator_category, std::forward_iterator_tag >);
+static_assert(std::is_same_v< iterators::set_bits_iterator::value_type, std::size_t >);
+
+auto naive_set_bits(const std::vector< std::uint64_t > &words) -> std::vector< std::size_t > {
+	std::vector< std::size_t > positions;
+	for (std::size_t i = 0; i < words.size() * 64; ++i) {
+		if ((words[i / 64] >> (i % 64)) & 1U) {
+			positions.push_back(i);
+		}
+	}
+	return positions;
+}
+
+void check(const std::vector< std::uint64_t > &words) {
+	const std::vector< std::size_t > expected = naive_set_bits(words);
+
+	std::vector< std::size_t > iterated;
+	for (std::size_t position : iterators::set_bits(words.data(), words.size())) {
+		iterated.push_back(position);
+	}
+	TEST_CHECK(iterated == expected);
+
+	std::vector< std::size_t > decoded;
+	iterators::decode_set_bits(words.data(), words.size(), std::back_inserter(decoded));
+	TEST_CHECK(decoded == expected);
+
+	std::vector< std::uint32_t > buffer(expected.size() + 1, 0xFFFFFFFF);
+	auto end = iterators::decode_set_bits(words.data(), words.size(), buffer.data());
+	TEST_CHECK(end == buffer.data() + expected.size());
+	TEST_CHECK(buffer.back() == 0xFFFFFFFF);
+}
+
+int main() {
+	check({});
+	check({ 0 });
+	check({ 0, 0, 0 });
+	check({ 1 });
+	check({ 0x8000000000000000ULL });
+	check({ 0, 0, 0x8000000000000000ULL });
+	check({ 0xFFFFFFFFFFFFFFFFULL, 0, 0xFFFFFFFFFFFFFFFFULL });
+	check({ 0x0123456789ABCDEFULL, 0, 0, 0xFEDCBA9876543210ULL, 0, 1 });
+
+	// Iterators are multi-pass
+	const std::vector< std::uint64_t > words = { 0b1011, 0, 0b1 };
+	auto range                               = iterators::set_bits(words.data(), words.size());
+	auto first                               = range.begin();
+	auto second                              = first;
+	++second;
+	TEST_CHECK(*first == 0 && *second == 1);
+	TEST_CHECK(*std::next(first, 3) == 128);
+	TEST_CHECK(std::next(first, 4) == range.end());
+	TEST_CHECK(std::distance(range.begin(), range.end()) == 4);
+}
@@ -0,0 +1,137 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/parallel/spsc_ring.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using iterators::parallel::spsc_ring;
+using iterators::parallel::wait_policy;
+
+static_assert(std::is_same_v< iterators::parallel::spsc_writer_iterator< int >::iterator_category,
+							  std::output_iterator_tag >);
+static_assert(std::is_same_v< iterators::parallel::spsc_reader_iterator< int >::iterator_category,
+							  std::input_iterator_tag >);
+static_assert(std::is_same_v< iterators::parallel::spsc_reader_iterator< int >::reference, int & >);
+
+template< typename Range > auto collect(const Range &range) -> std::vector< int > {
+	std::vector< int > elements;
+	for (int element : range) {
+		elements.push_back(element);
+	}
+	return elements;
+}
+
+// Hands the given elements from one thread to another via std::copy
+template< wait_policy Policy > void check_transfer(std::size_t capacity, std::size_t batch_size) {
+	std::vector< int > input(100000);
+	std::iota(input.begin(), input.end(), 0);
+
+	spsc_ring< int, Policy > ring(capacity, batch_size);
+
+	std::thread producer([&]() {
+		std::copy(input.begin(), input.end(), ring.writer());
+		ring.close();
+	});
+
+	std::vector< int > output;
+	auto reader = ring.reader();
+	std::copy(reader.begin(), reader.end(), std::back_inserter(output));
+	producer.join();
+
+	TEST_CHECK(output == input);
+}
+
+int main() {
+	// Sizes
+	{
+		TEST_CHECK(spsc_ring< int >(0).capacity() == 2);
+		TEST_CHECK(spsc_ring< int >(5).capacity() == 8);
+		TEST_CHECK(spsc_ring< int >(64).capacity() == 64);
+		TEST_CHECK(spsc_ring< int >(8, 0).batch_size() == 1);
+		TEST_CHECK(spsc_ring< int >(8, 100).batch_size() == 8);
+	}
+
+	// Single-threaded use, including both ways of writing to an output iterator
+	{
+		spsc_ring< int > ring(8, 2);
+
+		auto out = ring.writer();
+		*out     = 1;
+		++out;
+		*out++ = 2;
+		ring.push(3);
+		ring.close();
+
+		TEST_CHECK(collect(ring.reader()) == (std::vector< int >{ 1, 2, 3 }));
+	}
+	{
+		spsc_ring< int > ring(4);
+		ring.close();
+
+		auto reader = ring.reader();
+		TEST_CHECK(reader.begin() == reader.end());
+	}
+
+	// Flushed elements can be consumed before the ring is closed, and postfix increments keep the previous element
+	{
+		spsc_ring< int > ring(16, 8);
+		ring.push(10);
+		ring.push(11);
+		ring.push(12);
+		ring.flush();
+
+		auto reader = ring.reader();
+		auto it     = reader.begin();
+		TEST_CHECK(*it++ == 10);
+		auto copy = it++;
+		TEST_CHECK(*copy == 11);
+		TEST_CHECK(*it == 12);
+
+		ring.push(13);
+		ring.close();
+		++it;
+		TEST_CHECK(*it == 13);
+		++it;
+		TEST_CHECK(it == reader.end());
+	}
+
+	// Move-only elements
+	{
+		struct Box {
+			std::unique_ptr< int > content;
+		};
+
+		spsc_ring< Box > ring(4);
+		ring.push(Box{ std::make_unique< int >(1) });
+		*ring.writer() = Box{ std::make_unique< int >(2) };
+		ring.close();
+
+		std::vector< int > values;
+		for (Box &box : ring.reader()) {
+			const Box element = std::move(box);
+			values.push_back(*element.content);
+		}
+		TEST_CHECK(values == (std::vector< int >{ 1, 2 }));
+	}
+
+	// Two threads, with a ring that is much smaller than the amount of elements so that both ends have to wait
+	check_transfer< wait_policy::block >(16, 4);
+	check_transfer< wait_policy::block >(1024, 64);
+	check_transfer< wait_policy::block >(2, 1);
+	check_transfer< wait_policy::spin >(16, 4);
+	check_transfer< wait_policy::spin >(1024, 64);
+	check_transfer< wait_policy::spin >(2, 1);
+
+	return 0;
+}
@@ -0,0 +1,206 @@
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file at the root of the source tree or at
+// <https://github.com/Krzmbrzl/iterators/blob/main/LICENSE>.
+
+#include "TestCore.hpp"
+
+#include <iterators/cores/iota.hpp>
+#include <iterators/cores/transform.hpp>
+#include <iterators/iterator_facade.hpp>
+#include <iterators/range.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct Record {
+	int key;
+	std::string name;
+};
+
+struct Key {
+	constexpr auto operator()(const Record &record) const noexcept -> const int & { return record.key; }
+};
+
+// Computes a key (by value) and counts how often it has been called
+struct Scaled {
+	static inline int calls = 0;
+
+	auto operator()(const Record &record) const -> int {
+		++calls;
+		return record.key * 10;
+	}
+};
+
+struct Point {
+	int x;
+	int y;
+};
+
+struct Y {
+	constexpr auto operator()(const Point &point) const noexcept -> const int & { return point.y; }
+};
+
+struct Twice {
+	constexpr auto operator()(int value) const noexcept -> int { return 2 * value; }
+};
+
+constexpr int numbers[]  = { 1, 2, 3, 4 };
+constexpr Point points[] = { { 1, 2 }, { 3, 4 }, { 5, 6 } };
+
+// Projections yield references and thus work with random access cores in constant expressions
+constexpr auto sum_projected() -> int {
+	using Core = PointerCore< const Point >;
+
+	iterators::transform_core< Core, Y > first(Core(points), {});
+	const iterators::transform_core< Core, Y > last(Core(points + 3), {});
+
+	int sum = 0;
+	for (; !first.equals(last); first.increment()) {
+		sum += first.dereference();
+	}
+	return sum;
+}
+
+// Input cores yield computed values as they are
+constexpr auto sum_doubled() -> int {
+	using Core = PointerCore< const int, std::input_iterator_tag >;
+
+	iterators::transform_core< Core, Twice > first(Core(numbers), {});
+	const iterators::transform_core< Core, Twice > last(Core(numbers + 4), {});
+
+	int sum = 0;
+	for (; !first.equals(last); first.increment()) {
+		sum += first.dereference();
+	}
+	return sum;
+}
+
+static_assert(sum_projected() == 12);
+static_assert(sum_doubled() == 20);
+
+using RecordCore = PointerCore< const Record >;
+
+using Projected = iterators::transform_iterator< RecordCore, Key >;
+using Computed  = iterators::transform_iterator< RecordCore, Scaled >;
+using Streamed  = iterators::transform_iterator< PointerCore< const int, std::input_iterator_tag >, Twice >;
+
+static_assert(std::is_same_v< Projected::iterator_category, std::random_access_iterator_tag >);
+static_assert(std::is_same_v< Projected::reference, const int & >);
+static_assert(std::is_same_v< Computed::iterator_category, std::random_access_iterator_tag >);
+static_assert(std::is_same_v< Computed::reference, const int & >);
+static_assert(std::is_same_v< Computed::value_type, int >);
+static_assert(std::is_same_v< decltype(std::declval< Computed >()[0]), int >);
+static_assert(std::is_same_v< Streamed::iterator_category, std::input_iterator_tag >);
+static_assert(std::is_same_v< Streamed::reference, int >);
+
+// A core whose operations can't throw
+struct NothrowCore {
+	using target_iterator_category = std::forward_iterator_tag;
+
+	[[nodiscard]] auto dereference() const noexcept -> const Record & { return *m_record; }
+	[[nodiscard]] auto equals(const NothrowCore &other) const noexcept -> bool { return m_record == other.m_record; }
+	void increment() noexcept { ++m_record; }
+
+	const Record *m_record = nullptr;
+};
+
+// noexcept is propagated from the function and the underlying core
+static_assert(noexcept(std::declval< const iterators::transform_core< NothrowCore, Key > & >().dereference()));
+static_assert(!noexcept(std::declval< const iterators::transform_core< NothrowCore, Scaled > & >().dereference()));
+static_assert(!noexcept(std::declval< const iterators::transform_core< RecordCore, Key > & >().dereference()));
+static_assert(noexcept(std::declval< iterators::transform_core< NothrowCore, Scaled > & >().increment()));
+
+int main() {
+	const std::vector< Record > records = {
+		{ 1, "one" }, { 3, "three" }, { 5, "five" }, { 7, "seven" }, { 9, "nine" },
+	};
+
+	const RecordCore first(records.data());
+	const RecordCore last(records.data() + records.size());
+
+	// Projections refer to the underlying elements
+	{
+		auto keys = iterators::transformed(first, last, Key());
+
+		TEST_CHECK(std::vector< int >(keys.begin(), keys.end()) == (std::vector< int >{ 1, 3, 5, 7, 9 }));
+		TEST_CHECK(&*keys.begin() == &records[0].key);
+		TEST_CHECK(&keys.begin()[3] == &records[3].key);
+
+		auto it = std::lower_bound(keys.begin(), keys.end(), 6);
+		TEST_CHECK(it - keys.begin() == 3);
+		TEST_CHECK(it.operator->() == &records[3].key);
+	}
+
+	// Computed values are cached, so that references can be handed out
+	{
+		auto keys = iterators::transformed(first, last, Scaled());
+
+		Scaled::calls = 0;
+		auto it       = keys.begin();
+		TEST_CHECK(*it == 10);
+		TEST_CHECK(*it == 10);
+		TEST_CHECK(Scaled::calls == 1);
+
+		++it;
+		TEST_CHECK(*it == 30);
+		--it;
+		TEST_CHECK(*it == 10);
+		it += 2;
+		TEST_CHECK(*it == 50);
+		TEST_CHECK(Scaled::calls == 4);
+
+		// Copies carry their own cache
+		auto copy = it;
+		TEST_CHECK(&*copy != &*it && *copy == *it);
+
+		TEST_CHECK(keys.begin()[4] == 90);
+		TEST_CHECK(keys.end() - keys.begin() == 5);
+
+		// Binary search calls the function only once per probed element
+		Scaled::calls = 0;
+		auto found    = std::lower_bound(keys.begin(), keys.end(), 70);
+		TEST_CHECK(found - keys.begin() == 3);
+		TEST_CHECK(*found == 70);
+		TEST_CHECK(Scaled::calls <= 4);
+
+		TEST_CHECK(std::upper_bound(keys.begin(), keys.end(), 100) == keys.end());
+		TEST_CHECK(std::binary_search(keys.begin(), keys.end(), 30));
+		TEST_CHECK(!std::binary_search(keys.begin(), keys.end(), 31));
+	}
+
+	// Transforms of iterator facades
+	{
+		std::vector< int > values = { 3, 1, 2 };
+		const iterators::range< PointerCore< int > > source(PointerCore< int >(values.data()),
+															 PointerCore< int >(values.data() + values.size()));
+
+		auto names = iterators::transformed(source, [](int value) { return std::string(value, '*'); });
+		TEST_CHECK(std::vector< std::string >(names.begin(), names.end())
+				   == (std::vector< std::string >{ "***", "*", "**" }));
+		TEST_CHECK(names.begin()->size() == 3);
+
+		// References into the source allow writing through the transform
+		for (int &value : iterators::transformed(source, [](int &value) -> int & { return value; })) {
+			value = -value;
+		}
+		TEST_CHECK(values == (std::vector< int >{ -3, -1, -2 }));
+	}
+
+	// Projections of cached results refer into the iterator, so operator[] has to return copies of them
+	{
+		auto made = iterators::transformed(iterators::iota(0, 10),
+										   [](int key) { return Record{ key, std::to_string(key) }; });
+		auto names =
+			iterators::transformed(made, [](const Record &record) -> const std::string & { return record.name; });
+		static_assert(std::is_same_v< decltype(names.begin()[3]), std::string >);
+
+		TEST_CHECK(names.begin()[3] == "3");
+		TEST_CHECK(std::string(names.begin()[9]) == "9");
+	}
+
+	return 0;
+}